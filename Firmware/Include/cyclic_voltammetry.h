@@ -0,0 +1,81 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __CYCLIC_VOLTAMMETRY_H
+#define __CYCLIC_VOLTAMMETRY_H
+
+#include "board.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define CYCLIC_VOLTAMMETRY_MAX_SAMPLING_FREQUENCY       1000.0f
+#define CYCLIC_VOLTAMMETRY_MIN_SAMPLING_FREQUENCY       0.001f
+
+/* Exported types ------------------------------------------------------------*/
+typedef void (*CyclicVoltammetry_NewDatapointDelegate_t)(float potential, float current);
+typedef void (*CyclicVoltammetry_MeasurementCompletedDelegate_t)(void);
+
+/* Called instead of the completed delegate when the measurement is aborted since
+  the voltammetry core overran and datapoints were lost. Module is in ready state. */
+typedef void (*CyclicVoltammetry_MeasurementAbortedDelegate_t)(void);
+
+/* Scan goes from the start potential to the vertex, then to the end potential. Every
+  further cycle returns to the vertex and comes back to the end potential. */
+typedef struct
+{
+  float                                                 startPotential;
+  float                                                 vertexPotential;
+  float                                                 endPotential;
+  float                                                 scanRate;         // Volts per second.
+  float                                                 stepPotential;    // Between the datapoints.
+  uint16_t                                              cycleCount;
+  float                                                 maxRelSamplingFreqErr;
+  float                                                 equilibriumPeriod;
+  Board_TIAFBPath_t                                     feedbackPath;
+  double                                                currentGainCorrection;
+  double                                                currentOffsetCorrection;
+  CyclicVoltammetry_NewDatapointDelegate_t              newDatapointDelegate;
+  CyclicVoltammetry_MeasurementCompletedDelegate_t      measurementCompletedDelegate;
+  CyclicVoltammetry_MeasurementAbortedDelegate_t        measurementAbortedDelegate; // Might be NULL.
+} CyclicVoltammetry_SetupParams_t;
+
+typedef enum
+{
+  CYCLIC_VOLTAMMETRY_STATE_UNINIT               = 0x00,
+  CYCLIC_VOLTAMMETRY_STATE_READY                = 0x01,
+  CYCLIC_VOLTAMMETRY_STATE_OPERATING            = 0x02
+} CyclicVoltammetry_State_t;
+
+
+/* Exported functions. -------------------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  *
+  * @Param      pSetupParams: Pointer to data structure which holds setup
+  *             parameters.
+  */
+extern void CyclicVoltammetry_Setup(CyclicVoltammetry_SetupParams_t *pSetupParams);
+
+/**
+  * @Brief      Starts cyclic voltammetry.
+  */
+extern void CyclicVoltammetry_Start(void);
+
+/**
+  * @Brief      Cyclic voltammetry task executer and event processor.
+  */
+extern void CyclicVoltammetry_Execute(void);
+
+/***
+  * @Brief      Stops cyclic voltammetry measurement.
+  */
+extern void CyclicVoltammetry_Stop(void);
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+extern CyclicVoltammetry_State_t CyclicVoltammetry_GetState(void);
+
+#endif
@@ -0,0 +1,23 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __DECIMATION_FILTER_H
+#define __DECIMATION_FILTER_H
+
+#include "generic.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Downsampling is a CIC decimator followed by a FIR decimator, which compensates the
+  CIC droop. FIR coefficients are generated by Tools/decimation_filter_generator.py
+  into the decimation_filter.c. Regenerate them after changing the parameters. */
+#define DECIMATION_FILTER_CIC_ORDER             3
+#define DECIMATION_FILTER_CIC_MAX_RATIO         16384   // Register growth fits in 64 bits.
+#define DECIMATION_FILTER_FIR_DECIMATION        4
+#define DECIMATION_FILTER_FIR_TAP_COUNT         32
+
+/* Exported variables --------------------------------------------------------*/
+/* Symmetric, so the time reversed order of the CMSIS is the same. DC gain is one. */
+extern const float DecimationFilter_FIRCoefficients[DECIMATION_FILTER_FIR_TAP_COUNT];
+
+#endif
@@ -0,0 +1,98 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __DIFFERENTIAL_PULSE_VOLTAMMETRY_H
+#define __DIFFERENTIAL_PULSE_VOLTAMMETRY_H
+
+#include "board.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define DIFFERENTIAL_PULSE_VOLTAMMETRY_MIN_STEP_PERIOD  0.002f
+#define DIFFERENTIAL_PULSE_VOLTAMMETRY_MAX_STEP_PERIOD  100.0f
+
+/* Exported types ------------------------------------------------------------*/
+/* Called once per step. Potential is the base potential of the step, base current is
+  averaged in the window just before the pulse, pulse current in the window at the end
+  of the pulse. Difference is the pulse current minus the base current. */
+typedef void (*DifferentialPulseVoltammetry_NewDatapointDelegate_t)(float potential, float base,
+                                                                    float pulse, float difference);
+typedef void (*DifferentialPulseVoltammetry_MeasurementCompletedDelegate_t)(void);
+
+/* Called instead of the completed delegate when the measurement is aborted since
+  the voltammetry core overran and datapoints were lost. Module is in ready state. */
+typedef void (*DifferentialPulseVoltammetry_MeasurementAbortedDelegate_t)(void);
+
+typedef struct
+{
+  float                                                 startPotential;
+  float                                                 endPotential;
+  float                                                 stepPotential;    // Base potential step, positive.
+  float                                                 amplitude;        // Pulse height, in the scan direction.
+  float                                                 pulseWidth;       // Seconds, at the end of each step.
+  float                                                 stepPeriod;       // Seconds.
+  float                                                 samplingWindow;   // Seconds, averaged before and at the end of the pulse.
+  float                                                 maxRelSamplingFreqErr;
+  float                                                 equilibriumPeriod;
+  Board_TIAFBPath_t                                     feedbackPath;
+  double                                                currentGainCorrection;
+  double                                                currentOffsetCorrection;
+  DifferentialPulseVoltammetry_NewDatapointDelegate_t           newDatapointDelegate;
+  DifferentialPulseVoltammetry_MeasurementCompletedDelegate_t   measurementCompletedDelegate;
+  DifferentialPulseVoltammetry_MeasurementAbortedDelegate_t     measurementAbortedDelegate; // Might be NULL.
+} DifferentialPulseVoltammetry_SetupParams_t;
+
+typedef enum
+{
+  DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_UNINIT           = 0x00,
+  DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_READY            = 0x01,
+  DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_OPERATING        = 0x02
+} DifferentialPulseVoltammetry_State_t;
+
+
+/* Exported functions. -------------------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  *
+  * @Param      pSetupParams: Pointer to data structure which holds setup
+  *             parameters.
+  */
+extern void DifferentialPulseVoltammetry_Setup(DifferentialPulseVoltammetry_SetupParams_t *pSetupParams);
+
+/**
+  * @Brief      Starts differential pulse voltammetry.
+  */
+extern void DifferentialPulseVoltammetry_Start(void);
+
+/**
+  * @Brief      Differential pulse voltammetry task executer and event processor.
+  */
+extern void DifferentialPulseVoltammetry_Execute(void);
+
+/***
+  * @Brief      Stops differential pulse voltammetry measurement.
+  */
+extern void DifferentialPulseVoltammetry_Stop(void);
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+extern DifferentialPulseVoltammetry_State_t DifferentialPulseVoltammetry_GetState(void);
+
+/***
+  * @Brief      Checks whether the DACs cover the scan with the pulses on it. Setup
+  *             fails with the same parameters otherwise.
+  *
+  * @Param      startPotential: Start potential of the base.
+  * @Param      endPotential: End potential of the base.
+  * @Param      amplitude: Pulse height.
+  *
+  * @Return     TRUE if the scan is covered, FALSE otherwise.
+  */
+extern Bool_t DifferentialPulseVoltammetry_IsPotentialRangeValid(float startPotential,
+                                                                 float endPotential,
+                                                                 float amplitude);
+
+#endif
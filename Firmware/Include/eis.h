@@ -1,112 +1,256 @@
-/**
-  * @author     Onur Efe
-  */
-
-#ifndef __EIS_H
-#define __EIS_H
-
-/* Included files ------------------------------------------------------------*/
-#include "generic.h"
-#include "board.h"
-#include "eis_core.h"
-
-/* Exported constants --------------------------------------------------------*/
-#define EIS_MAX_FREQUENCY       100000.0f
-#define EIS_MIN_FREQUENCY       0.001f
-
-/* Exported types ------------------------------------------------------------*/
-typedef enum
-{
-  EIS_STATE_UNINIT                      = 0x00,
-  EIS_STATE_READY                       = 0x01,
-  EIS_STATE_OPERATING_EQUILIBRIUM       = 0x02,
-  EIS_STATE_OPERATING_MEASUREMENT       = 0x03
-} EIS_State_t;
-
-typedef void (*EIS_MeasurementCompletedDelegate_t)(void);
-typedef void (*EIS_NewDatapointDelegate_t)(double impReal, double impImg);
-
-typedef struct
-{
-  float                 amplitudeRms;
-  float                 biasPotential;
-  Board_TIAFBPath_t     feedbackPath;
-} EIS_Analog_t;
-
-typedef struct
-{
-  double                *pFrequency;
-  uint32_t              *pCycles;
-  uint16_t              datapointCount;
-} EIS_DDS_t;
-
-typedef struct
-{
-  EIS_Analog_t          analog;
-  EIS_DDS_t             dds;
-  float                 equilibriumPeriod;
-  EIS_NewDatapointDelegate_t            newDatapointDelegate;
-  EIS_MeasurementCompletedDelegate_t    measurementCompletedDelegate;
-  double                *pCalibReal;
-  double                *pCalibImg;
-} EIS_MeasurementParams_t;
-
-/* Exported functions --------------------------------------------------------*/
-/***
-  * @Brief      Module setup. Should be called before any other function.
-  *
-  * @Param      pMeasParams-> Pointer to the measurement parameters struct.
-  */
-extern void EIS_Setup(EIS_MeasurementParams_t *pMeasParams);
-
-/***
-  * @Brief      Sets start event.
-  */
-extern void EIS_Start(void);
-
-/***
-  * @Brief      EIS module task executer.
-  */
-extern void EIS_Execute(void);
-
-/***
-  * @Brief      Sets stop event.
-  */
-extern void EIS_Stop(void);
-
-/***
-  * @Brief      Returns state of the module.
-  *
-  * @Return     State.
-  */
-extern EIS_State_t EIS_GetState(void);
-
-/***
-  * @Brief      Loads calibration profile.
-  *
-  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
-  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
-  * @Param      pCalibBuffReal-> Pointer to parsed calibration profile real part.
-  * @Param      pCalibBuffImg-> Pointer to parsed calibration profile imaginary part.
-  * @Param      pDatapointCount-> Pointer to return number of datapoints.
-  * 
-  * @Return     Profile found of not(TRUE of FALSE).
-  */
-extern uint8_t EIS_LoadCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
-                                          double *pCalibBuffReal, double *pCalibBuffImg,
-                                          uint16_t *pDatapointCount);
-
-/***
-  * @Brief      Creates calibration profile. Uses eeprom emulator module.
-  *
-  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
-  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
-  * @Param      pCalibBuffReal-> Pointer to calibration profile real part.
-  * @Param      pCalibBuffImg-> Pointer to calibration profile imaginary part.
-  * @Param      datapointCount-> Number of datapoints.
-  */
-extern void EIS_CreateCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
-                                         double *pCalibBuffReal, double *pCalibBuffImg, 
-                                         uint16_t datapointCount);
-
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __EIS_H
+#define __EIS_H
+
+/* Included files ------------------------------------------------------------*/
+#include "generic.h"
+#include "board.h"
+#include "eis_core.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define EIS_MAX_FREQUENCY       100000.0f
+#define EIS_MIN_FREQUENCY       0.001f
+
+/* Derived settle period in units of the cell time constant. Transient decays
+  below 0.1% of its initial value. */
+#define EIS_SETTLE_TIME_CONSTANTS       7.0f
+
+/* Number of TIA feedback paths, which have their own calibration in auto range. */
+#define EIS_FB_PATH_COUNT               (BOARD_TIA_FB_PATH_5 + 1)
+
+/* Allowed remaining error of the bias after a bias step, in volts. */
+#define EIS_BIAS_SETTLE_RESIDUAL        0.001f
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  EIS_STATE_UNINIT                      = 0x00,
+  EIS_STATE_READY                       = 0x01,
+  EIS_STATE_OPERATING_EQUILIBRIUM       = 0x02,
+  EIS_STATE_OPERATING_MEASUREMENT       = 0x03
+} EIS_State_t;
+
+typedef void (*EIS_MeasurementCompletedDelegate_t)(void);
+
+/* Called when the measurement is aborted due to an error, instead of the completed
+  delegate. Module is in ready state. */
+typedef void (*EIS_MeasurementAbortedDelegate_t)(void);
+/* Standard error is of the impedance magnitude, in the units of the impedance. It's
+  negative when it couldn't be calculated. Sample count is the number of sub samples
+  which the standard error is calculated from. */
+typedef void (*EIS_NewDatapointDelegate_t)(double impReal, double impImg, double stdError,
+                                           uint32_t sampleCount);
+/* Timestamp of the following datapoint, in seconds since the measurement start. It's
+  the center of the datapoint's measurement. Called in continuous mode only. */
+typedef void (*EIS_NewTimestampDelegate_t)(double timestamp);
+/* Bias potential of the following datapoints. Called at every bias step. */
+typedef void (*EIS_NewBiasDelegate_t)(float biasPotential);
+/* Harmonics of the current relative to the fundamental current, in single tone mode.
+  It's called before the datapoint, when the harmonics could be demodulated. */
+typedef void (*EIS_NewHarmonicsDelegate_t)(double harm2Real, double harm2Img,
+                                           double harm3Real, double harm3Img);
+
+/* Bias steps of the Mott-Schottky measurement. Bias is stepped from the bias
+  potential to the stop potential, and the frequencies are measured at every step.
+  After a step, first measurement is repeated until its impedance magnitude
+  changes less than the tolerance. */
+typedef struct
+{
+  float                 stopPotential;
+  uint16_t              stepCount;              // Steps after the bias potential. Zero disables.
+  float                 settleTolerance;        // Relative change of the impedance magnitude.
+  uint8_t               maxSettleRepeats;       // Zero disables the settle check.
+} EIS_BiasSweep_t;
+
+/* Amplitude schedule. Amplitude of a measurement is chosen from the response of
+  the previous one, so that the current peak approaches the half of the ADC range.
+  Clipped measurement is taken again with the smaller amplitude. Measurements
+  aren't pipelined when it's enabled, so there is a gap between them. Signal
+  scaling is determined for the maximum amplitude. */
+typedef struct
+{
+  float                 minAmplitudeRms;
+  float                 maxAmplitudeRms;        // Zero disables the schedule.
+} EIS_AmplitudeSchedule_t;
+
+typedef struct
+{
+  float                 amplitudeRms;           // Initial amplitude of the schedule.
+  EIS_AmplitudeSchedule_t amplitudeSchedule;
+  float                 biasPotential;
+  Board_TIAFBPath_t     feedbackPath;           // Initial path in auto range.
+  uint8_t               isAutoRangeEnabled;     // Selects the path for every datapoint.
+  EIS_BiasSweep_t       biasSweep;
+} EIS_Analog_t;
+
+/* Three term correction of a datapoint, Z = (A * Zm + B) / (C * Zm + 1). */
+typedef struct
+{
+  double                aReal, aImg;
+  double                bReal, bImg;
+  double                cReal, cImg;
+} EIS_CalibCoeff_t;
+
+/* Calibration profile. With the frequencies, it's interpolated log-linearly in
+  magnitude and phase, so it serves any frequency list. Otherwise it should be
+  taken on the same frequency list as the measurement. Calibration measurement is
+  of the reference element, which is the load standard of the open, short and load
+  calibration. Coefficients of the three terms are interpolated linearly. */
+typedef struct
+{
+  double                *pCalibFrequency;       // Ascending. NULL indexes by datapoint.
+  double                *pCalibReal;
+  double                *pCalibImg;
+  double                *pOpenReal;
+  double                *pOpenImg;
+  double                *pShortReal;
+  double                *pShortImg;
+  EIS_CalibCoeff_t      *pCoeff;                // Calculated at setup. NULL disables three terms.
+  uint16_t              datapointCount;
+} EIS_Calib_t;
+
+/* Log spaced sweep. Frequencies are expanded one point at a time, and cycles are
+  allocated to fit the time budget. Minimum cycles are the lower limit of the early
+  terminated measurement. */
+typedef struct
+{
+  float                 startFrequency;
+  float                 stopFrequency;          // Might be lower than the start frequency.
+  float                 pointsPerDecade;
+  float                 timeBudget;             // In seconds. Zero gives the minimum cycles.
+  uint32_t              minCycles;
+} EIS_Sweep_t;
+
+typedef struct
+{
+  double                *pFrequency;            // NULL uses the sweep descriptor.
+  uint32_t              *pCycles;               // Minimum cycles when early termination is used.
+  uint32_t              *pMaxCycles;            // NULL disables early termination.
+  float                 targetRelUncertainty;   // Relative standard error of the impedance.
+  float                 maxRelFreqError;        // Frequencies are adjusted for coherent sampling.
+  uint32_t              *pSettleCycles;         // NULL derives them from the cell time constant.
+  float                 cellTimeConstant;       // In seconds. Zero disables derived settle cycles.
+  EISCore_Window_t      window;                 // Lock-in integration window.
+  uint8_t               isDetrendEnabled;       // Removes linear drift of the current.
+  uint8_t               isContinuous;           // Streams the first frequency until stopped.
+  uint16_t              datapointCount;         // Calculated for the sweep.
+  uint8_t               tonesPerMeasurement;    // Consecutive frequencies measured together.
+  EIS_Sweep_t           sweep;
+} EIS_DDS_t;
+
+typedef struct
+{
+  EIS_Analog_t          analog;
+  EIS_DDS_t             dds;
+  float                 equilibriumPeriod;
+  EIS_NewDatapointDelegate_t            newDatapointDelegate;
+  EIS_NewHarmonicsDelegate_t            newHarmonicsDelegate;   // NULL disables harmonics.
+  EIS_NewTimestampDelegate_t            newTimestampDelegate;
+  EIS_NewBiasDelegate_t                 newBiasDelegate;
+  EIS_MeasurementCompletedDelegate_t    measurementCompletedDelegate;
+  EIS_MeasurementAbortedDelegate_t      measurementAbortedDelegate;     // Might be NULL.
+  EIS_Calib_t           calib;
+  EIS_Calib_t           rangeCalib[EIS_FB_PATH_COUNT];  // Used instead in auto range.
+} EIS_MeasurementParams_t;
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      Module setup. Should be called before any other function.
+  *
+  * @Param      pMeasParams-> Pointer to the measurement parameters struct.
+  */
+extern void EIS_Setup(EIS_MeasurementParams_t *pMeasParams);
+
+/***
+  * @Brief      Sets start event.
+  */
+extern void EIS_Start(void);
+
+/***
+  * @Brief      EIS module task executer.
+  */
+extern void EIS_Execute(void);
+
+/***
+  * @Brief      Sets stop event.
+  */
+extern void EIS_Stop(void);
+
+/***
+  * @Brief      Returns state of the module.
+  *
+  * @Return     State.
+  */
+extern EIS_State_t EIS_GetState(void);
+
+/***
+  * @Brief      Returns number of datapoints. It's calculated for the sweep.
+  */
+extern uint16_t EIS_GetDatapointCount(void);
+
+/***
+  * @Brief      Returns frequency of a datapoint, before the adjustment for the
+  *             coherent sampling.
+  *
+  * @Param      index->Index of the datapoint.
+  */
+extern double EIS_GetDatapointFrequency(uint16_t index);
+
+/***
+  * @Brief      Loads calibration profile.
+  *
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalibBuffReal-> Pointer to parsed calibration profile real part.
+  * @Param      pCalibBuffImg-> Pointer to parsed calibration profile imaginary part.
+  * @Param      pDatapointCount-> Pointer to return number of datapoints.
+  * 
+  * @Return     Profile found of not(TRUE of FALSE).
+  */
+extern uint8_t EIS_LoadCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
+                                          double *pCalibBuffReal, double *pCalibBuffImg,
+                                          uint16_t *pDatapointCount);
+
+/***
+  * @Brief      Creates calibration profile. Uses eeprom emulator module.
+  *
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalibBuffReal-> Pointer to calibration profile real part.
+  * @Param      pCalibBuffImg-> Pointer to calibration profile imaginary part.
+  * @Param      datapointCount-> Number of datapoints.
+  */
+extern void EIS_CreateCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
+                                         double *pCalibBuffReal, double *pCalibBuffImg, 
+                                         uint16_t datapointCount);
+
+/***
+  * @Brief      Creates calibration profile with its frequencies. Uses eeprom
+  *             emulator module.
+  *
+  * @Param      eeObjectIdFreq-> EEPROM Emulator object id for frequencies.
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalib-> Pointer to calibration profile.
+  */
+extern void EIS_CreateCalibrationTable(uint16_t eeObjectIdFreq, uint16_t eeObjectIdReal,
+                                       uint16_t eeObjectIdImg, EIS_Calib_t *pCalib);
+
+/***
+  * @Brief      Loads calibration profile with its frequencies. Buffers of the
+  *             profile should be set.
+  *
+  * @Param      eeObjectIdFreq-> EEPROM Emulator object id for frequencies.
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalib-> Pointer to calibration profile to be loaded.
+  *
+  * @Return     Profile found of not(TRUE of FALSE).
+  */
+extern uint8_t EIS_LoadCalibrationTable(uint16_t eeObjectIdFreq, uint16_t eeObjectIdReal,
+                                        uint16_t eeObjectIdImg, EIS_Calib_t *pCalib);
+
 #endif
\ No newline at end of file
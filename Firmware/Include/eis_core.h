@@ -1,62 +1,153 @@
-/**
-  * @author     Onur Efe
-  */
-
-#ifndef __EIS_CORE_H
-#define __EIS_CORE_H
-
-/* Include files -------------------------------------------------------------*/
-#include "generic.h"
-
-/* Exported types ------------------------------------------------------------*/
-typedef enum
-{
-  EIS_CORE_STATE_UNINIT                 = 0x00,
-  EIS_CORE_STATE_READY                  = 0x01,
-  EIS_CORE_STATE_OPERATING              = 0x02
-} EISCore_State_t;
-
-typedef void (*EISCore_MeasurementCompletedDelegate_t)(void);
-
-typedef struct
-{
-  double frequency;                      
-  uint16_t signal_amp_pp_dac_code;              // Peak to peak amplitude of the DAC code. 
-  uint32_t cycles;                              // Number of cycles.
-  EISCore_MeasurementCompletedDelegate_t        measurementCompletedDelegate;
-} EISCore_MeasParams_t;
-
-/* Exported functions --------------------------------------------------------*/
-/***
-  * @Brief      Setup function of the EIS core. Function should called before any
-  *             other operation.
-  *
-  * @Param      pMeasParams->Pointer to measurement params struct.
-  */
-extern void EISCore_Setup(EISCore_MeasParams_t *pMeasParams);
-
-/***
-  * @Brief      Sets start event. 
-  */
-extern void EISCore_Start(void);
-
-/***
-  * @Brief      EIS Core module's task executer. Should be called periodically.
-  */
-extern void EISCore_Execute(void);
-
-/***
-  * @Brief      Sets stop event.
-  */
-extern void EISCore_Stop(void);
-
-/***
-  * @Brief      Gets module's state.
-  */
-extern EISCore_State_t EISCore_GetState(void);
-
-/***
-  * @Brief      Gets result.
-  */
-extern void EISCore_GetResult(double *pAverageX, double *pAverageY);
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __EIS_CORE_H
+#define __EIS_CORE_H
+
+/* Include files -------------------------------------------------------------*/
+#include "generic.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define EIS_CORE_MAX_TONES                      8       // Limited by the cost of a sample.
+#define EIS_CORE_HIGHEST_HARMONIC               3       // Demodulated in single tone mode.
+
+/* When set, DAC and ADC are serviced by the timer triggered DMA, and demodulation
+  runs in blocks from the executer. Otherwise the tick ISR services both. */
+#ifndef EIS_CORE_USE_DMA_SAMPLE_PATH
+#define EIS_CORE_USE_DMA_SAMPLE_PATH            1
+#endif
+
+/* When set, demodulation references of the non decimating path are generated by
+  rotating float phasors, instead of the sine table lookups. It's kept to compare
+  the two, Tools/eis_reference_benchmark.py models both on the host. */
+#ifndef EIS_CORE_USE_FLOAT_PHASOR
+#define EIS_CORE_USE_FLOAT_PHASOR               0
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  EIS_CORE_STATE_UNINIT                 = 0x00,
+  EIS_CORE_STATE_READY                  = 0x01,
+  EIS_CORE_STATE_OPERATING              = 0x02
+} EISCore_State_t;
+
+/* Window of the lock-in integration. It's applied per sub sample, so it's used only
+  for the long measurements. */
+typedef enum
+{
+  EIS_CORE_WINDOW_RECTANGULAR           = 0x00,
+  EIS_CORE_WINDOW_HANN                  = 0x01,
+  EIS_CORE_WINDOW_FLAT_TOP              = 0x02
+} EISCore_Window_t;
+
+typedef void (*EISCore_MeasurementCompletedDelegate_t)(void);
+
+/* Called when the measurement is aborted, since the sampler blocks aren't demodulated
+  in time. Module is in ready state. */
+typedef void (*EISCore_MeasurementAbortedDelegate_t)(void);
+
+typedef struct
+{
+  double frequency[EIS_CORE_MAX_TONES];         // Tone frequencies. Multisine when more than one.
+  uint8_t toneCount;                            // Number of simultaneously excited tones.
+  uint16_t signal_amp_pp_dac_code;              // Peak to peak amplitude of the DAC code.
+  uint32_t cycles;                              // Number of cycles of the lowest frequency tone.
+  uint32_t maxCycles;                           // Cycle limit of the early terminated measurement.
+  uint32_t settleCycles;                        // Cycles excited before the measurement, discarded.
+  float targetRelUncertainty;                   // Zero disables early termination.
+  float maxRelFreqError;                        // Frequency is adjusted for coherent sampling.
+  uint8_t isHarmonicsEnabled;                   // 2nd and 3rd harmonics, single tone only.
+  EISCore_Window_t window;                      // Disables early termination.
+  uint8_t isDetrendEnabled;                     // Removes linear drift of the current.
+  uint8_t isContinuous;                         // Repeats the measurement until stopped.
+  EISCore_MeasurementCompletedDelegate_t        measurementCompletedDelegate;
+  EISCore_MeasurementAbortedDelegate_t          measurementAbortedDelegate;
+} EISCore_MeasParams_t;
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      Setup function of the EIS core. Function should called before any
+  *             other operation.
+  *
+  * @Param      pMeasParams->Pointer to measurement params struct.
+  * @Param      pRelFrequencyError->Pointer to return the maximum relative frequency
+  *             error of the tones.
+  */
+extern void EISCore_Setup(EISCore_MeasParams_t *pMeasParams, float *pRelFrequencyError);
+
+/***
+  * @Brief      Sets up the next measurement, while the current one is operating.
+  *             Next measurement is swapped in at the end of the current one,
+  *             without stopping the excitation. If it can't be swapped in, module
+  *             stops at the end of the current measurement.
+  *
+  * @Param      pMeasParams->Pointer to measurement params struct.
+  * @Param      pRelFrequencyError->Pointer to return the maximum relative frequency
+  *             error of the tones.
+  */
+extern void EISCore_SetupNext(EISCore_MeasParams_t *pMeasParams, float *pRelFrequencyError);
+
+/***
+  * @Brief      Sets start event.
+  */
+extern void EISCore_Start(void);
+
+/***
+  * @Brief      EIS Core module's task executer. Should be called periodically.
+  */
+extern void EISCore_Execute(void);
+
+/***
+  * @Brief      Sets stop event.
+  */
+extern void EISCore_Stop(void);
+
+/***
+  * @Brief      Gets module's state.
+  */
+extern EISCore_State_t EISCore_GetState(void);
+
+/***
+  * @Brief      Gets result of a tone. Result is normalized to the full signal
+  *             amplitude, so multisine tones are processed like a single sine.
+  *
+  * @Param      toneIndex->Index of the tone in the measurement params.
+  */
+extern void EISCore_GetResult(uint8_t toneIndex, double *pAverageX, double *pAverageY);
+
+/***
+  * @Brief      Gets uncertainty of a tone result. Sub samples are treated as
+  *             independent estimates of the tone phasor.
+  *
+  * @Param      toneIndex->Index of the tone in the measurement params.
+  * @Param      pRelStdError->Standard error of the average, relative to the
+  *             magnitude. Negative when there are fewer than two sub samples.
+  * @Param      pSubSampleCount->Number of sub samples in the statistics.
+  */
+extern void EISCore_GetUncertainty(uint8_t toneIndex, double *pRelStdError,
+                                   uint32_t *pSubSampleCount);
+
+/***
+  * @Brief      Gets timestamp of the result. It's the center of the measured part,
+  *             in seconds since the start.
+  */
+extern double EISCore_GetTimestamp(void);
+
+/***
+  * @Brief      Gets peak of the absolute ADC code in the result. Settle block is
+  *             excluded.
+  */
+extern uint32_t EISCore_GetPeak(void);
+
+/***
+  * @Brief      Gets a harmonic of the single tone result. It's normalized like the
+  *             fundamental, so the ratio of them is the relative harmonic content.
+  *
+  * @Param      order->Order of the harmonic, 2 or 3.
+  *
+  * @Return     TRUE if the harmonic is demodulated, FALSE otherwise.
+  */
+extern uint8_t EISCore_GetHarmonic(uint8_t order, double *pAverageX, double *pAverageY);
 #endif
\ No newline at end of file
@@ -1,18 +1,19 @@
-/**
-  * @author     Onur Efe
-  */
-
-#ifndef __MIDDLEWARES_H
-#define __MIDDLEWARES_H
-
-#include "generic.h"
-#include "alarm_clock.h"
-#include "eeprom_emulator.h"
-#include "exception_handler.h"
-#include "sys_time.h"
-#include "utils.h"
-#include "crc32.h"
-#include "queue.h"
-#include "queue_generic.h"
-
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __MIDDLEWARES_H
+#define __MIDDLEWARES_H
+
+#include "generic.h"
+#include "alarm_clock.h"
+#include "eeprom_emulator.h"
+#include "exception_handler.h"
+#include "sys_time.h"
+#include "utils.h"
+#include "crc32.h"
+#include "queue.h"
+#include "queue_generic.h"
+#include "waveform_table.h"
+
 #endif
\ No newline at end of file
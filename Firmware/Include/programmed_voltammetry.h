@@ -0,0 +1,81 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __PROGRAMMED_VOLTAMMETRY_H
+#define __PROGRAMMED_VOLTAMMETRY_H
+
+#include "board.h"
+#include "waveform_program.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define PROGRAMMED_VOLTAMMETRY_MAX_SAMPLING_FREQUENCY   1000.0f
+#define PROGRAMMED_VOLTAMMETRY_MIN_SAMPLING_FREQUENCY   0.000001f
+
+/* Exported types ------------------------------------------------------------*/
+typedef void (*ProgrammedVoltammetry_NewDatapointDelegate_t)(float datapoint);
+typedef void (*ProgrammedVoltammetry_MeasurementCompletedDelegate_t)(void);
+
+/* Called instead of the completed delegate when the measurement is aborted since
+  the voltammetry core overran and datapoints were lost. Module is in ready state. */
+typedef void (*ProgrammedVoltammetry_MeasurementAbortedDelegate_t)(void);
+
+/* Potential is generated by the waveform program. First level of the program is held
+  during the equilibrium period. */
+typedef struct
+{
+  const WaveformProgram_Instruction_t           *pProgram;
+  uint8_t                                       instructionCount;
+  uint16_t                                      datapointCount;
+  float                                         samplingFrequency;
+  float                                         samplingWindow;   // Fraction of the sampling period. Zero selects the decimators.
+  float                                         maxRelSamplingFreqErr;
+  float                                         equilibriumPeriod;
+  Board_TIAFBPath_t                             feedbackPath;
+  double                                        currentGainCorrection;
+  double                                        currentOffsetCorrection;
+  ProgrammedVoltammetry_NewDatapointDelegate_t          newDatapointDelegate;
+  ProgrammedVoltammetry_MeasurementCompletedDelegate_t  measurementCompletedDelegate;
+  ProgrammedVoltammetry_MeasurementAbortedDelegate_t    measurementAbortedDelegate; // Might be NULL.
+} ProgrammedVoltammetry_SetupParams_t;
+
+typedef enum
+{
+  PROGRAMMED_VOLTAMMETRY_STATE_UNINIT           = 0x00,
+  PROGRAMMED_VOLTAMMETRY_STATE_READY            = 0x01,
+  PROGRAMMED_VOLTAMMETRY_STATE_OPERATING        = 0x02
+} ProgrammedVoltammetry_State_t;
+
+
+/* Exported functions. -------------------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  * 
+  * @Param      pSetupParams: Pointer to data structure which holds setup 
+  *             parameters.
+  */
+extern void ProgrammedVoltammetry_Setup(ProgrammedVoltammetry_SetupParams_t *pSetupParams);
+
+/**
+  * @Brief      Starts programmed voltammetry.
+  */
+extern void ProgrammedVoltammetry_Start(void);
+
+/**
+  * @Brief      Programmed voltammetry task executer and event processor.
+  */
+extern void ProgrammedVoltammetry_Execute(void);
+
+/***
+  * @Brief      Stops programmed voltammetry measurement.
+  */
+extern void ProgrammedVoltammetry_Stop(void);
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+extern ProgrammedVoltammetry_State_t ProgrammedVoltammetry_GetState(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __SQUARE_WAVE_VOLTAMMETRY_H
+#define __SQUARE_WAVE_VOLTAMMETRY_H
+
+#include "board.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define SQUARE_WAVE_VOLTAMMETRY_MAX_FREQUENCY           500.0f
+#define SQUARE_WAVE_VOLTAMMETRY_MIN_FREQUENCY           0.1f
+
+/* Exported types ------------------------------------------------------------*/
+/* Called once per step. Potential is the staircase potential of the step, forward
+  current is sampled at the end of the forward pulse, reverse current at the end of
+  the reverse pulse. */
+typedef void (*SquareWaveVoltammetry_NewDatapointDelegate_t)(float potential, float forward,
+                                                             float reverse, float difference);
+typedef void (*SquareWaveVoltammetry_MeasurementCompletedDelegate_t)(void);
+
+/* Called instead of the completed delegate when the measurement is aborted since
+  the voltammetry core overran and datapoints were lost. Module is in ready state. */
+typedef void (*SquareWaveVoltammetry_MeasurementAbortedDelegate_t)(void);
+
+typedef struct
+{
+  float                                                 startPotential;
+  float                                                 endPotential;
+  float                                                 stepPotential;    // Staircase step, positive.
+  float                                                 amplitude;        // Pulse height, half of the peak to peak.
+  float                                                 frequency;        // One step per period.
+  float                                                 samplingWindow;   // Fraction of the pulse averaged at its end.
+  float                                                 maxRelSamplingFreqErr;
+  float                                                 equilibriumPeriod;
+  Board_TIAFBPath_t                                     feedbackPath;
+  double                                                currentGainCorrection;
+  double                                                currentOffsetCorrection;
+  SquareWaveVoltammetry_NewDatapointDelegate_t          newDatapointDelegate;
+  SquareWaveVoltammetry_MeasurementCompletedDelegate_t  measurementCompletedDelegate;
+  SquareWaveVoltammetry_MeasurementAbortedDelegate_t    measurementAbortedDelegate; // Might be NULL.
+} SquareWaveVoltammetry_SetupParams_t;
+
+typedef enum
+{
+  SQUARE_WAVE_VOLTAMMETRY_STATE_UNINIT          = 0x00,
+  SQUARE_WAVE_VOLTAMMETRY_STATE_READY           = 0x01,
+  SQUARE_WAVE_VOLTAMMETRY_STATE_OPERATING       = 0x02
+} SquareWaveVoltammetry_State_t;
+
+
+/* Exported functions. -------------------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  *
+  * @Param      pSetupParams: Pointer to data structure which holds setup
+  *             parameters.
+  */
+extern void SquareWaveVoltammetry_Setup(SquareWaveVoltammetry_SetupParams_t *pSetupParams);
+
+/**
+  * @Brief      Starts square wave voltammetry.
+  */
+extern void SquareWaveVoltammetry_Start(void);
+
+/**
+  * @Brief      Square wave voltammetry task executer and event processor.
+  */
+extern void SquareWaveVoltammetry_Execute(void);
+
+/***
+  * @Brief      Stops square wave voltammetry measurement.
+  */
+extern void SquareWaveVoltammetry_Stop(void);
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+extern SquareWaveVoltammetry_State_t SquareWaveVoltammetry_GetState(void);
+
+/***
+  * @Brief      Checks whether the DACs cover the scan with the pulses around it.
+  *             Setup fails with the same parameters otherwise.
+  *
+  * @Param      startPotential: Start potential of the staircase.
+  * @Param      endPotential: End potential of the staircase.
+  * @Param      amplitude: Pulse height.
+  *
+  * @Return     TRUE if the scan is covered, FALSE otherwise.
+  */
+extern Bool_t SquareWaveVoltammetry_IsPotentialRangeValid(float startPotential,
+                                                          float endPotential,
+                                                          float amplitude);
+
+#endif
@@ -1,9 +1,9 @@
-#ifndef __SYS_TIME_H
-#define __SYS_TIME_H
-
-/* Exported functions --------------------------------------------------------*/
-#include "generic.h"
-
-extern uint32_t SysTime_GetTick(void);
-
+#ifndef __SYS_TIME_H
+#define __SYS_TIME_H
+
+/* Exported functions --------------------------------------------------------*/
+#include "generic.h"
+
+extern uint32_t SysTime_GetTick(void);
+
 #endif
\ No newline at end of file
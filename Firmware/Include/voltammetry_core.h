@@ -1,67 +1,299 @@
-/**
-  * @author     Onur Efe
-  */
-
-#ifndef __VOLTAMMETRY_CORE_H
-#define __VOLTAMMETRY_CORE_H
-
-#include "generic.h"
-
-/* Exported types ------------------------------------------------------------*/
-typedef void (*VoltammetryCore_NewDatapointDelegate_t)(float datapoint);
-typedef void (*VoltammetryCore_MeasurementCompletedDelegate_t)(void);
-typedef uint16_t (*VoltammetryCore_GeneratorFunctionInterface_t)(int32_t tickCounter);
-
-typedef struct
-{
-  uint16_t                                              datapointCount;
-  float                                                 samplingFrequency;
-  float                                                 equilibriumPeriod;
-  float                                                 maxRelSamplingFreqErr;
-  VoltammetryCore_NewDatapointDelegate_t                newDatapointDelegate;
-  VoltammetryCore_MeasurementCompletedDelegate_t        measurementCompletedDelegate;
-  VoltammetryCore_GeneratorFunctionInterface_t          generatorFunctionInterface;
-} VoltammetryCore_SetupParams_t;
-
-typedef enum
-{
-  VOLTAMMETRY_CORE_STATE_UNINIT                 = 0x00,
-  VOLTAMMETRY_CORE_STATE_READY                  = 0x01,
-  VOLTAMMETRY_CORE_STATE_OPERATING              = 0x02
-} VoltammetryCore_State_t;
-
-
-/* Exported functions. -------------------------------------------------------*/
-/***
-  * @Brief      Initializes the module. Should be called before any other function.
-  *             It's assumed that interrupt priority is always higher than the 
-  *             execute function's priority.
-  * @Param      pSetupParams: Setup parameters for the module.
-  * @Param      pTickPeriod: Pointer to return calculated tick period.
-  */
-extern void VoltammetryCore_Setup(VoltammetryCore_SetupParams_t *pSetupParams, 
-                                  float *pTickPeriod);
-
-/***
-  * @Brief      Sets start event. Event will be processed when event processor 
-  *             called.
-  */
-extern void VoltammetryCore_Start(void);
-
-/***
-  * @Brief      Module task executer and event processor.
-  */
-extern void VoltammetryCore_Execute(void);
-
-/***
-  * @Brief      Sets stop event. Event will be processed when event processor 
-  *             called.
-  */
-extern void VoltammetryCore_Stop(void);
-
-/***
-  * @Brief      Returns state of the voltammetry core module.
-  */
-extern VoltammetryCore_State_t VoltammetryCore_GetState(void);
-
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __VOLTAMMETRY_CORE_H
+#define __VOLTAMMETRY_CORE_H
+
+#include "generic.h"
+#include "board.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define VOLTAMMETRY_CORE_MAX_SAMPLING_EDGES     4
+
+// Techniques generate the signal DAC codes in Q16.16 format.
+#define VOLTAMMETRY_CORE_CODE_FRACTION_BITS     16
+#define VOLTAMMETRY_CORE_CODE_ONE               ((double)(1UL << VOLTAMMETRY_CORE_CODE_FRACTION_BITS))
+#define VOLTAMMETRY_CORE_CODE_HALF              (1L << (VOLTAMMETRY_CORE_CODE_FRACTION_BITS - 1))
+
+/* Exported types ------------------------------------------------------------*/
+/* Edge index is of the sampling pattern, zero for the decimators. */
+typedef void (*VoltammetryCore_NewDatapointDelegate_t)(float datapoint, uint8_t edgeIndex);
+typedef void (*VoltammetryCore_MeasurementCompletedDelegate_t)(void);
+typedef uint16_t (*VoltammetryCore_GeneratorFunctionInterface_t)(int32_t tickCounter);
+
+typedef enum
+{
+  VOLTAMMETRY_CORE_WAVEFORM_CUSTOM              = 0x00, // Generator function interface.
+  VOLTAMMETRY_CORE_WAVEFORM_SINE                = 0x01,
+  VOLTAMMETRY_CORE_WAVEFORM_TRIANGLE            = 0x02,
+  VOLTAMMETRY_CORE_WAVEFORM_STAIRCASE           = 0x03
+} VoltammetryCore_WaveformType_t;
+
+/* Built-in waveforms are synthesized by a phase accumulator from the waveform
+  tables. Waveform starts after the equilibrium period, at the offset. */
+typedef struct
+{
+  VoltammetryCore_WaveformType_t                        type;
+  float                                                 frequency;
+  uint16_t                                              offsetDACCode;
+  uint16_t                                              amplitudeDACCode;
+  uint16_t                                              stepsPerPeriod;   // Staircase only.
+} VoltammetryCore_Waveform_t;
+
+/* Datapoints are either the output of the cic and fir decimators, or the average of a
+  window which ends at the sampling point. Windowed sampling points are aligned to the
+  downsampling period edges of the generator, so pulse techniques sample at the end of
+  each pulse. Sampling pattern overrides the uniform windows. */
+typedef struct
+{
+  uint16_t                                              datapointCount;
+  float                                                 samplingFrequency;
+  float                                                 samplingWindow;   // Fraction of the downsampling period. Zero selects the decimators.
+  float                                                 equilibriumPeriod;
+  float                                                 maxRelSamplingFreqErr;
+  VoltammetryCore_NewDatapointDelegate_t                newDatapointDelegate;
+  VoltammetryCore_MeasurementCompletedDelegate_t        measurementCompletedDelegate;
+  VoltammetryCore_GeneratorFunctionInterface_t          generatorFunctionInterface;
+  VoltammetryCore_Waveform_t                            waveform;
+} VoltammetryCore_SetupParams_t;
+
+/* Windowed sampling pattern, repeated every period from the end of the equilibrium
+  period. Each datapoint is the average of a window which ends at an edge. Edges are
+  ascending in (0, periodTicks], windows of the consecutive edges shouldn't overlap. */
+typedef struct
+{
+  uint32_t                                              periodTicks;
+  uint8_t                                               edgeCount;
+  uint32_t                                              edgeTicks[VOLTAMMETRY_CORE_MAX_SAMPLING_EDGES];
+  uint32_t                                              windowTicks[VOLTAMMETRY_CORE_MAX_SAMPLING_EDGES];
+} VoltammetryCore_SamplingPattern_t;
+
+/* Analog configuration of a technique. Bias DAC holds the middle of the potential range,
+  signal DAC generates the potential around it with the finest scaling which covers the
+  range. */
+typedef struct
+{
+  Board_TIAFBPath_t                                     fbPath;
+  Board_BinarySignalScaling_t                           binaryScaling;
+  Board_DecimalSignalScaling_t                          decimalScaling;
+  uint16_t                                              biasDACCode;
+  double                                                biasPotential;
+  double                                                signalDAC1LSBPotential;
+} VoltammetryCore_AnalogConfig_t;
+
+typedef enum
+{
+  VOLTAMMETRY_CORE_PULSES_BIPOLAR               = 0x00, // Both ways of the staircase.
+  VOLTAMMETRY_CORE_PULSES_FORWARD               = 0x01  // In the scan direction.
+} VoltammetryCore_PulseDirection_t;
+
+/* Staircase of the pulse techniques, with its pulse height. Codes are in Q16.16 format.
+  Steps include both of the start and the end potentials. Each step is sampled on two
+  edges of the sampling pattern, currents of the step are paired on them. */
+typedef struct
+{
+  VoltammetryCore_AnalogConfig_t                        analogConfig;
+  uint32_t                                              startCode;
+  int32_t                                               stepIncrement;
+  int32_t                                               pulseIncrement;   // In the scan direction.
+  uint32_t                                              stepCount;
+  uint32_t                                              stepIndex;        // Of the next pair.
+  float                                                 firstCurrent;     // Of the pair.
+} VoltammetryCore_Staircase_t;
+
+typedef enum
+{
+  VOLTAMMETRY_CORE_STATE_UNINIT                 = 0x00,
+  VOLTAMMETRY_CORE_STATE_READY                  = 0x01,
+  VOLTAMMETRY_CORE_STATE_OPERATING              = 0x02
+} VoltammetryCore_State_t;
+
+
+/* Exported functions. -------------------------------------------------------*/
+/***
+  * @Brief      Initializes the module. Should be called before any other function.
+  *             It's assumed that interrupt priority is always higher than the 
+  *             execute function's priority.
+  * @Param      pSetupParams: Setup parameters for the module.
+  * @Param      pTickPeriod: Pointer to return calculated tick period.
+  */
+extern void VoltammetryCore_Setup(VoltammetryCore_SetupParams_t *pSetupParams, 
+                                  float *pTickPeriod);
+
+/***
+  * @Brief      Sets windowed sampling pattern. Should be called after the setup, since
+  *             the ticks are known then.
+  * @Param      pPattern: Sampling pattern in ticks.
+  */
+extern void VoltammetryCore_SetSamplingPattern(VoltammetryCore_SamplingPattern_t *pPattern);
+
+/***
+  * @Brief      Sets start event. Event will be processed when event processor 
+  *             called.
+  */
+extern void VoltammetryCore_Start(void);
+
+/***
+  * @Brief      Module task executer and event processor.
+  */
+extern void VoltammetryCore_Execute(void);
+
+/***
+  * @Brief      Sets stop event. Event will be processed when event processor 
+  *             called.
+  */
+extern void VoltammetryCore_Stop(void);
+
+/***
+  * @Brief      Returns state of the voltammetry core module.
+  */
+extern VoltammetryCore_State_t VoltammetryCore_GetState(void);
+
+/***
+  * @Brief      Returns number of ticks between the datapoints. Valid after setup.
+  */
+extern uint32_t VoltammetryCore_GetDownsamplingNumber(void);
+
+/***
+  * @Brief      Returns group delay of the downsampling filter in ticks. Datapoint
+  *             represents the current of this many ticks before its sampling tick.
+  *             Windowed sampling returns the delay of the first edge.
+  */
+extern float VoltammetryCore_GetFilterDelay(void);
+
+/***
+  * @Brief      Returns whether the cic outputs were dropped since the start, since the
+  *             executer fell behind the tick ISR. Dropped outputs are filled by the
+  *             next ones, so the datapoints stay aligned but are distorted around them.
+  *             Window outputs are lost on overrun. Techniques abort the measurement
+  *             when it's set.
+  */
+extern Bool_t VoltammetryCore_IsOverrun(void);
+
+/***
+  * @Brief      Places the bias at the middle of the potential range, and determines
+  *             the finest signal scaling which covers the range around it. Feedback
+  *             path of the configuration isn't touched.
+  * @Param      minPotential: Minimum potential applied by the technique.
+  * @Param      maxPotential: Maximum potential applied by the technique.
+  * @Param      pConfig: Pointer to return the configuration.
+  * @Return     TRUE if the DACs cover the range, FALSE otherwise.
+  */
+extern Bool_t VoltammetryCore_DetermineSignalScaling(float minPotential, float maxPotential,
+                                                     VoltammetryCore_AnalogConfig_t *pConfig);
+
+/***
+  * @Brief      Converts potential to the signal DAC code in Q16.16 format, relative
+  *             to the bias potential. Code is saturated to the DAC range.
+  * @Param      pConfig: Analog configuration of the technique.
+  * @Param      potential: Potential in units of volts.
+  */
+extern uint32_t VoltammetryCore_GetCode(VoltammetryCore_AnalogConfig_t *pConfig,
+                                        float potential);
+
+/***
+  * @Brief      Returns potential applied by the signal DAC code.
+  * @Param      pConfig: Analog configuration of the technique.
+  * @Param      dacCode: Signal DAC code.
+  */
+extern float VoltammetryCore_GetPotential(VoltammetryCore_AnalogConfig_t *pConfig,
+                                          uint16_t dacCode);
+
+/***
+  * @Brief      Turns on the analog circuitry in the voltammetry configuration. Loads
+  *             the feedback path, the bias and the initial signal DAC code, and waits
+  *             the bias to stabilize. Core should be started after this.
+  * @Param      pConfig: Analog configuration of the technique.
+  * @Param      signalDACCode: Initial signal DAC code.
+  */
+extern void VoltammetryCore_TurnOnAnalog(VoltammetryCore_AnalogConfig_t *pConfig,
+                                         uint16_t signalDACCode);
+
+/***
+  * @Brief      Turns off the analog circuitry, and disables the SPIs.
+  */
+extern void VoltammetryCore_TurnOffAnalog(void);
+
+/***
+  * @Brief      Checks whether the DACs cover the staircase with the pulses.
+  * @Param      startPotential: Start potential of the staircase.
+  * @Param      endPotential: End potential of the staircase.
+  * @Param      amplitude: Pulse height.
+  * @Param      pulses: Direction of the pulses.
+  * @Return     TRUE if the staircase is covered, FALSE otherwise.
+  */
+extern Bool_t VoltammetryCore_IsStaircaseValid(float startPotential, float endPotential,
+                                               float amplitude,
+                                               VoltammetryCore_PulseDirection_t pulses);
+
+/***
+  * @Brief      Plans the staircase, and the analog configuration which covers it.
+  *             Feedback path of the configuration isn't touched. Step is fitted to
+  *             the step count, so the staircase ends at the end potential.
+  * @Param      pStaircase: Pointer to return the staircase.
+  * @Param      startPotential: Start potential of the staircase.
+  * @Param      endPotential: End potential of the staircase.
+  * @Param      stepPotential: Staircase step, positive.
+  * @Param      amplitude: Pulse height.
+  * @Param      pulses: Direction of the pulses.
+  */
+extern void VoltammetryCore_PlanStaircase(VoltammetryCore_Staircase_t *pStaircase,
+                                          float startPotential, float endPotential,
+                                          float stepPotential, float amplitude,
+                                          VoltammetryCore_PulseDirection_t pulses);
+
+/***
+  * @Brief      Pairs the currents of a step. Current of the first edge is held, the
+  *             pair is returned on the second edge.
+  * @Param      pStaircase: Staircase of the technique.
+  * @Param      current: Current of the edge.
+  * @Param      edgeIndex: Edge of the sampling pattern.
+  * @Param      pPotential: Pointer to return the staircase potential of the step.
+  * @Param      pFirstCurrent: Pointer to return the current of the first edge.
+  * @Return     TRUE if the pair is completed, FALSE otherwise.
+  */
+extern Bool_t VoltammetryCore_PairStaircaseCurrents(VoltammetryCore_Staircase_t *pStaircase,
+                                                    float current, uint8_t edgeIndex,
+                                                    float *pPotential, float *pFirstCurrent);
+
+/***
+  * @Brief      Rounds Q16.16 code to the DAC code, and saturates to the DAC range.
+  *             Inlined, since the generators call it from the tick ISR.
+  * @Param      code: Code in Q16.16 format.
+  */
+static inline uint16_t VoltammetryCore_RoundCode(int64_t code)
+{
+  code = (code + VOLTAMMETRY_CORE_CODE_HALF) >> VOLTAMMETRY_CORE_CODE_FRACTION_BITS;
+
+  if (code < 0)
+  {
+    code = 0;
+  }
+  else if (code > MAX_UINT16)
+  {
+    code = MAX_UINT16;
+  }
+
+  return ((uint16_t)code);
+}
+
+/***
+  * @Brief      Returns the code of the staircase step in Q16.16 format. Last step is
+  *             held, until the core stops. Inlined, since the generators call it from
+  *             the tick ISR.
+  * @Param      pStaircase: Staircase of the technique.
+  * @Param      step: Step index.
+  */
+static inline int64_t VoltammetryCore_GetStepCode(const VoltammetryCore_Staircase_t *pStaircase,
+                                                  uint32_t step)
+{
+  if (step >= pStaircase->stepCount)
+  {
+    step = pStaircase->stepCount - 1;
+  }
+
+  return (pStaircase->startCode + (int64_t)pStaircase->stepIncrement * step);
+}
+
 #endif
\ No newline at end of file
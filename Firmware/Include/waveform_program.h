@@ -0,0 +1,87 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __WAVEFORM_PROGRAM_H
+#define __WAVEFORM_PROGRAM_H
+
+#include "generic.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define WAVEFORM_PROGRAM_MAX_INSTRUCTIONS       32
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  WAVEFORM_PROGRAM_OPCODE_END                   = 0x00,
+  WAVEFORM_PROGRAM_OPCODE_HOLD                  = 0x01,
+  WAVEFORM_PROGRAM_OPCODE_STEP                  = 0x02,
+  WAVEFORM_PROGRAM_OPCODE_RAMP                  = 0x03,
+  WAVEFORM_PROGRAM_OPCODE_PULSE_TRAIN           = 0x04,
+  WAVEFORM_PROGRAM_OPCODE_LOOP                  = 0x05
+} WaveformProgram_Opcode_t;
+
+/* Instruction of the waveform program, as uploaded by the host. Potentials are in volts,
+  durations are in seconds. Level starts from zero.
+  HOLD: sets the level to the potential, holds it for the duration.
+  STEP: steps the level by the potential, holds it for the duration.
+  RAMP: ramps the level by the potential in the duration.
+  PULSE_TRAIN: count pulses of the potential height for the duration, each followed by
+    the level for the base duration.
+  LOOP: executes the instructions from the target to here count times in total. Loops
+    can be nested, but can't cross.
+  END: holds the level until the measurement ends. It's implied after the last one. */
+typedef struct
+{
+  uint8_t                               opcode;
+  uint8_t                               target;         // Loop only.
+  uint16_t                              count;          // Pulse train and loop only.
+  float                                 potential;
+  float                                 duration;
+  float                                 baseDuration;   // Pulse train only.
+} WaveformProgram_Instruction_t;
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      Checks the structure of the program; opcodes, durations, counts and
+  *             loop targets. Potentials should be finite; hold potentials in the
+  *             signal range, relative ones within its span.
+  *
+  * @Param      pProgram->Pointer to the instructions.
+  * @Param      instructionCount->Number of the instructions.
+  *
+  * @Return     TRUE if the program can be loaded, FALSE otherwise.
+  */
+extern Bool_t WaveformProgram_IsValid(const WaveformProgram_Instruction_t *pProgram,
+                                      uint8_t instructionCount);
+
+/***
+  * @Brief      Compiles the program into the segments in ticks and DAC codes, and
+  *             rewinds it. Durations are rounded to the ticks, at least a tick.
+  *
+  * @Param      pProgram->Pointer to the instructions.
+  * @Param      instructionCount->Number of the instructions.
+  * @Param      tickPeriod->Tick period of the generator in seconds.
+  * @Param      dac1LSBPotential->Potential of 1 LSB of the DAC code.
+  */
+extern void WaveformProgram_Load(const WaveformProgram_Instruction_t *pProgram,
+                                 uint8_t instructionCount, float tickPeriod,
+                                 double dac1LSBPotential);
+
+/***
+  * @Brief      Rewinds the loaded program to its start.
+  */
+extern void WaveformProgram_Rewind(void);
+
+/***
+  * @Brief      Generator function of the program. Should be called with the successive
+  *             ticks; level is held for the negative ones. Only the segment state is
+  *             advanced in a tick, so it's suitable for the tick ISR.
+  *
+  * @Param      tickCounter->Ticks since the start of the program.
+  *
+  * @Return     DAC code of the tick.
+  */
+extern uint16_t WaveformProgram_GetDACCode(int32_t tickCounter);
+
+#endif
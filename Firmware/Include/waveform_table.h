@@ -0,0 +1,96 @@
+/**
+  * @author     Onur Efe
+  */
+
+#ifndef __WAVEFORM_TABLE_H
+#define __WAVEFORM_TABLE_H
+
+#include "generic.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Sine table is generated by Tools/waveform_table_generator.py into the
+  waveform_table.c. Regenerate it after changing the table size. */
+#define WAVEFORM_TABLE_SINE_BITS                12
+#define WAVEFORM_TABLE_SINE_LENGTH              (1 << WAVEFORM_TABLE_SINE_BITS)
+
+/* Linear interpolation between the table entries. Reduces the phase truncation
+  error by orders of magnitude, with the cost of a multiplication per lookup. */
+#define WAVEFORM_TABLE_INTERPOLATION            0
+
+#define WAVEFORM_TABLE_AMPLITUDE                32767   // Peak value of the waveforms.
+
+#define WAVEFORM_TABLE_PHASE_QUARTER_PERIOD     0x40000000U
+
+/* Exported variables --------------------------------------------------------*/
+/* One period of sine, with a guard entry at the end for the interpolation. */
+extern const int16_t WaveformTable_Sine[WAVEFORM_TABLE_SINE_LENGTH + 1];
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      Returns sine of the phase. Full period of the phase is 2^32.
+  *
+  * @Param      phase->Phase of the waveform.
+  *
+  * @Return     Value in the range of +-WAVEFORM_TABLE_AMPLITUDE.
+  */
+static inline int32_t WaveformTable_GetSine(uint32_t phase)
+{
+#if WAVEFORM_TABLE_INTERPOLATION
+  uint32_t index = phase >> (32 - WAVEFORM_TABLE_SINE_BITS);
+  int32_t fraction = (int32_t)((phase >> (17 - WAVEFORM_TABLE_SINE_BITS)) & 0x7FFF);
+  int32_t value = WaveformTable_Sine[index];
+
+  return (value + (((WaveformTable_Sine[index + 1] - value) * fraction) >> 15));
+#else
+  return WaveformTable_Sine[phase >> (32 - WAVEFORM_TABLE_SINE_BITS)];
+#endif
+}
+
+/***
+  * @Brief      Returns cosine of the phase. Full period of the phase is 2^32.
+  *
+  * @Param      phase->Phase of the waveform.
+  *
+  * @Return     Value in the range of +-WAVEFORM_TABLE_AMPLITUDE.
+  */
+static inline int32_t WaveformTable_GetCosine(uint32_t phase)
+{
+  return WaveformTable_GetSine(phase + WAVEFORM_TABLE_PHASE_QUARTER_PERIOD);
+}
+
+/***
+  * @Brief      Returns triangle of the phase. Waveform is in phase with the sine,
+  *             it peaks at the quarter period.
+  *
+  * @Param      phase->Phase of the waveform.
+  *
+  * @Return     Value in the range of +-WAVEFORM_TABLE_AMPLITUDE.
+  */
+static inline int32_t WaveformTable_GetTriangle(uint32_t phase)
+{
+  int32_t distance;
+  uint32_t distance_to_peak;
+
+  // Distance to the peak, in the range of 0 to the half period.
+  distance = (int32_t)(phase - WAVEFORM_TABLE_PHASE_QUARTER_PERIOD);
+  distance_to_peak = (distance < 0) ? (0U - (uint32_t)distance) : (uint32_t)distance;
+
+  return ((((int32_t)(WAVEFORM_TABLE_PHASE_QUARTER_PERIOD - distance_to_peak) >> 15) * \
+    WAVEFORM_TABLE_AMPLITUDE) >> 15);
+}
+
+/***
+  * @Brief      Returns staircase of the phase. Staircase follows the triangle, and
+  *             holds its value for each step.
+  *
+  * @Param      phase->Phase of the waveform.
+  * @Param      stepPhase->Phase length of a step.
+  *
+  * @Return     Value in the range of +-WAVEFORM_TABLE_AMPLITUDE.
+  */
+static inline int32_t WaveformTable_GetStaircase(uint32_t phase, uint32_t stepPhase)
+{
+  return WaveformTable_GetTriangle(phase - (phase % stepPhase));
+}
+
+#endif
\ No newline at end of file
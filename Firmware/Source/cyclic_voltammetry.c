@@ -0,0 +1,444 @@
+/**
+  * @author     Onur Efe
+  */
+
+#include "generic.h"
+#include "cyclic_voltammetry.h"
+#include "voltammetry_core.h"
+#include "math.h"
+#include "middlewares.h"
+
+/* Private constants.---------------------------------------------------------*/
+// Scan segments. First one goes from the start to the vertex, then the forward and
+// the backward segments alternate between the vertex and the end.
+#define SEGMENT_FIRST                                   0
+#define SEGMENT_FORWARD                                 1
+#define SEGMENT_BACKWARD                                2
+#define SEGMENT_COUNT                                   3
+
+/* Private function prototypes.-----------------------------------------------*/
+static uint16_t generatorFunctionImplementation(int32_t tickCounter);
+static int64_t  getScanCode(int32_t tickCounter);
+static void     planSegment(uint8_t segment, uint32_t fromCode, uint32_t toCode,
+                            uint32_t ticks);
+static void     measurementCompletedEventHandler(void);
+static void     newDatapointEventHandler(float datapoint, uint8_t edgeIndex);
+
+/* Private variables.---------------------------------------------------------*/
+// During initialization.
+static VoltammetryCore_AnalogConfig_t                   AnalogConfig;
+
+// Scan generator. Codes are in Q16.16 format.
+static uint32_t                                         StartCode;
+static uint32_t                                         VertexCode;
+static uint32_t                                         EndCode;
+static uint32_t                                         FirstSegmentTicks;
+static uint32_t                                         SegmentTicks;
+static uint32_t                                         TotalTicks;
+static uint32_t                                         SegmentLength[SEGMENT_COUNT];
+static int64_t                                          SegmentQuotient[SEGMENT_COUNT];
+static uint32_t                                         SegmentRemainder[SEGMENT_COUNT];
+static int8_t                                           SegmentCarry[SEGMENT_COUNT];
+
+// Generator state, advanced a tick at a time by the tick ISR.
+static int64_t                                          GeneratorCode;
+static uint32_t                                         GeneratorError;
+static uint32_t                                         GeneratorTicksLeft;
+static uint8_t                                          GeneratorSegment;
+
+// For datapoint process;
+static uint16_t                                         DatapointIndex;
+static uint32_t                                         DownsamplingNumber;
+static int32_t                                          FilterDelayTicks;
+static double                                           ADC1LSBCurrent;
+static double                                           CurrentGainCorrection;
+static double                                           CurrentOffsetCorrection;
+
+// New datapoint delegate.
+static CyclicVoltammetry_NewDatapointDelegate_t         NewDatapointDelegate;
+
+// Measurement callback function pointer.
+static CyclicVoltammetry_MeasurementCompletedDelegate_t MeasurementCompletedDelegate;
+static CyclicVoltammetry_MeasurementAbortedDelegate_t   MeasurementAbortedDelegate;
+
+// State.
+static CyclicVoltammetry_State_t                        State = CYCLIC_VOLTAMMETRY_STATE_UNINIT;
+
+/* Public function implementations -------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  *             Scan is planned in ticks here, so the generator runs on integer
+  *             arithmetic only.
+  *
+  * @Param      pSetupParams-> Pointer to data structure which holds setup
+  *             parameters.
+  */
+void CyclicVoltammetry_Setup(CyclicVoltammetry_SetupParams_t *pSetupParams)
+{
+  float tick_period;
+  float min_potential;
+  float max_potential;
+  double sweep_potential;
+  double datapoint_count;
+  VoltammetryCore_SetupParams_t vcore_setup_params;
+
+  /* Check state. */
+  if (State == CYCLIC_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry module setup function called when the module is operating.\n");
+  }
+
+  if ((pSetupParams->scanRate <= 0.0f) || (pSetupParams->stepPotential <= 0.0f) || \
+      (pSetupParams->cycleCount == 0))
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry scan rate, step and cycle count should be positive.\n");
+  }
+
+  // Potential swept through all segments determines the datapoint count.
+  sweep_potential = fabs(pSetupParams->vertexPotential - pSetupParams->startPotential) + \
+    (2.0 * pSetupParams->cycleCount - 1.0) * \
+      fabs(pSetupParams->endPotential - pSetupParams->vertexPotential);
+  datapoint_count = floor((sweep_potential / pSetupParams->stepPotential) + 0.5);
+
+  if ((datapoint_count < 1.0) || (datapoint_count > MAX_UINT16))
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry datapoint count is out of range.\n");
+  }
+
+  // Setup of voltammetry core.
+  vcore_setup_params.datapointCount = (uint16_t)datapoint_count;
+  vcore_setup_params.equilibriumPeriod = pSetupParams->equilibriumPeriod;
+  vcore_setup_params.generatorFunctionInterface = generatorFunctionImplementation;
+  vcore_setup_params.waveform.type = VOLTAMMETRY_CORE_WAVEFORM_CUSTOM;
+  vcore_setup_params.maxRelSamplingFreqErr = pSetupParams->maxRelSamplingFreqErr;
+  vcore_setup_params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  vcore_setup_params.newDatapointDelegate = newDatapointEventHandler;
+  vcore_setup_params.samplingFrequency = pSetupParams->scanRate / pSetupParams->stepPotential;
+  vcore_setup_params.samplingWindow = 0.0f;
+  VoltammetryCore_Setup(&vcore_setup_params, &tick_period);
+
+  DownsamplingNumber = VoltammetryCore_GetDownsamplingNumber();
+  FilterDelayTicks = (int32_t)(VoltammetryCore_GetFilterDelay() + 0.5f);
+
+  // Save feedback path.
+  AnalogConfig.fbPath = pSetupParams->feedbackPath;
+
+  // Save correction values.
+  CurrentGainCorrection = pSetupParams->currentGainCorrection;
+  CurrentOffsetCorrection = pSetupParams->currentOffsetCorrection;
+
+  // Bias DAC holds the middle of the scan, signal DAC sweeps around it. So the
+  // finest signal scaling which covers the half span is used.
+  min_potential = pSetupParams->startPotential;
+  max_potential = pSetupParams->startPotential;
+
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    float potential = (i == 0) ? pSetupParams->vertexPotential : pSetupParams->endPotential;
+
+    if (potential < min_potential)
+    {
+      min_potential = potential;
+    }
+
+    if (potential > max_potential)
+    {
+      max_potential = potential;
+    }
+  }
+
+  if (!VoltammetryCore_DetermineSignalScaling(min_potential, max_potential, &AnalogConfig))
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry potential span is out of the signal DAC range.\n");
+  }
+
+  // Plan the scan. Segment lengths are rounded to the ticks, codes are interpolated
+  // over the rounded lengths. So the vertices are hit exactly.
+  StartCode = VoltammetryCore_GetCode(&AnalogConfig, pSetupParams->startPotential);
+  VertexCode = VoltammetryCore_GetCode(&AnalogConfig, pSetupParams->vertexPotential);
+  EndCode = VoltammetryCore_GetCode(&AnalogConfig, pSetupParams->endPotential);
+
+  FirstSegmentTicks = (uint32_t)((fabs(pSetupParams->vertexPotential - \
+    pSetupParams->startPotential) / (pSetupParams->scanRate * tick_period)) + 0.5);
+  SegmentTicks = (uint32_t)((fabs(pSetupParams->endPotential - \
+    pSetupParams->vertexPotential) / (pSetupParams->scanRate * tick_period)) + 0.5);
+
+  if (SegmentTicks == 0)
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry vertex and end potentials are too close.\n");
+  }
+
+  TotalTicks = FirstSegmentTicks + (2UL * pSetupParams->cycleCount - 1UL) * SegmentTicks;
+
+  // Increments of the segments are divided here, so the generator only accumulates.
+  planSegment(SEGMENT_FIRST, StartCode, VertexCode, FirstSegmentTicks);
+  planSegment(SEGMENT_FORWARD, VertexCode, EndCode, SegmentTicks);
+  planSegment(SEGMENT_BACKWARD, EndCode, VertexCode, SegmentTicks);
+
+  // Calculate ADC 1LSB current.
+  ADC1LSBCurrent = Board_GetADC1LSBCurrent(AnalogConfig.fbPath);
+
+  // Set callback function pointer.
+  MeasurementCompletedDelegate = pSetupParams->measurementCompletedDelegate;
+  MeasurementAbortedDelegate = pSetupParams->measurementAbortedDelegate;
+  NewDatapointDelegate = pSetupParams->newDatapointDelegate;
+
+  State = CYCLIC_VOLTAMMETRY_STATE_READY;
+}
+
+/**
+  * @Brief      Starts cyclic voltammetry.
+  */
+void CyclicVoltammetry_Start(void)
+{
+  // Guard for improper calls.
+  if (State != CYCLIC_VOLTAMMETRY_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry module Start function called when the module isn't ready.\n");
+  }
+
+  DatapointIndex = 0;
+
+  // Turn on analog circuitry, signal DAC starts at the start potential.
+  VoltammetryCore_TurnOnAnalog(&AnalogConfig, VoltammetryCore_RoundCode(getScanCode(0)));
+
+  // Start voltammetry core.
+  VoltammetryCore_Start();
+
+  State = CYCLIC_VOLTAMMETRY_STATE_OPERATING;
+}
+
+/**
+  * @Brief      Cyclic voltammetry task executer and event processor.
+  */
+void CyclicVoltammetry_Execute(void)
+{
+  // If not operating, return.
+  if (State != CYCLIC_VOLTAMMETRY_STATE_OPERATING)
+  {
+    return;
+  }
+
+  // Run subthreads.
+  VoltammetryCore_Execute();
+
+  // Datapoints were lost if the core overran, abort the measurement.
+  if ((State == CYCLIC_VOLTAMMETRY_STATE_OPERATING) && VoltammetryCore_IsOverrun())
+  {
+    CyclicVoltammetry_Stop();
+    
+    if (MeasurementAbortedDelegate != NULL)
+    {
+      MeasurementAbortedDelegate();
+    }
+  }
+}
+
+/***
+  * @Brief      Stops cyclic voltammetry measurement.
+  */
+void CyclicVoltammetry_Stop(void)
+{
+  // Guard for improper calls.
+  if (State != CYCLIC_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Cyclic voltammetry module Stop function called when the module isn't operating.\n");
+  }
+
+  // Stop submodules.
+  VoltammetryCore_Stop();
+
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+
+  State = CYCLIC_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+CyclicVoltammetry_State_t CyclicVoltammetry_GetState(void)
+{
+  return State;
+}
+
+/* Private function implementations. -----------------------------------------*/
+/***
+  * @Brief      Callback function which is triggered when new datapoint parsed.
+  *             Potential is the one applied at the tick which the filtered current
+  *             belongs to.
+  */
+static void newDatapointEventHandler(float datapoint, uint8_t edgeIndex)
+{
+  int32_t tick;
+  float potential;
+
+  // Datapoints are sampled at the end of each downsampling period.
+  tick = (int32_t)((DatapointIndex + 1UL) * DownsamplingNumber) - FilterDelayTicks;
+  DatapointIndex++;
+
+  potential = VoltammetryCore_GetPotential(&AnalogConfig,
+                                           VoltammetryCore_RoundCode(getScanCode(tick)));
+
+  // Call delegate if it's set.
+  if (NewDatapointDelegate != NULL)
+  {
+    NewDatapointDelegate(potential, (float)(ADC1LSBCurrent * datapoint * CurrentGainCorrection + \
+                         CurrentOffsetCorrection));
+  }
+}
+
+/***
+  * @Brief      Callback function which is triggered when the
+  *             measurement is completed.
+  */
+static void measurementCompletedEventHandler(void)
+{
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+
+  // Send signal to the upper layer via callback function.
+  if (MeasurementCompletedDelegate != NULL)
+  {
+    MeasurementCompletedDelegate();
+  }
+
+  State = CYCLIC_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Function which is called when voltammetry core updates
+  *             generated signal. Called from the tick ISR with the consecutive
+  *             ticks, so the code is advanced by the increment of the segment, and
+  *             the remainder of the division is accumulated as an error. Code is
+  *             the same with getScanCode, without a division in a tick. Start
+  *             potential is held during the equilibrium period, end potential after
+  *             the scan.
+  *
+  * @Param      tickCounter->Ticks since the end of the equilibrium period.
+  */
+static uint16_t generatorFunctionImplementation(int32_t tickCounter)
+{
+  if (tickCounter <= 0)
+  {
+    GeneratorCode = StartCode;
+    GeneratorError = 0;
+    GeneratorTicksLeft = FirstSegmentTicks;
+    GeneratorSegment = SEGMENT_FIRST;
+
+    return VoltammetryCore_RoundCode(StartCode);
+  }
+
+  if ((uint32_t)tickCounter >= TotalTicks)
+  {
+    return VoltammetryCore_RoundCode(EndCode);
+  }
+
+  // Segment is completed, the next one starts from its end exactly.
+  if (GeneratorTicksLeft == 0)
+  {
+    if (GeneratorSegment == SEGMENT_FORWARD)
+    {
+      GeneratorSegment = SEGMENT_BACKWARD;
+      GeneratorCode = EndCode;
+    }
+    else
+    {
+      GeneratorSegment = SEGMENT_FORWARD;
+      GeneratorCode = VertexCode;
+    }
+
+    GeneratorError = 0;
+    GeneratorTicksLeft = SegmentTicks;
+  }
+
+  GeneratorCode += SegmentQuotient[GeneratorSegment];
+  GeneratorError += SegmentRemainder[GeneratorSegment];
+
+  if (GeneratorError >= SegmentLength[GeneratorSegment])
+  {
+    GeneratorError -= SegmentLength[GeneratorSegment];
+    GeneratorCode += SegmentCarry[GeneratorSegment];
+  }
+
+  GeneratorTicksLeft--;
+
+  return VoltammetryCore_RoundCode(GeneratorCode);
+}
+
+/***
+  * @Brief      Returns the scan code of any tick. Code is interpolated between the
+  *             segment ends, so it doesn't accumulate an increment error. Used out
+  *             of the tick ISR, since it divides.
+  *
+  * @Param      tickCounter->Ticks since the end of the equilibrium period.
+  */
+static int64_t getScanCode(int32_t tickCounter)
+{
+  uint32_t tick;
+  uint32_t segment;
+
+  if (tickCounter <= 0)
+  {
+    return StartCode;
+  }
+  else if ((uint32_t)tickCounter >= TotalTicks)
+  {
+    return EndCode;
+  }
+  else if ((uint32_t)tickCounter < FirstSegmentTicks)
+  {
+    return StartCode + ((int64_t)VertexCode - StartCode) * tickCounter / FirstSegmentTicks;
+  }
+
+  // Even segments go from the vertex to the end, odd ones return.
+  tick = (uint32_t)tickCounter - FirstSegmentTicks;
+  segment = tick / SegmentTicks;
+  tick -= segment * SegmentTicks;
+
+  if (segment & 1U)
+  {
+    return EndCode + ((int64_t)VertexCode - EndCode) * tick / SegmentTicks;
+  }
+
+  return VertexCode + ((int64_t)EndCode - VertexCode) * tick / SegmentTicks;
+}
+
+/***
+  * @Brief      Divides the code change of a segment to its ticks. Magnitude is
+  *             divided, so the accumulated code truncates towards the segment start
+  *             like getScanCode.
+  *
+  * @Param      segment->Segment to plan.
+  * @Param      fromCode->Code at the start of the segment.
+  * @Param      toCode->Code at the end of the segment.
+  * @Param      ticks->Length of the segment.
+  */
+static void planSegment(uint8_t segment, uint32_t fromCode, uint32_t toCode, uint32_t ticks)
+{
+  uint64_t change;
+
+  SegmentLength[segment] = ticks;
+
+  if (ticks == 0)
+  {
+    SegmentQuotient[segment] = 0;
+    SegmentRemainder[segment] = 0;
+    SegmentCarry[segment] = 0;
+    return;
+  }
+
+  change = (toCode >= fromCode) ? (uint64_t)(toCode - fromCode) : (uint64_t)(fromCode - toCode);
+  SegmentCarry[segment] = (toCode >= fromCode) ? 1 : -1;
+  SegmentQuotient[segment] = SegmentCarry[segment] * (int64_t)(change / ticks);
+  SegmentRemainder[segment] = (uint32_t)(change % ticks);
+}
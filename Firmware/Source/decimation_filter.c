@@ -0,0 +1,25 @@
+/**
+  * @author     Onur Efe
+  */
+
+/* This file is generated by Tools/decimation_filter_generator.py. Don't edit. */
+
+#include "decimation_filter.h"
+
+#if (DECIMATION_FILTER_CIC_ORDER != 3) || (DECIMATION_FILTER_FIR_DECIMATION != 4) || \
+    (DECIMATION_FILTER_FIR_TAP_COUNT != 32)
+#error "Decimation filter is generated for other parameters. Regenerate it."
+#endif
+
+/* Exported variables --------------------------------------------------------*/
+const float DecimationFilter_FIRCoefficients[DECIMATION_FILTER_FIR_TAP_COUNT] = 
+{
+  -3.823054640e-04f, -1.163488599e-03f, -1.709071999e-03f, -6.595158809e-04f,
+  +2.978583798e-03f, +8.058477981e-03f, +1.043562990e-02f, +4.791198399e-03f,
+  -1.081595834e-02f, -3.037259311e-02f, -3.949332345e-02f, -2.157929375e-02f,
+  +3.162079145e-02f, +1.114892768e-01f, +1.927334952e-01f, +2.440680971e-01f,
+  +2.440680971e-01f, +1.927334952e-01f, +1.114892768e-01f, +3.162079145e-02f,
+  -2.157929375e-02f, -3.949332345e-02f, -3.037259311e-02f, -1.081595834e-02f,
+  +4.791198399e-03f, +1.043562990e-02f, +8.058477981e-03f, +2.978583798e-03f,
+  -6.595158809e-04f, -1.709071999e-03f, -1.163488599e-03f, -3.823054640e-04f
+};
\ No newline at end of file
@@ -1,454 +1,1325 @@
-#include "device_manager.h"
-#include "characteristic_server.h"
-#include "amperometry.h"
-#include "eis.h"
-#include "middlewares.h"
-
-/* Private constants ---------------------------------------------------------*/
-// Abbrevations.
-#define PROPERTY_READABLE               CHARACTERISTIC_SERVER_CHAR_PROP_READABLE
-#define PROPERTY_WRITABLE               CHARACTERISTIC_SERVER_CHAR_PROP_WRITABLE
-#define PROPERTY_VARIABLE_LENGTH        CHARACTERISTIC_SERVER_CHAR_PROP_VARIABLE_LENGTH
-#define PROPERTY_REGISTERED             CHARACTERISTIC_SERVER_CHAR_PROP_REGISTERED
-
-// Amperometry Service characteristic IDs.
-#define AMPEROMETRY_SERVICE_SAMPLING_FREQUENCY_CHAR_ID          0x0000
-#define AMPEROMETRY_SERVICE_DATAPOINT_COUNT_CHAR_ID             0x0001
-#define AMPEROMETRY_SERVICE_POTENTIAL_CHAR_ID                   0x0002
-#define AMPEROMETRY_SERVICE_RANGE_CHAR_ID                       0x0003
-#define AMPEROMETRY_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID          0x0004
-#define AMPEROMETRY_SERVICE_DATAPOINT_CHAR_ID                   0x0005
-
-// Device Control Service characteristic IDs.
-#define DEV_CTRL_SERVICE_COMMAND_POINT_CHAR_ID                  0x0100
-#define DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID               0x0101
-#define DEV_CTRL_SERVICE_STATUS_CHAR_ID                         0x0102
-#define DEV_CTRL_SERVICE_BATTERY_LEVEL_CHAR_ID                  0x0103
-
-// Amperometry Service characteristic validations.
-#define AMPEROMETRY_SERVICE_IS_VALID_SAMPLING_FREQUENCY(f) \
-(((f) <= AMPEROMETRY_MAX_SAMPLING_FREQUENCY) && ((f) >= AMPEROMETRY_MIN_SAMPLING_FREQUENCY))
-
-#define AMPEROMETRY_SERVICE_IS_VALID_DATAPOINT_COUNT(n) \
-((n) != 0)
-
-#define AMPEROMETRY_SERVICE_IS_VALID_POTENTIAL(v) \
-(((v) >= BOARD_MIN_SIGNAL_POTENTIAL) && ((v) <= BOARD_MAX_SIGNAL_POTENTIAL))
-
-#define AMPEROMETRY_SERVICE_IS_VALID_RANGE(r) \
-(((r) == RANGE_1MA) || ((r) == RANGE_100UA) || ((r) == RANGE_10UA) || ((r) == RANGE_1UA) || \
- ((r) == RANGE_100NA))
-
-#define AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(t) \
-((t) >= 0.0f)
-
-// Device Control Service characteristic validations.
-#define DEV_CTRL_SERVICE_IS_VALID_COMMAND(c) \
-(((c) == COMMAND_START_AMPEROMETRY) || ((c) == COMMAND_STOP_MEASUREMENT))
-
-/* Private typedefs ----------------------------------------------------------*/
-// Short name for characteristic.
-typedef CharacteristicServer_Characteristic_t        Characteristic_t;
-
-// Enumerations for characteristics.
-// Range type.
-typedef enum
-{
-  RANGE_1MA = 0,
-  RANGE_100UA,
-  RANGE_10UA,
-  RANGE_1UA,
-  RANGE_100NA
-} Range_t;
-
-// Available commands.
-typedef enum
-{
-  COMMAND_START_AMPEROMETRY = 0,
-  COMMAND_STOP_MEASUREMENT = 1
-} Command_t;
-
-// Command responses.
-typedef enum
-{
-  COMMAND_RESP_SUCCESS = 0,
-  COMMAND_RESP_INVALID_COMMAND = 1,
-  COMMAND_RESP_STATE_NOT_COMPATIBLE = 2,
-  COMMAND_RESP_INVALID_SETUP_PARAMETER = 3
-} CommandResp_t;
-
-// Device status(also a control type).
-typedef enum
-{
-  DEVICE_STATUS_IDLE = 0,
-  DEVICE_STATUS_AMPEROMETRY_MEASUREMENT = 1
-} DeviceStatus_t;
-
-/* Private function declerations ---------------------------------------------*/
-static void                     startAmperometry(void);
-static Bool_t                   checkAmperometryParameters(void);
-static Board_TIAFBPath_t        getFBPath(Range_t range);
-static void                     measurementCompletedEventHandler(void);
-static void                     amperometryNewDatapointEventHandler(float datapoint);
-static void                     writeEventHandler(uint16_t charId);
-static void                     connectionStateChangedEventHandler(Bool_t isConnected);
-
-/* Private variables. --------------------------------------------------------*/
-// Control variables.
-static DeviceManager_State_t    State = DEVICE_MANAGER_STATE_UNINIT;
-static DeviceStatus_t           DeviceStatus;
-
-// Amperometry Service characteristics.
-static float                    AmperometryServiceSamplingFrequencyCharData;
-static uint16_t                 AmperometryServiceDatapointCountCharData;
-static float                    AmperometryServicePotentialCharData;
-static uint8_t                  AmperometryServiceRangeCharData;
-static float                    AmperometryServiceEquilibriumPeriodCharData;
-static float                    AmperometryServiceDatapointCharData;
-
-// Device Control Service characteristics.
-static Command_t                DevCtrlServiceCommandPointCharData;
-static CommandResp_t            DevCtrlServiceCommandResponseCharData;
-static DeviceStatus_t           DevCtrlServiceStatusCharData;
-static float                    DevCtrlServiceBatteryLevelCharData;
-
-// Characteristic Database.
-static Characteristic_t CharacteristicDatabase[] = \
-  {
-    // Amperometry Service.
-    // Sampling Frequency Characteristic
-    {
-      AMPEROMETRY_SERVICE_SAMPLING_FREQUENCY_CHAR_ID,
-      (uint8_t *)&AmperometryServiceSamplingFrequencyCharData,
-      sizeof(AmperometryServiceSamplingFrequencyCharData),
-      (PROPERTY_READABLE | PROPERTY_WRITABLE)
-    },
-    // Datapoint Count Characteristic.
-    {
-      AMPEROMETRY_SERVICE_DATAPOINT_COUNT_CHAR_ID,
-      (uint8_t *)&AmperometryServiceDatapointCountCharData,
-      sizeof(AmperometryServiceDatapointCountCharData),
-      (PROPERTY_READABLE | PROPERTY_WRITABLE)
-    },
-    // Potential Characteristic.
-    {
-      AMPEROMETRY_SERVICE_POTENTIAL_CHAR_ID,
-      (uint8_t *)&AmperometryServicePotentialCharData,
-      sizeof(AmperometryServicePotentialCharData),
-      (PROPERTY_READABLE | PROPERTY_WRITABLE)
-    },
-    // Equilibrium Period Characteristic.
-    {
-      AMPEROMETRY_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID,
-      (uint8_t *)&AmperometryServiceEquilibriumPeriodCharData,
-      sizeof(AmperometryServiceEquilibriumPeriodCharData),
-      (PROPERTY_READABLE | PROPERTY_WRITABLE)
-    },
-    // Range Characteristic.
-    {
-      AMPEROMETRY_SERVICE_RANGE_CHAR_ID,
-      (uint8_t *)&AmperometryServiceRangeCharData,
-      sizeof(AmperometryServiceRangeCharData),
-      (PROPERTY_READABLE | PROPERTY_WRITABLE)
-    },
-    // Datapoint Characteristic.
-    {
-      AMPEROMETRY_SERVICE_DATAPOINT_CHAR_ID,
-      (uint8_t *)&AmperometryServiceDatapointCharData,
-      sizeof(AmperometryServiceDatapointCharData),
-      (PROPERTY_READABLE)
-    },
-    
-    // Device Control Service.
-    // Command Point Characteristic.
-    {
-      DEV_CTRL_SERVICE_COMMAND_POINT_CHAR_ID,
-      (uint8_t *)&DevCtrlServiceCommandPointCharData,
-      sizeof(DevCtrlServiceCommandPointCharData),
-      (PROPERTY_WRITABLE)
-    },
-    // Command Response Characteristic.
-    {
-      DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID,
-      (uint8_t *)&DevCtrlServiceCommandResponseCharData,
-      sizeof(DevCtrlServiceCommandResponseCharData),
-      (PROPERTY_READABLE)
-    },
-    // Status Characteristic.
-    {
-      DEV_CTRL_SERVICE_STATUS_CHAR_ID,
-      (uint8_t *)&DevCtrlServiceStatusCharData,
-      sizeof(DevCtrlServiceStatusCharData),
-      (PROPERTY_READABLE)
-    },
-    // Battery Level Characteristic.
-    {
-      DEV_CTRL_SERVICE_BATTERY_LEVEL_CHAR_ID,
-      (uint8_t *)&DevCtrlServiceBatteryLevelCharData,
-      sizeof(DevCtrlServiceBatteryLevelCharData),
-      (PROPERTY_READABLE)
-    }
-  };
-
-/* Exported function implementations -----------------------------------------*/
-void DeviceManager_Setup(void)
-{
-  // Check the state compability.
-  if (State == DEVICE_MANAGER_STATE_OPERATING)
-  {
-    ExceptionHandler_ThrowException(\
-      "Device manager module Setup function called when not uninitialized.");
-  }
-  
-  // Initialize eeprom emulator.
-  EepromEmulator_Init();
-  
-  // Make the setup of the characteristic server.
-  CharacteristicServer_SetupParams_t params;
-  
-  params.numOfChars = sizeof(CharacteristicDatabase) / sizeof(CharacteristicDatabase[0]);
-  params.pCharTable = CharacteristicDatabase;
-  params.connectionStateChangedDelegate = connectionStateChangedEventHandler;
-  params.writeDelegate = writeEventHandler;
-  
-  CharacteristicServer_Setup(&params);
-  
-  State = DEVICE_MANAGER_STATE_READY;
-}
-
-// TODO: Implementation.
-void DeviceManager_Start(void)
-{
-  // Check the state compability.
-  if (State != DEVICE_MANAGER_STATE_READY)
-  {
-    ExceptionHandler_ThrowException(\
-      "Device manager module start function called when not ready.");
-  }
-  
-  // Start characteristic server.
-  CharacteristicServer_Start();
-  
-  State = DEVICE_MANAGER_STATE_OPERATING;
-  DeviceStatus = DEVICE_STATUS_IDLE;
-}
-
-// TODO: Implementation.
-void DeviceManager_Execute(void)
-{
-  // Check the state compability.
-  if (State != DEVICE_MANAGER_STATE_OPERATING)
-  {
-    ExceptionHandler_ThrowException(\
-      "Device manager module Execute function called when not operating.");
-  }
-  
-  // Execute submodules.
-  CharacteristicServer_Execute();
-  
-  // Run operating measurement module.
-  if (DeviceStatus == DEVICE_STATUS_AMPEROMETRY_MEASUREMENT)
-  {
-    Amperometry_Execute();
-  } 
-}
-
-// TODO: Implementation.
-void DeviceManager_Stop(void)
-{
-  // Check the state compability.
-  if (State != DEVICE_MANAGER_STATE_OPERATING)
-  {
-    ExceptionHandler_ThrowException(\
-      "Device manager server module Stop function called when not operating.");
-  }
-  
-  State = DEVICE_MANAGER_STATE_READY;
-}
-
-/* Private function implementations ------------------------------------------*/
-static void writeEventHandler(uint16_t charId)
-{
-  // Take action according to written characteristic.
-  switch(charId)
-  {
-    // If command point is written, set related event.
-  case DEV_CTRL_SERVICE_COMMAND_POINT_CHAR_ID:
-    {
-      CommandResp_t resp;
-      
-      // Take action according to command.
-      switch (DevCtrlServiceCommandPointCharData)
-      {
-      case COMMAND_START_AMPEROMETRY:
-        {
-          if (DeviceStatus != DEVICE_STATUS_IDLE)
-          {
-            resp = COMMAND_RESP_STATE_NOT_COMPATIBLE;
-          }
-          else if (checkAmperometryParameters())
-          {
-            startAmperometry();
-            DeviceStatus = DEVICE_STATUS_AMPEROMETRY_MEASUREMENT;
-            resp = COMMAND_RESP_SUCCESS;
-          }
-          else
-          {
-            resp = COMMAND_RESP_INVALID_SETUP_PARAMETER;
-          }
-        }
-        break;
-        
-      case COMMAND_STOP_MEASUREMENT:
-        {
-          // If doing amperometry measurement, stop amperometry module.
-          if (DeviceStatus == DEVICE_STATUS_AMPEROMETRY_MEASUREMENT)
-          {
-            Amperometry_Stop();
-            // CharacteristicServer_ClearNotifications();
-            DeviceStatus = DEVICE_STATUS_IDLE;
-          }
-          
-          resp = COMMAND_RESP_SUCCESS;
-        }
-        break;
-        
-      default:
-        resp = COMMAND_RESP_INVALID_COMMAND;
-        break;
-      }
-      
-      // Update command response characteristic.
-      CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID, 
-                                                (uint8_t *)&resp, sizeof(resp));
-      
-      // Update device status characteristic.
-      CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
-                                                (uint8_t *)&DeviceStatus,
-                                                sizeof(DeviceStatus));
-    }
-    break;
-  }
-}
-
-// TODO: Amperometry module state is assumed as ready or unitialized. This may
-// lead some problems. Need to be careful about this.
-static void startAmperometry(void)
-{
-  // Set params.
-  Amperometry_SetupParams_t params;
-    
-  params.datapointCount = AmperometryServiceDatapointCountCharData;
-  params.equilibriumPeriod = AmperometryServiceEquilibriumPeriodCharData;
-  params.potential = AmperometryServicePotentialCharData;
-  params.samplingFrequency = AmperometryServiceSamplingFrequencyCharData;
-  params.feedbackPath = getFBPath((Range_t)AmperometryServiceRangeCharData);
-  params.maxRelSamplingFreqErr = 0.001;
-  params.currentGainCorrection = 1.0;
-  params.currentOffsetCorrection = 1.0;
-  params.measurementCompletedDelegate = measurementCompletedEventHandler;
-  params.newDatapointDelegate = amperometryNewDatapointEventHandler;
-    
-  Amperometry_Setup(&params);
-    
-  // Set calibration relay state on.
-  Board_SetCalibrationRelayState(BOARD_CALIBRATION_RELAY_STATE_OFF);
-  
-  // Start amperometry.
-  Amperometry_Start();
-}
-  
-static Bool_t checkAmperometryParameters(void)
-{
-  // Check parameters.
-  if (\
-    AMPEROMETRY_SERVICE_IS_VALID_SAMPLING_FREQUENCY(AmperometryServiceSamplingFrequencyCharData) && \
-    AMPEROMETRY_SERVICE_IS_VALID_DATAPOINT_COUNT(AmperometryServiceDatapointCountCharData) && \
-    AMPEROMETRY_SERVICE_IS_VALID_POTENTIAL(AmperometryServicePotentialCharData) && \
-    AMPEROMETRY_SERVICE_IS_VALID_RANGE(AmperometryServiceRangeCharData) && \
-    AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(AmperometryServiceEquilibriumPeriodCharData)\
-      )
-  {
-    return TRUE;
-  }
-  else
-  {
-    return FALSE;
-  }
-}
-
-// TODO: NOTHING.
-static Board_TIAFBPath_t getFBPath(Range_t range)
-{
-  Board_TIAFBPath_t retval;
-  
-  switch (range)
-  {
-  case RANGE_1MA:
-    retval = BOARD_TIA_FB_PATH_0;
-    break;
-    
-  case RANGE_100UA:
-    retval = BOARD_TIA_FB_PATH_1;
-    break;
-    
-  case RANGE_10UA:
-    retval = BOARD_TIA_FB_PATH_2;
-    break;
-    
-  case RANGE_1UA:
-    retval = BOARD_TIA_FB_PATH_3;
-    break;
-    
-  case RANGE_100NA:
-    retval = BOARD_TIA_FB_PATH_4;
-    break;
-  }
-  
-  return retval;
-}
-
-// TODO: NOTHING.
-static void amperometryNewDatapointEventHandler(float datapoint)
-{
-  // Update characteristic. This will send notification to the client.
-  CharacteristicServer_UpdateCharacteristic(AMPEROMETRY_SERVICE_DATAPOINT_CHAR_ID, 
-                                            (uint8_t *)&datapoint, 
-                                            sizeof(datapoint));
-}
-
-// TODO: Implementation. Handles both amperometry and eis measurement completed events.
-static void measurementCompletedEventHandler(void)
-{
-  // Update device status.
-  DeviceStatus = DEVICE_STATUS_IDLE;
-  
-  // Update related characteristic.
-  CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
-                                            (uint8_t *)&DeviceStatus,
-                                            sizeof(DeviceStatus));
-}
-
-// TODO: Timeout occurred. This is a problem. Stop the device(if it's operating).
-// Stop every operation. 
-static void connectionStateChangedEventHandler(Bool_t isConnected)
-{
-  if (isConnected)
-  {
-
-  }
-  else
-  {
-    // If doing amperometry measurement, stop amperometry module.
-    if (DeviceStatus == DEVICE_STATUS_AMPEROMETRY_MEASUREMENT)
-    {
-      Amperometry_Stop();
-      DeviceStatus = DEVICE_STATUS_IDLE;
-    }
-    
-    // Update characteristic(it won't be notified since the device is disconnected).
-    CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
-                                              (uint8_t *)&DeviceStatus,
-                                              sizeof(DeviceStatus));
-  }
+#include "device_manager.h"
+#include "characteristic_server.h"
+#include "amperometry.h"
+#include "cyclic_voltammetry.h"
+#include "square_wave_voltammetry.h"
+#include "differential_pulse_voltammetry.h"
+#include "programmed_voltammetry.h"
+#include "eis.h"
+#include "middlewares.h"
+#include "math.h"
+
+/* Private constants ---------------------------------------------------------*/
+// Abbrevations.
+#define PROPERTY_READABLE               CHARACTERISTIC_SERVER_CHAR_PROP_READABLE
+#define PROPERTY_WRITABLE               CHARACTERISTIC_SERVER_CHAR_PROP_WRITABLE
+#define PROPERTY_VARIABLE_LENGTH        CHARACTERISTIC_SERVER_CHAR_PROP_VARIABLE_LENGTH
+#define PROPERTY_REGISTERED             CHARACTERISTIC_SERVER_CHAR_PROP_REGISTERED
+
+// Amperometry Service characteristic IDs.
+#define AMPEROMETRY_SERVICE_SAMPLING_FREQUENCY_CHAR_ID          0x0000
+#define AMPEROMETRY_SERVICE_DATAPOINT_COUNT_CHAR_ID             0x0001
+#define AMPEROMETRY_SERVICE_POTENTIAL_CHAR_ID                   0x0002
+#define AMPEROMETRY_SERVICE_RANGE_CHAR_ID                       0x0003
+#define AMPEROMETRY_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID          0x0004
+#define AMPEROMETRY_SERVICE_DATAPOINT_CHAR_ID                   0x0005
+
+// Cyclic Voltammetry Service characteristic IDs.
+#define CV_SERVICE_START_POTENTIAL_CHAR_ID                      0x0200
+#define CV_SERVICE_VERTEX_POTENTIAL_CHAR_ID                     0x0201
+#define CV_SERVICE_END_POTENTIAL_CHAR_ID                        0x0202
+#define CV_SERVICE_SCAN_RATE_CHAR_ID                            0x0203
+#define CV_SERVICE_STEP_POTENTIAL_CHAR_ID                       0x0204
+#define CV_SERVICE_CYCLE_COUNT_CHAR_ID                          0x0205
+#define CV_SERVICE_RANGE_CHAR_ID                                0x0206
+#define CV_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID                   0x0207
+#define CV_SERVICE_DATAPOINT_CHAR_ID                            0x0208
+
+// Square Wave Voltammetry Service characteristic IDs.
+#define SWV_SERVICE_START_POTENTIAL_CHAR_ID                     0x0300
+#define SWV_SERVICE_END_POTENTIAL_CHAR_ID                       0x0301
+#define SWV_SERVICE_STEP_POTENTIAL_CHAR_ID                      0x0302
+#define SWV_SERVICE_AMPLITUDE_CHAR_ID                           0x0303
+#define SWV_SERVICE_FREQUENCY_CHAR_ID                           0x0304
+#define SWV_SERVICE_RANGE_CHAR_ID                               0x0305
+#define SWV_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID                  0x0306
+#define SWV_SERVICE_DATAPOINT_CHAR_ID                           0x0307
+
+// Differential Pulse Voltammetry Service characteristic IDs.
+#define DPV_SERVICE_START_POTENTIAL_CHAR_ID                     0x0400
+#define DPV_SERVICE_END_POTENTIAL_CHAR_ID                       0x0401
+#define DPV_SERVICE_STEP_POTENTIAL_CHAR_ID                      0x0402
+#define DPV_SERVICE_AMPLITUDE_CHAR_ID                           0x0403
+#define DPV_SERVICE_PULSE_WIDTH_CHAR_ID                         0x0404
+#define DPV_SERVICE_STEP_PERIOD_CHAR_ID                         0x0405
+#define DPV_SERVICE_SAMPLING_WINDOW_CHAR_ID                     0x0406
+#define DPV_SERVICE_RANGE_CHAR_ID                               0x0407
+#define DPV_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID                  0x0408
+#define DPV_SERVICE_DATAPOINT_CHAR_ID                           0x0409
+
+// Waveform Program Service characteristic IDs.
+#define PROGRAM_SERVICE_INSTRUCTION_CHAR_ID                     0x0500
+#define PROGRAM_SERVICE_LENGTH_CHAR_ID                          0x0501
+#define PROGRAM_SERVICE_SAMPLING_FREQUENCY_CHAR_ID              0x0502
+#define PROGRAM_SERVICE_DATAPOINT_COUNT_CHAR_ID                 0x0503
+#define PROGRAM_SERVICE_SAMPLING_WINDOW_CHAR_ID                 0x0504
+#define PROGRAM_SERVICE_RANGE_CHAR_ID                           0x0505
+#define PROGRAM_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID              0x0506
+#define PROGRAM_SERVICE_DATAPOINT_CHAR_ID                       0x0507
+
+// Device Control Service characteristic IDs.
+#define DEV_CTRL_SERVICE_COMMAND_POINT_CHAR_ID                  0x0100
+#define DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID               0x0101
+#define DEV_CTRL_SERVICE_STATUS_CHAR_ID                         0x0102
+#define DEV_CTRL_SERVICE_BATTERY_LEVEL_CHAR_ID                  0x0103
+
+// Amperometry Service characteristic validations.
+#define AMPEROMETRY_SERVICE_IS_VALID_SAMPLING_FREQUENCY(f) \
+(((f) <= AMPEROMETRY_MAX_SAMPLING_FREQUENCY) && ((f) >= AMPEROMETRY_MIN_SAMPLING_FREQUENCY))
+
+#define AMPEROMETRY_SERVICE_IS_VALID_DATAPOINT_COUNT(n) \
+((n) != 0)
+
+#define AMPEROMETRY_SERVICE_IS_VALID_POTENTIAL(v) \
+(((v) >= BOARD_MIN_SIGNAL_POTENTIAL) && ((v) <= BOARD_MAX_SIGNAL_POTENTIAL))
+
+#define AMPEROMETRY_SERVICE_IS_VALID_RANGE(r) \
+(((r) == RANGE_1MA) || ((r) == RANGE_100UA) || ((r) == RANGE_10UA) || ((r) == RANGE_1UA) || \
+ ((r) == RANGE_100NA))
+
+#define AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(t) \
+((t) >= 0.0f)
+
+// Cyclic Voltammetry Service characteristic validations.
+#define CV_SERVICE_IS_VALID_POTENTIAL(v) \
+(((v) >= BOARD_MIN_SIGNAL_POTENTIAL) && ((v) <= BOARD_MAX_SIGNAL_POTENTIAL))
+
+#define CV_SERVICE_IS_VALID_SAMPLING_FREQUENCY(f) \
+(((f) <= CYCLIC_VOLTAMMETRY_MAX_SAMPLING_FREQUENCY) && \
+ ((f) >= CYCLIC_VOLTAMMETRY_MIN_SAMPLING_FREQUENCY))
+
+#define CV_SERVICE_IS_VALID_STEP(s, vertex, end) \
+(((s) > 0.0f) && (fabs((end) - (vertex)) >= (s)))
+
+#define CV_SERVICE_IS_VALID_CYCLE_COUNT(n) \
+((n) != 0)
+
+// Square Wave Voltammetry Service characteristic validations.
+#define SWV_SERVICE_IS_VALID_FREQUENCY(f) \
+(((f) <= SQUARE_WAVE_VOLTAMMETRY_MAX_FREQUENCY) && ((f) >= SQUARE_WAVE_VOLTAMMETRY_MIN_FREQUENCY))
+
+#define SWV_SERVICE_IS_VALID_STEP(s) \
+((s) > 0.0f)
+
+#define SWV_SERVICE_IS_VALID_AMPLITUDE(a) \
+(((a) >= 0.0f) && ((a) <= BOARD_MAX_SIGNAL_POTENTIAL))
+
+// Differential Pulse Voltammetry Service characteristic validations.
+#define DPV_SERVICE_IS_VALID_STEP_PERIOD(t) \
+(((t) >= DIFFERENTIAL_PULSE_VOLTAMMETRY_MIN_STEP_PERIOD) && \
+ ((t) <= DIFFERENTIAL_PULSE_VOLTAMMETRY_MAX_STEP_PERIOD))
+
+// Timing is checked in seconds, setup fits the tick rounded pulse and window into the step.
+#define DPV_SERVICE_IS_VALID_TIMING(step, pulse, window) \
+(((window) > 0.0f) && ((pulse) >= (window)) && (((pulse) + (window)) <= (step)))
+
+// Waveform Program Service characteristic validations.
+#define PROGRAM_SERVICE_IS_VALID_SAMPLING_FREQUENCY(f) \
+(((f) <= PROGRAMMED_VOLTAMMETRY_MAX_SAMPLING_FREQUENCY) && \
+ ((f) >= PROGRAMMED_VOLTAMMETRY_MIN_SAMPLING_FREQUENCY))
+
+#define PROGRAM_SERVICE_IS_VALID_SAMPLING_WINDOW(w) \
+(((w) >= 0.0f) && ((w) <= 1.0f))
+
+// Device Control Service characteristic validations.
+#define DEV_CTRL_SERVICE_IS_VALID_COMMAND(c) \
+(((c) == COMMAND_START_AMPEROMETRY) || ((c) == COMMAND_STOP_MEASUREMENT) || \
+ ((c) == COMMAND_START_CYCLIC_VOLTAMMETRY) || ((c) == COMMAND_START_SQUARE_WAVE_VOLTAMMETRY) || \
+ ((c) == COMMAND_START_DIFFERENTIAL_PULSE_VOLTAMMETRY) || \
+ ((c) == COMMAND_START_PROGRAMMED_VOLTAMMETRY))
+
+/* Private typedefs ----------------------------------------------------------*/
+// Short name for characteristic.
+typedef CharacteristicServer_Characteristic_t        Characteristic_t;
+
+// Enumerations for characteristics.
+// Range type.
+typedef enum
+{
+  RANGE_1MA = 0,
+  RANGE_100UA,
+  RANGE_10UA,
+  RANGE_1UA,
+  RANGE_100NA
+} Range_t;
+
+// Available commands.
+typedef enum
+{
+  COMMAND_START_AMPEROMETRY = 0,
+  COMMAND_STOP_MEASUREMENT = 1,
+  COMMAND_START_CYCLIC_VOLTAMMETRY = 2,
+  COMMAND_START_SQUARE_WAVE_VOLTAMMETRY = 3,
+  COMMAND_START_DIFFERENTIAL_PULSE_VOLTAMMETRY = 4,
+  COMMAND_START_PROGRAMMED_VOLTAMMETRY = 5
+} Command_t;
+
+// Command responses.
+typedef enum
+{
+  COMMAND_RESP_SUCCESS = 0,
+  COMMAND_RESP_INVALID_COMMAND = 1,
+  COMMAND_RESP_STATE_NOT_COMPATIBLE = 2,
+  COMMAND_RESP_INVALID_SETUP_PARAMETER = 3,
+  COMMAND_RESP_MEASUREMENT_ABORTED = 4      // Notified without a command, on measurement abort.
+} CommandResp_t;
+
+// Device status(also a control type).
+typedef enum
+{
+  DEVICE_STATUS_IDLE = 0,
+  DEVICE_STATUS_AMPEROMETRY_MEASUREMENT = 1,
+  DEVICE_STATUS_CYCLIC_VOLTAMMETRY_MEASUREMENT = 2,
+  DEVICE_STATUS_SQUARE_WAVE_VOLTAMMETRY_MEASUREMENT = 3,
+  DEVICE_STATUS_DIFFERENTIAL_PULSE_VOLTAMMETRY_MEASUREMENT = 4,
+  DEVICE_STATUS_PROGRAMMED_VOLTAMMETRY_MEASUREMENT = 5
+} DeviceStatus_t;
+
+/* Private function declerations ---------------------------------------------*/
+static void                     startAmperometry(void);
+static Bool_t                   checkAmperometryParameters(void);
+static void                     startCyclicVoltammetry(void);
+static Bool_t                   checkCyclicVoltammetryParameters(void);
+static void                     startSquareWaveVoltammetry(void);
+static Bool_t                   checkSquareWaveVoltammetryParameters(void);
+static void                     startDifferentialPulseVoltammetry(void);
+static Bool_t                   checkDifferentialPulseVoltammetryParameters(void);
+static void                     startProgrammedVoltammetry(void);
+static Bool_t                   checkProgrammedVoltammetryParameters(void);
+static Board_TIAFBPath_t        getFBPath(Range_t range);
+static void                     measurementCompletedEventHandler(void);
+static void                     measurementAbortedEventHandler(void);
+static void                     amperometryNewDatapointEventHandler(float datapoint);
+static void                     cvNewDatapointEventHandler(float potential, float current);
+static void                     swvNewDatapointEventHandler(float potential, float forward,
+                                                            float reverse, float difference);
+static void                     dpvNewDatapointEventHandler(float potential, float base,
+                                                            float pulse, float difference);
+static void                     programNewDatapointEventHandler(float datapoint);
+static void                     writeEventHandler(uint16_t charId);
+static void                     connectionStateChangedEventHandler(Bool_t isConnected);
+
+/* Private variables. --------------------------------------------------------*/
+// Control variables.
+static DeviceManager_State_t    State = DEVICE_MANAGER_STATE_UNINIT;
+static DeviceStatus_t           DeviceStatus;
+
+// Amperometry Service characteristics.
+static float                    AmperometryServiceSamplingFrequencyCharData;
+static uint16_t                 AmperometryServiceDatapointCountCharData;
+static float                    AmperometryServicePotentialCharData;
+static uint8_t                  AmperometryServiceRangeCharData;
+static float                    AmperometryServiceEquilibriumPeriodCharData;
+static float                    AmperometryServiceDatapointCharData;
+
+// Cyclic Voltammetry Service characteristics.
+static float                    CVServiceStartPotentialCharData;
+static float                    CVServiceVertexPotentialCharData;
+static float                    CVServiceEndPotentialCharData;
+static float                    CVServiceScanRateCharData;
+static float                    CVServiceStepPotentialCharData;
+static uint16_t                 CVServiceCycleCountCharData;
+static uint8_t                  CVServiceRangeCharData;
+static float                    CVServiceEquilibriumPeriodCharData;
+static float                    CVServiceDatapointCharData[2];  // Potential, current pair.
+
+// Square Wave Voltammetry Service characteristics.
+static float                    SWVServiceStartPotentialCharData;
+static float                    SWVServiceEndPotentialCharData;
+static float                    SWVServiceStepPotentialCharData;
+static float                    SWVServiceAmplitudeCharData;
+static float                    SWVServiceFrequencyCharData;
+static uint8_t                  SWVServiceRangeCharData;
+static float                    SWVServiceEquilibriumPeriodCharData;
+static float                    SWVServiceDatapointCharData[2]; // Potential, difference pair.
+
+// Differential Pulse Voltammetry Service characteristics.
+static float                    DPVServiceStartPotentialCharData;
+static float                    DPVServiceEndPotentialCharData;
+static float                    DPVServiceStepPotentialCharData;
+static float                    DPVServiceAmplitudeCharData;
+static float                    DPVServicePulseWidthCharData;
+static float                    DPVServiceStepPeriodCharData;
+static float                    DPVServiceSamplingWindowCharData;
+static uint8_t                  DPVServiceRangeCharData;
+static float                    DPVServiceEquilibriumPeriodCharData;
+static float                    DPVServiceDatapointCharData[2]; // Potential, difference pair.
+
+// Waveform Program Service characteristics.
+static WaveformProgram_Instruction_t    ProgramServiceInstructionCharData;
+static uint8_t                  ProgramServiceLengthCharData;
+static float                    ProgramServiceSamplingFrequencyCharData;
+static uint16_t                 ProgramServiceDatapointCountCharData;
+static float                    ProgramServiceSamplingWindowCharData;
+static uint8_t                  ProgramServiceRangeCharData;
+static float                    ProgramServiceEquilibriumPeriodCharData;
+static float                    ProgramServiceDatapointCharData;
+
+// Uploaded waveform program. Instructions are appended as they're written.
+static WaveformProgram_Instruction_t    Program[WAVEFORM_PROGRAM_MAX_INSTRUCTIONS];
+static uint8_t                  ProgramLength;
+
+// Device Control Service characteristics.
+static Command_t                DevCtrlServiceCommandPointCharData;
+static CommandResp_t            DevCtrlServiceCommandResponseCharData;
+static DeviceStatus_t           DevCtrlServiceStatusCharData;
+static float                    DevCtrlServiceBatteryLevelCharData;
+
+// Characteristic Database.
+static Characteristic_t CharacteristicDatabase[] = \
+  {
+    // Amperometry Service.
+    // Sampling Frequency Characteristic
+    {
+      AMPEROMETRY_SERVICE_SAMPLING_FREQUENCY_CHAR_ID,
+      (uint8_t *)&AmperometryServiceSamplingFrequencyCharData,
+      sizeof(AmperometryServiceSamplingFrequencyCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Count Characteristic.
+    {
+      AMPEROMETRY_SERVICE_DATAPOINT_COUNT_CHAR_ID,
+      (uint8_t *)&AmperometryServiceDatapointCountCharData,
+      sizeof(AmperometryServiceDatapointCountCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Potential Characteristic.
+    {
+      AMPEROMETRY_SERVICE_POTENTIAL_CHAR_ID,
+      (uint8_t *)&AmperometryServicePotentialCharData,
+      sizeof(AmperometryServicePotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Equilibrium Period Characteristic.
+    {
+      AMPEROMETRY_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID,
+      (uint8_t *)&AmperometryServiceEquilibriumPeriodCharData,
+      sizeof(AmperometryServiceEquilibriumPeriodCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Range Characteristic.
+    {
+      AMPEROMETRY_SERVICE_RANGE_CHAR_ID,
+      (uint8_t *)&AmperometryServiceRangeCharData,
+      sizeof(AmperometryServiceRangeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Characteristic.
+    {
+      AMPEROMETRY_SERVICE_DATAPOINT_CHAR_ID,
+      (uint8_t *)&AmperometryServiceDatapointCharData,
+      sizeof(AmperometryServiceDatapointCharData),
+      (PROPERTY_READABLE)
+    },    
+    // Cyclic Voltammetry Service.
+    // Start Potential Characteristic.
+    {
+      CV_SERVICE_START_POTENTIAL_CHAR_ID,
+      (uint8_t *)&CVServiceStartPotentialCharData,
+      sizeof(CVServiceStartPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Vertex Potential Characteristic.
+    {
+      CV_SERVICE_VERTEX_POTENTIAL_CHAR_ID,
+      (uint8_t *)&CVServiceVertexPotentialCharData,
+      sizeof(CVServiceVertexPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // End Potential Characteristic.
+    {
+      CV_SERVICE_END_POTENTIAL_CHAR_ID,
+      (uint8_t *)&CVServiceEndPotentialCharData,
+      sizeof(CVServiceEndPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Scan Rate Characteristic.
+    {
+      CV_SERVICE_SCAN_RATE_CHAR_ID,
+      (uint8_t *)&CVServiceScanRateCharData,
+      sizeof(CVServiceScanRateCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Step Potential Characteristic.
+    {
+      CV_SERVICE_STEP_POTENTIAL_CHAR_ID,
+      (uint8_t *)&CVServiceStepPotentialCharData,
+      sizeof(CVServiceStepPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Cycle Count Characteristic.
+    {
+      CV_SERVICE_CYCLE_COUNT_CHAR_ID,
+      (uint8_t *)&CVServiceCycleCountCharData,
+      sizeof(CVServiceCycleCountCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Range Characteristic.
+    {
+      CV_SERVICE_RANGE_CHAR_ID,
+      (uint8_t *)&CVServiceRangeCharData,
+      sizeof(CVServiceRangeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Equilibrium Period Characteristic.
+    {
+      CV_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID,
+      (uint8_t *)&CVServiceEquilibriumPeriodCharData,
+      sizeof(CVServiceEquilibriumPeriodCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Characteristic.
+    {
+      CV_SERVICE_DATAPOINT_CHAR_ID,
+      (uint8_t *)CVServiceDatapointCharData,
+      sizeof(CVServiceDatapointCharData),
+      (PROPERTY_READABLE)
+    },
+    
+    // Square Wave Voltammetry Service.
+    // Start Potential Characteristic.
+    {
+      SWV_SERVICE_START_POTENTIAL_CHAR_ID,
+      (uint8_t *)&SWVServiceStartPotentialCharData,
+      sizeof(SWVServiceStartPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // End Potential Characteristic.
+    {
+      SWV_SERVICE_END_POTENTIAL_CHAR_ID,
+      (uint8_t *)&SWVServiceEndPotentialCharData,
+      sizeof(SWVServiceEndPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Step Potential Characteristic.
+    {
+      SWV_SERVICE_STEP_POTENTIAL_CHAR_ID,
+      (uint8_t *)&SWVServiceStepPotentialCharData,
+      sizeof(SWVServiceStepPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Amplitude Characteristic.
+    {
+      SWV_SERVICE_AMPLITUDE_CHAR_ID,
+      (uint8_t *)&SWVServiceAmplitudeCharData,
+      sizeof(SWVServiceAmplitudeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Frequency Characteristic.
+    {
+      SWV_SERVICE_FREQUENCY_CHAR_ID,
+      (uint8_t *)&SWVServiceFrequencyCharData,
+      sizeof(SWVServiceFrequencyCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Range Characteristic.
+    {
+      SWV_SERVICE_RANGE_CHAR_ID,
+      (uint8_t *)&SWVServiceRangeCharData,
+      sizeof(SWVServiceRangeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Equilibrium Period Characteristic.
+    {
+      SWV_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID,
+      (uint8_t *)&SWVServiceEquilibriumPeriodCharData,
+      sizeof(SWVServiceEquilibriumPeriodCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Characteristic.
+    {
+      SWV_SERVICE_DATAPOINT_CHAR_ID,
+      (uint8_t *)SWVServiceDatapointCharData,
+      sizeof(SWVServiceDatapointCharData),
+      (PROPERTY_READABLE)
+    },
+    
+    // Differential Pulse Voltammetry Service.
+    // Start Potential Characteristic.
+    {
+      DPV_SERVICE_START_POTENTIAL_CHAR_ID,
+      (uint8_t *)&DPVServiceStartPotentialCharData,
+      sizeof(DPVServiceStartPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // End Potential Characteristic.
+    {
+      DPV_SERVICE_END_POTENTIAL_CHAR_ID,
+      (uint8_t *)&DPVServiceEndPotentialCharData,
+      sizeof(DPVServiceEndPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Step Potential Characteristic.
+    {
+      DPV_SERVICE_STEP_POTENTIAL_CHAR_ID,
+      (uint8_t *)&DPVServiceStepPotentialCharData,
+      sizeof(DPVServiceStepPotentialCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Amplitude Characteristic.
+    {
+      DPV_SERVICE_AMPLITUDE_CHAR_ID,
+      (uint8_t *)&DPVServiceAmplitudeCharData,
+      sizeof(DPVServiceAmplitudeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Pulse Width Characteristic.
+    {
+      DPV_SERVICE_PULSE_WIDTH_CHAR_ID,
+      (uint8_t *)&DPVServicePulseWidthCharData,
+      sizeof(DPVServicePulseWidthCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Step Period Characteristic.
+    {
+      DPV_SERVICE_STEP_PERIOD_CHAR_ID,
+      (uint8_t *)&DPVServiceStepPeriodCharData,
+      sizeof(DPVServiceStepPeriodCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Sampling Window Characteristic.
+    {
+      DPV_SERVICE_SAMPLING_WINDOW_CHAR_ID,
+      (uint8_t *)&DPVServiceSamplingWindowCharData,
+      sizeof(DPVServiceSamplingWindowCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Range Characteristic.
+    {
+      DPV_SERVICE_RANGE_CHAR_ID,
+      (uint8_t *)&DPVServiceRangeCharData,
+      sizeof(DPVServiceRangeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Equilibrium Period Characteristic.
+    {
+      DPV_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID,
+      (uint8_t *)&DPVServiceEquilibriumPeriodCharData,
+      sizeof(DPVServiceEquilibriumPeriodCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Characteristic.
+    {
+      DPV_SERVICE_DATAPOINT_CHAR_ID,
+      (uint8_t *)DPVServiceDatapointCharData,
+      sizeof(DPVServiceDatapointCharData),
+      (PROPERTY_READABLE)
+    },
+    
+    // Waveform Program Service.
+    // Instruction Characteristic.
+    {
+      PROGRAM_SERVICE_INSTRUCTION_CHAR_ID,
+      (uint8_t *)&ProgramServiceInstructionCharData,
+      sizeof(ProgramServiceInstructionCharData),
+      (PROPERTY_WRITABLE)
+    },
+    // Length Characteristic.
+    {
+      PROGRAM_SERVICE_LENGTH_CHAR_ID,
+      (uint8_t *)&ProgramServiceLengthCharData,
+      sizeof(ProgramServiceLengthCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Sampling Frequency Characteristic.
+    {
+      PROGRAM_SERVICE_SAMPLING_FREQUENCY_CHAR_ID,
+      (uint8_t *)&ProgramServiceSamplingFrequencyCharData,
+      sizeof(ProgramServiceSamplingFrequencyCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Count Characteristic.
+    {
+      PROGRAM_SERVICE_DATAPOINT_COUNT_CHAR_ID,
+      (uint8_t *)&ProgramServiceDatapointCountCharData,
+      sizeof(ProgramServiceDatapointCountCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Sampling Window Characteristic.
+    {
+      PROGRAM_SERVICE_SAMPLING_WINDOW_CHAR_ID,
+      (uint8_t *)&ProgramServiceSamplingWindowCharData,
+      sizeof(ProgramServiceSamplingWindowCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Range Characteristic.
+    {
+      PROGRAM_SERVICE_RANGE_CHAR_ID,
+      (uint8_t *)&ProgramServiceRangeCharData,
+      sizeof(ProgramServiceRangeCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Equilibrium Period Characteristic.
+    {
+      PROGRAM_SERVICE_EQUILIBRIUM_PERIOD_CHAR_ID,
+      (uint8_t *)&ProgramServiceEquilibriumPeriodCharData,
+      sizeof(ProgramServiceEquilibriumPeriodCharData),
+      (PROPERTY_READABLE | PROPERTY_WRITABLE)
+    },
+    // Datapoint Characteristic.
+    {
+      PROGRAM_SERVICE_DATAPOINT_CHAR_ID,
+      (uint8_t *)&ProgramServiceDatapointCharData,
+      sizeof(ProgramServiceDatapointCharData),
+      (PROPERTY_READABLE)
+    },
+    
+    // Device Control Service.
+    // Command Point Characteristic.
+    {
+      DEV_CTRL_SERVICE_COMMAND_POINT_CHAR_ID,
+      (uint8_t *)&DevCtrlServiceCommandPointCharData,
+      sizeof(DevCtrlServiceCommandPointCharData),
+      (PROPERTY_WRITABLE)
+    },
+    // Command Response Characteristic.
+    {
+      DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID,
+      (uint8_t *)&DevCtrlServiceCommandResponseCharData,
+      sizeof(DevCtrlServiceCommandResponseCharData),
+      (PROPERTY_READABLE)
+    },
+    // Status Characteristic.
+    {
+      DEV_CTRL_SERVICE_STATUS_CHAR_ID,
+      (uint8_t *)&DevCtrlServiceStatusCharData,
+      sizeof(DevCtrlServiceStatusCharData),
+      (PROPERTY_READABLE)
+    },
+    // Battery Level Characteristic.
+    {
+      DEV_CTRL_SERVICE_BATTERY_LEVEL_CHAR_ID,
+      (uint8_t *)&DevCtrlServiceBatteryLevelCharData,
+      sizeof(DevCtrlServiceBatteryLevelCharData),
+      (PROPERTY_READABLE)
+    }
+  };
+
+/* Exported function implementations -----------------------------------------*/
+void DeviceManager_Setup(void)
+{
+  // Check the state compability.
+  if (State == DEVICE_MANAGER_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Device manager module Setup function called when not uninitialized.");
+  }
+  
+  // Initialize eeprom emulator.
+  EepromEmulator_Init();
+  
+  // Make the setup of the characteristic server.
+  CharacteristicServer_SetupParams_t params;
+  
+  params.numOfChars = sizeof(CharacteristicDatabase) / sizeof(CharacteristicDatabase[0]);
+  params.pCharTable = CharacteristicDatabase;
+  params.connectionStateChangedDelegate = connectionStateChangedEventHandler;
+  params.writeDelegate = writeEventHandler;
+  
+  CharacteristicServer_Setup(&params);
+  
+  State = DEVICE_MANAGER_STATE_READY;
+}
+
+// TODO: Implementation.
+void DeviceManager_Start(void)
+{
+  // Check the state compability.
+  if (State != DEVICE_MANAGER_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Device manager module start function called when not ready.");
+  }
+  
+  // Start characteristic server.
+  CharacteristicServer_Start();
+  
+  State = DEVICE_MANAGER_STATE_OPERATING;
+  DeviceStatus = DEVICE_STATUS_IDLE;
+}
+
+// TODO: Implementation.
+void DeviceManager_Execute(void)
+{
+  // Check the state compability.
+  if (State != DEVICE_MANAGER_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Device manager module Execute function called when not operating.");
+  }
+  
+  // Execute submodules.
+  CharacteristicServer_Execute();
+  
+  // Run operating measurement module.
+  if (DeviceStatus == DEVICE_STATUS_AMPEROMETRY_MEASUREMENT)
+  {
+    Amperometry_Execute();
+  } 
+  else if (DeviceStatus == DEVICE_STATUS_CYCLIC_VOLTAMMETRY_MEASUREMENT)
+  {
+    CyclicVoltammetry_Execute();
+  }
+  else if (DeviceStatus == DEVICE_STATUS_SQUARE_WAVE_VOLTAMMETRY_MEASUREMENT)
+  {
+    SquareWaveVoltammetry_Execute();
+  }
+  else if (DeviceStatus == DEVICE_STATUS_DIFFERENTIAL_PULSE_VOLTAMMETRY_MEASUREMENT)
+  {
+    DifferentialPulseVoltammetry_Execute();
+  }
+  else if (DeviceStatus == DEVICE_STATUS_PROGRAMMED_VOLTAMMETRY_MEASUREMENT)
+  {
+    ProgrammedVoltammetry_Execute();
+  }
+}
+
+// TODO: Implementation.
+void DeviceManager_Stop(void)
+{
+  // Check the state compability.
+  if (State != DEVICE_MANAGER_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Device manager server module Stop function called when not operating.");
+  }
+  
+  State = DEVICE_MANAGER_STATE_READY;
+}
+
+/* Private function implementations ------------------------------------------*/
+static void writeEventHandler(uint16_t charId)
+{
+  // Take action according to written characteristic.
+  switch(charId)
+  {
+    // If command point is written, set related event.
+  case DEV_CTRL_SERVICE_COMMAND_POINT_CHAR_ID:
+    {
+      CommandResp_t resp;
+      
+      // Take action according to command.
+      switch (DevCtrlServiceCommandPointCharData)
+      {
+      case COMMAND_START_AMPEROMETRY:
+        {
+          if (DeviceStatus != DEVICE_STATUS_IDLE)
+          {
+            resp = COMMAND_RESP_STATE_NOT_COMPATIBLE;
+          }
+          else if (checkAmperometryParameters())
+          {
+            startAmperometry();
+            DeviceStatus = DEVICE_STATUS_AMPEROMETRY_MEASUREMENT;
+            resp = COMMAND_RESP_SUCCESS;
+          }
+          else
+          {
+            resp = COMMAND_RESP_INVALID_SETUP_PARAMETER;
+          }
+        }
+        break;
+        
+      case COMMAND_START_CYCLIC_VOLTAMMETRY:
+        {
+          if (DeviceStatus != DEVICE_STATUS_IDLE)
+          {
+            resp = COMMAND_RESP_STATE_NOT_COMPATIBLE;
+          }
+          else if (checkCyclicVoltammetryParameters())
+          {
+            startCyclicVoltammetry();
+            DeviceStatus = DEVICE_STATUS_CYCLIC_VOLTAMMETRY_MEASUREMENT;
+            resp = COMMAND_RESP_SUCCESS;
+          }
+          else
+          {
+            resp = COMMAND_RESP_INVALID_SETUP_PARAMETER;
+          }
+        }
+        break;
+        
+      case COMMAND_START_SQUARE_WAVE_VOLTAMMETRY:
+        {
+          if (DeviceStatus != DEVICE_STATUS_IDLE)
+          {
+            resp = COMMAND_RESP_STATE_NOT_COMPATIBLE;
+          }
+          else if (checkSquareWaveVoltammetryParameters())
+          {
+            startSquareWaveVoltammetry();
+            DeviceStatus = DEVICE_STATUS_SQUARE_WAVE_VOLTAMMETRY_MEASUREMENT;
+            resp = COMMAND_RESP_SUCCESS;
+          }
+          else
+          {
+            resp = COMMAND_RESP_INVALID_SETUP_PARAMETER;
+          }
+        }
+        break;
+        
+      case COMMAND_START_DIFFERENTIAL_PULSE_VOLTAMMETRY:
+        {
+          if (DeviceStatus != DEVICE_STATUS_IDLE)
+          {
+            resp = COMMAND_RESP_STATE_NOT_COMPATIBLE;
+          }
+          else if (checkDifferentialPulseVoltammetryParameters())
+          {
+            startDifferentialPulseVoltammetry();
+            DeviceStatus = DEVICE_STATUS_DIFFERENTIAL_PULSE_VOLTAMMETRY_MEASUREMENT;
+            resp = COMMAND_RESP_SUCCESS;
+          }
+          else
+          {
+            resp = COMMAND_RESP_INVALID_SETUP_PARAMETER;
+          }
+        }
+        break;
+        
+      case COMMAND_START_PROGRAMMED_VOLTAMMETRY:
+        {
+          if (DeviceStatus != DEVICE_STATUS_IDLE)
+          {
+            resp = COMMAND_RESP_STATE_NOT_COMPATIBLE;
+          }
+          else if (checkProgrammedVoltammetryParameters())
+          {
+            startProgrammedVoltammetry();
+            DeviceStatus = DEVICE_STATUS_PROGRAMMED_VOLTAMMETRY_MEASUREMENT;
+            resp = COMMAND_RESP_SUCCESS;
+          }
+          else
+          {
+            resp = COMMAND_RESP_INVALID_SETUP_PARAMETER;
+          }
+        }
+        break;
+        
+      case COMMAND_STOP_MEASUREMENT:
+        {
+          // If doing amperometry measurement, stop amperometry module.
+          if (DeviceStatus == DEVICE_STATUS_AMPEROMETRY_MEASUREMENT)
+          {
+            Amperometry_Stop();
+            // CharacteristicServer_ClearNotifications();
+            DeviceStatus = DEVICE_STATUS_IDLE;
+          }
+          else if (DeviceStatus == DEVICE_STATUS_CYCLIC_VOLTAMMETRY_MEASUREMENT)
+          {
+            CyclicVoltammetry_Stop();
+            DeviceStatus = DEVICE_STATUS_IDLE;
+          }
+          else if (DeviceStatus == DEVICE_STATUS_SQUARE_WAVE_VOLTAMMETRY_MEASUREMENT)
+          {
+            SquareWaveVoltammetry_Stop();
+            DeviceStatus = DEVICE_STATUS_IDLE;
+          }
+          else if (DeviceStatus == DEVICE_STATUS_DIFFERENTIAL_PULSE_VOLTAMMETRY_MEASUREMENT)
+          {
+            DifferentialPulseVoltammetry_Stop();
+            DeviceStatus = DEVICE_STATUS_IDLE;
+          }
+          else if (DeviceStatus == DEVICE_STATUS_PROGRAMMED_VOLTAMMETRY_MEASUREMENT)
+          {
+            ProgrammedVoltammetry_Stop();
+            DeviceStatus = DEVICE_STATUS_IDLE;
+          }
+          
+          resp = COMMAND_RESP_SUCCESS;
+        }
+        break;
+        
+      default:
+        resp = COMMAND_RESP_INVALID_COMMAND;
+        break;
+      }
+      
+      // Update command response characteristic.
+      CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID, 
+                                                (uint8_t *)&resp, sizeof(resp));
+      
+      // Update device status characteristic.
+      CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
+                                                (uint8_t *)&DeviceStatus,
+                                                sizeof(DeviceStatus));
+    }
+    break;
+    
+    // Instruction is appended to the program, if there is room.
+  case PROGRAM_SERVICE_INSTRUCTION_CHAR_ID:
+    {
+      if (ProgramLength < WAVEFORM_PROGRAM_MAX_INSTRUCTIONS)
+      {
+        Program[ProgramLength++] = ProgramServiceInstructionCharData;
+      }
+      
+      CharacteristicServer_UpdateCharacteristic(PROGRAM_SERVICE_LENGTH_CHAR_ID,
+                                                (uint8_t *)&ProgramLength,
+                                                sizeof(ProgramLength));
+    }
+    break;
+    
+    // Writing the length truncates the program, zero clears it.
+  case PROGRAM_SERVICE_LENGTH_CHAR_ID:
+    {
+      if (ProgramServiceLengthCharData < ProgramLength)
+      {
+        ProgramLength = ProgramServiceLengthCharData;
+      }
+      
+      CharacteristicServer_UpdateCharacteristic(PROGRAM_SERVICE_LENGTH_CHAR_ID,
+                                                (uint8_t *)&ProgramLength,
+                                                sizeof(ProgramLength));
+    }
+    break;
+  }
+}
+
+// TODO: Amperometry module state is assumed as ready or unitialized. This may
+// lead some problems. Need to be careful about this.
+static void startAmperometry(void)
+{
+  // Set params.
+  Amperometry_SetupParams_t params;
+    
+  params.datapointCount = AmperometryServiceDatapointCountCharData;
+  params.equilibriumPeriod = AmperometryServiceEquilibriumPeriodCharData;
+  params.potential = AmperometryServicePotentialCharData;
+  params.samplingFrequency = AmperometryServiceSamplingFrequencyCharData;
+  params.feedbackPath = getFBPath((Range_t)AmperometryServiceRangeCharData);
+  params.maxRelSamplingFreqErr = 0.001;
+  params.currentGainCorrection = 1.0;
+  params.currentOffsetCorrection = 1.0;
+  params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  params.newDatapointDelegate = amperometryNewDatapointEventHandler;
+    
+  Amperometry_Setup(&params);
+    
+  // Set calibration relay state on.
+  Board_SetCalibrationRelayState(BOARD_CALIBRATION_RELAY_STATE_OFF);
+  
+  // Start amperometry.
+  Amperometry_Start();
+}
+  
+static Bool_t checkAmperometryParameters(void)
+{
+  // Check parameters.
+  if (\
+    AMPEROMETRY_SERVICE_IS_VALID_SAMPLING_FREQUENCY(AmperometryServiceSamplingFrequencyCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_DATAPOINT_COUNT(AmperometryServiceDatapointCountCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_POTENTIAL(AmperometryServicePotentialCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_RANGE(AmperometryServiceRangeCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(AmperometryServiceEquilibriumPeriodCharData)\
+      )
+  {
+    return TRUE;
+  }
+  else
+  {
+    return FALSE;
+  }
+}
+
+static void startCyclicVoltammetry(void)
+{
+  // Set params.
+  CyclicVoltammetry_SetupParams_t params;
+    
+  params.startPotential = CVServiceStartPotentialCharData;
+  params.vertexPotential = CVServiceVertexPotentialCharData;
+  params.endPotential = CVServiceEndPotentialCharData;
+  params.scanRate = CVServiceScanRateCharData;
+  params.stepPotential = CVServiceStepPotentialCharData;
+  params.cycleCount = CVServiceCycleCountCharData;
+  params.equilibriumPeriod = CVServiceEquilibriumPeriodCharData;
+  params.feedbackPath = getFBPath((Range_t)CVServiceRangeCharData);
+  params.maxRelSamplingFreqErr = 0.001;
+  params.currentGainCorrection = 1.0;
+  params.currentOffsetCorrection = 0.0;
+  params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  params.measurementAbortedDelegate = measurementAbortedEventHandler;
+  params.newDatapointDelegate = cvNewDatapointEventHandler;
+    
+  CyclicVoltammetry_Setup(&params);
+    
+  Board_SetCalibrationRelayState(BOARD_CALIBRATION_RELAY_STATE_OFF);
+  
+  CyclicVoltammetry_Start();
+}
+
+static Bool_t checkCyclicVoltammetryParameters(void)
+{
+  float sweep_potential;
+  
+  if (!(\
+    CV_SERVICE_IS_VALID_POTENTIAL(CVServiceStartPotentialCharData) && \
+    CV_SERVICE_IS_VALID_POTENTIAL(CVServiceVertexPotentialCharData) && \
+    CV_SERVICE_IS_VALID_POTENTIAL(CVServiceEndPotentialCharData) && \
+    CV_SERVICE_IS_VALID_STEP(CVServiceStepPotentialCharData, CVServiceVertexPotentialCharData, \
+                             CVServiceEndPotentialCharData) && \
+    CV_SERVICE_IS_VALID_CYCLE_COUNT(CVServiceCycleCountCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_RANGE(CVServiceRangeCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(CVServiceEquilibriumPeriodCharData)\
+      ))
+  {
+    return FALSE;
+  }
+  
+  // Scan rate is checked through the sampling frequency it results in.
+  if (!CV_SERVICE_IS_VALID_SAMPLING_FREQUENCY(CVServiceScanRateCharData / \
+                                              CVServiceStepPotentialCharData))
+  {
+    return FALSE;
+  }
+  
+  // Whole scan should fit into the datapoint counter.
+  sweep_potential = fabs(CVServiceVertexPotentialCharData - CVServiceStartPotentialCharData) + \
+    (2.0f * CVServiceCycleCountCharData - 1.0f) * \
+      fabs(CVServiceEndPotentialCharData - CVServiceVertexPotentialCharData);
+  
+  return ((sweep_potential / CVServiceStepPotentialCharData) < MAX_UINT16) ? TRUE : FALSE;
+}
+
+static void startSquareWaveVoltammetry(void)
+{
+  // Set params.
+  SquareWaveVoltammetry_SetupParams_t params;
+    
+  params.startPotential = SWVServiceStartPotentialCharData;
+  params.endPotential = SWVServiceEndPotentialCharData;
+  params.stepPotential = SWVServiceStepPotentialCharData;
+  params.amplitude = SWVServiceAmplitudeCharData;
+  params.frequency = SWVServiceFrequencyCharData;
+  params.samplingWindow = 0.25f;      // Last quarter of the pulse, charging current decayed.
+  params.equilibriumPeriod = SWVServiceEquilibriumPeriodCharData;
+  params.feedbackPath = getFBPath((Range_t)SWVServiceRangeCharData);
+  params.maxRelSamplingFreqErr = 0.001;
+  params.currentGainCorrection = 1.0;
+  params.currentOffsetCorrection = 0.0;
+  params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  params.measurementAbortedDelegate = measurementAbortedEventHandler;
+  params.newDatapointDelegate = swvNewDatapointEventHandler;
+    
+  SquareWaveVoltammetry_Setup(&params);
+    
+  Board_SetCalibrationRelayState(BOARD_CALIBRATION_RELAY_STATE_OFF);
+  
+  SquareWaveVoltammetry_Start();
+}
+
+static Bool_t checkSquareWaveVoltammetryParameters(void)
+{
+  float step_count;
+  
+  if (!(\
+    CV_SERVICE_IS_VALID_POTENTIAL(SWVServiceStartPotentialCharData) && \
+    CV_SERVICE_IS_VALID_POTENTIAL(SWVServiceEndPotentialCharData) && \
+    SWV_SERVICE_IS_VALID_STEP(SWVServiceStepPotentialCharData) && \
+    SWV_SERVICE_IS_VALID_AMPLITUDE(SWVServiceAmplitudeCharData) && \
+    SWV_SERVICE_IS_VALID_FREQUENCY(SWVServiceFrequencyCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_RANGE(SWVServiceRangeCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(SWVServiceEquilibriumPeriodCharData)\
+      ))
+  {
+    return FALSE;
+  }
+  
+  // Pulses around the scan should be covered by the signal DAC.
+  if (!SquareWaveVoltammetry_IsPotentialRangeValid(SWVServiceStartPotentialCharData,
+                                                   SWVServiceEndPotentialCharData,
+                                                   SWVServiceAmplitudeCharData))
+  {
+    return FALSE;
+  }
+  
+  // Forward and reverse currents of every step should fit into the datapoint counter.
+  step_count = fabs(SWVServiceEndPotentialCharData - SWVServiceStartPotentialCharData) / \
+    SWVServiceStepPotentialCharData + 1.0f;
+  
+  return ((2.0f * step_count) < MAX_UINT16) ? TRUE : FALSE;
+}
+
+static void startDifferentialPulseVoltammetry(void)
+{
+  // Set params.
+  DifferentialPulseVoltammetry_SetupParams_t params;
+    
+  params.startPotential = DPVServiceStartPotentialCharData;
+  params.endPotential = DPVServiceEndPotentialCharData;
+  params.stepPotential = DPVServiceStepPotentialCharData;
+  params.amplitude = DPVServiceAmplitudeCharData;
+  params.pulseWidth = DPVServicePulseWidthCharData;
+  params.stepPeriod = DPVServiceStepPeriodCharData;
+  params.samplingWindow = DPVServiceSamplingWindowCharData;
+  params.equilibriumPeriod = DPVServiceEquilibriumPeriodCharData;
+  params.feedbackPath = getFBPath((Range_t)DPVServiceRangeCharData);
+  params.maxRelSamplingFreqErr = 0.001;
+  params.currentGainCorrection = 1.0;
+  params.currentOffsetCorrection = 0.0;
+  params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  params.measurementAbortedDelegate = measurementAbortedEventHandler;
+  params.newDatapointDelegate = dpvNewDatapointEventHandler;
+    
+  DifferentialPulseVoltammetry_Setup(&params);
+    
+  Board_SetCalibrationRelayState(BOARD_CALIBRATION_RELAY_STATE_OFF);
+  
+  DifferentialPulseVoltammetry_Start();
+}
+
+static Bool_t checkDifferentialPulseVoltammetryParameters(void)
+{
+  float step_count;
+  
+  if (!(\
+    CV_SERVICE_IS_VALID_POTENTIAL(DPVServiceStartPotentialCharData) && \
+    CV_SERVICE_IS_VALID_POTENTIAL(DPVServiceEndPotentialCharData) && \
+    SWV_SERVICE_IS_VALID_STEP(DPVServiceStepPotentialCharData) && \
+    SWV_SERVICE_IS_VALID_AMPLITUDE(DPVServiceAmplitudeCharData) && \
+    DPV_SERVICE_IS_VALID_STEP_PERIOD(DPVServiceStepPeriodCharData) && \
+    DPV_SERVICE_IS_VALID_TIMING(DPVServiceStepPeriodCharData, DPVServicePulseWidthCharData, \
+                                DPVServiceSamplingWindowCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_RANGE(DPVServiceRangeCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(DPVServiceEquilibriumPeriodCharData)\
+      ))
+  {
+    return FALSE;
+  }
+  
+  // Pulses on the scan should be covered by the signal DAC.
+  if (!DifferentialPulseVoltammetry_IsPotentialRangeValid(DPVServiceStartPotentialCharData,
+                                                          DPVServiceEndPotentialCharData,
+                                                          DPVServiceAmplitudeCharData))
+  {
+    return FALSE;
+  }
+  
+  // Base and pulse currents of every step should fit into the datapoint counter.
+  step_count = fabs(DPVServiceEndPotentialCharData - DPVServiceStartPotentialCharData) / \
+    DPVServiceStepPotentialCharData + 1.0f;
+  
+  return ((2.0f * step_count) < MAX_UINT16) ? TRUE : FALSE;
+}
+
+static void startProgrammedVoltammetry(void)
+{
+  // Set params.
+  ProgrammedVoltammetry_SetupParams_t params;
+    
+  params.pProgram = Program;
+  params.instructionCount = ProgramLength;
+  params.datapointCount = ProgramServiceDatapointCountCharData;
+  params.samplingFrequency = ProgramServiceSamplingFrequencyCharData;
+  params.samplingWindow = ProgramServiceSamplingWindowCharData;
+  params.equilibriumPeriod = ProgramServiceEquilibriumPeriodCharData;
+  params.feedbackPath = getFBPath((Range_t)ProgramServiceRangeCharData);
+  params.maxRelSamplingFreqErr = 0.001;
+  params.currentGainCorrection = 1.0;
+  params.currentOffsetCorrection = 0.0;
+  params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  params.measurementAbortedDelegate = measurementAbortedEventHandler;
+  params.newDatapointDelegate = programNewDatapointEventHandler;
+    
+  ProgrammedVoltammetry_Setup(&params);
+    
+  Board_SetCalibrationRelayState(BOARD_CALIBRATION_RELAY_STATE_OFF);
+  
+  ProgrammedVoltammetry_Start();
+}
+
+static Bool_t checkProgrammedVoltammetryParameters(void)
+{
+  // Check parameters.
+  if (\
+    WaveformProgram_IsValid(Program, ProgramLength) && \
+    PROGRAM_SERVICE_IS_VALID_SAMPLING_FREQUENCY(ProgramServiceSamplingFrequencyCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_DATAPOINT_COUNT(ProgramServiceDatapointCountCharData) && \
+    PROGRAM_SERVICE_IS_VALID_SAMPLING_WINDOW(ProgramServiceSamplingWindowCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_RANGE(ProgramServiceRangeCharData) && \
+    AMPEROMETRY_SERVICE_IS_VALID_EQUILIBRIUM_PERIOD(ProgramServiceEquilibriumPeriodCharData)\
+      )
+  {
+    return TRUE;
+  }
+  else
+  {
+    return FALSE;
+  }
+}
+
+// TODO: NOTHING.
+static Board_TIAFBPath_t getFBPath(Range_t range)
+{
+  Board_TIAFBPath_t retval;
+  
+  switch (range)
+  {
+  case RANGE_1MA:
+    retval = BOARD_TIA_FB_PATH_0;
+    break;
+    
+  case RANGE_100UA:
+    retval = BOARD_TIA_FB_PATH_1;
+    break;
+    
+  case RANGE_10UA:
+    retval = BOARD_TIA_FB_PATH_2;
+    break;
+    
+  case RANGE_1UA:
+    retval = BOARD_TIA_FB_PATH_3;
+    break;
+    
+  case RANGE_100NA:
+    retval = BOARD_TIA_FB_PATH_4;
+    break;
+  }
+  
+  return retval;
+}
+
+// TODO: NOTHING.
+static void amperometryNewDatapointEventHandler(float datapoint)
+{
+  // Update characteristic. This will send notification to the client.
+  CharacteristicServer_UpdateCharacteristic(AMPEROMETRY_SERVICE_DATAPOINT_CHAR_ID, 
+                                            (uint8_t *)&datapoint, 
+                                            sizeof(datapoint));
+}
+
+static void cvNewDatapointEventHandler(float potential, float current)
+{
+  float datapoint[2];
+  
+  datapoint[0] = potential;
+  datapoint[1] = current;
+  
+  // Update characteristic. This will send notification to the client.
+  CharacteristicServer_UpdateCharacteristic(CV_SERVICE_DATAPOINT_CHAR_ID, 
+                                            (uint8_t *)datapoint, 
+                                            sizeof(datapoint));
+}
+
+// Only the difference current is streamed, it's what the square wave voltammogram is.
+static void swvNewDatapointEventHandler(float potential, float forward,
+                                        float reverse, float difference)
+{
+  float datapoint[2];
+  
+  datapoint[0] = potential;
+  datapoint[1] = difference;
+  
+  // Update characteristic. This will send notification to the client.
+  CharacteristicServer_UpdateCharacteristic(SWV_SERVICE_DATAPOINT_CHAR_ID, 
+                                            (uint8_t *)datapoint, 
+                                            sizeof(datapoint));
+}
+
+// Only the difference current is streamed, like the square wave voltammetry.
+static void dpvNewDatapointEventHandler(float potential, float base,
+                                        float pulse, float difference)
+{
+  float datapoint[2];
+  
+  datapoint[0] = potential;
+  datapoint[1] = difference;
+  
+  // Update characteristic. This will send notification to the client.
+  CharacteristicServer_UpdateCharacteristic(DPV_SERVICE_DATAPOINT_CHAR_ID, 
+                                            (uint8_t *)datapoint, 
+                                            sizeof(datapoint));
+}
+
+static void programNewDatapointEventHandler(float datapoint)
+{
+  // Update characteristic. This will send notification to the client.
+  CharacteristicServer_UpdateCharacteristic(PROGRAM_SERVICE_DATAPOINT_CHAR_ID, 
+                                            (uint8_t *)&datapoint, 
+                                            sizeof(datapoint));
+}
+
+// TODO: Implementation. Handles both amperometry and eis measurement completed events.
+static void measurementCompletedEventHandler(void)
+{
+  // Update device status.
+  DeviceStatus = DEVICE_STATUS_IDLE;
+  
+  // Update related characteristic.
+  CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
+                                            (uint8_t *)&DeviceStatus,
+                                            sizeof(DeviceStatus));
+}
+
+// Handles voltammetry measurement aborted events.
+static void measurementAbortedEventHandler(void)
+{
+  CommandResp_t resp = COMMAND_RESP_MEASUREMENT_ABORTED;
+  
+  // Update device status.
+  DeviceStatus = DEVICE_STATUS_IDLE;
+  
+  // Let the client know that the measurement didn't complete.
+  CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_COMMAND_RESPONSE_CHAR_ID, 
+                                            (uint8_t *)&resp, sizeof(resp));
+  
+  // Update related characteristic.
+  CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
+                                            (uint8_t *)&DeviceStatus,
+                                            sizeof(DeviceStatus));
+}
+
+// TODO: Timeout occurred. This is a problem. Stop the device(if it's operating).
+// Stop every operation. 
+static void connectionStateChangedEventHandler(Bool_t isConnected)
+{
+  if (isConnected)
+  {
+
+  }
+  else
+  {
+    // If doing amperometry measurement, stop amperometry module.
+    if (DeviceStatus == DEVICE_STATUS_AMPEROMETRY_MEASUREMENT)
+    {
+      Amperometry_Stop();
+      DeviceStatus = DEVICE_STATUS_IDLE;
+    }
+    else if (DeviceStatus == DEVICE_STATUS_CYCLIC_VOLTAMMETRY_MEASUREMENT)
+    {
+      CyclicVoltammetry_Stop();
+      DeviceStatus = DEVICE_STATUS_IDLE;
+    }
+    else if (DeviceStatus == DEVICE_STATUS_SQUARE_WAVE_VOLTAMMETRY_MEASUREMENT)
+    {
+      SquareWaveVoltammetry_Stop();
+      DeviceStatus = DEVICE_STATUS_IDLE;
+    }
+    else if (DeviceStatus == DEVICE_STATUS_DIFFERENTIAL_PULSE_VOLTAMMETRY_MEASUREMENT)
+    {
+      DifferentialPulseVoltammetry_Stop();
+      DeviceStatus = DEVICE_STATUS_IDLE;
+    }
+    else if (DeviceStatus == DEVICE_STATUS_PROGRAMMED_VOLTAMMETRY_MEASUREMENT)
+    {
+      ProgrammedVoltammetry_Stop();
+      DeviceStatus = DEVICE_STATUS_IDLE;
+    }
+    
+    // Update characteristic(it won't be notified since the device is disconnected).
+    CharacteristicServer_UpdateCharacteristic(DEV_CTRL_SERVICE_STATUS_CHAR_ID,
+                                              (uint8_t *)&DeviceStatus,
+                                              sizeof(DeviceStatus));
+  }
 }
\ No newline at end of file
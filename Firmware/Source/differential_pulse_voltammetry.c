@@ -0,0 +1,315 @@
+/**
+  * @author     Onur Efe
+  */
+
+#include "generic.h"
+#include "differential_pulse_voltammetry.h"
+#include "voltammetry_core.h"
+#include "middlewares.h"
+
+/* Private function prototypes.-----------------------------------------------*/
+static uint16_t generatorFunctionImplementation(int32_t tickCounter);
+static void     measurementCompletedEventHandler(void);
+static void     newDatapointEventHandler(float datapoint, uint8_t edgeIndex);
+
+/* Private variables.---------------------------------------------------------*/
+// During initialization. Staircase holds the analog configuration.
+static VoltammetryCore_Staircase_t                      Staircase;
+
+// Waveform generator. Codes are in Q16.16 format. Pulse is at the end of each step.
+static uint32_t                                         StepTicks;
+static uint32_t                                         PulseStartTick;
+
+// For datapoint process;
+static double                                           ADC1LSBCurrent;
+static double                                           CurrentGainCorrection;
+static double                                           CurrentOffsetCorrection;
+
+// New datapoint delegate.
+static DifferentialPulseVoltammetry_NewDatapointDelegate_t              NewDatapointDelegate;
+
+// Measurement callback function pointer.
+static DifferentialPulseVoltammetry_MeasurementCompletedDelegate_t      MeasurementCompletedDelegate;
+static DifferentialPulseVoltammetry_MeasurementAbortedDelegate_t        MeasurementAbortedDelegate;
+
+// State.
+static DifferentialPulseVoltammetry_State_t             State = DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_UNINIT;
+
+/* Public function implementations -------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  *             Core's downsampling period is the step. Sampling pattern has an edge
+  *             at the start of the pulse and another at the end of it.
+  *
+  * @Param      pSetupParams-> Pointer to data structure which holds setup
+  *             parameters.
+  */
+void DifferentialPulseVoltammetry_Setup(DifferentialPulseVoltammetry_SetupParams_t *pSetupParams)
+{
+  float tick_period;
+  uint32_t pulse_ticks;
+  uint32_t window_ticks;
+  VoltammetryCore_SamplingPattern_t pattern;
+  VoltammetryCore_SetupParams_t vcore_setup_params;
+
+  /* Check state. */
+  if (State == DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Differential pulse voltammetry module setup function called when the module is operating.\n");
+  }
+
+  if ((pSetupParams->stepPotential <= 0.0f) || (pSetupParams->stepPeriod <= 0.0f) || \
+      (pSetupParams->pulseWidth <= 0.0f) || (pSetupParams->samplingWindow <= 0.0f))
+  {
+    ExceptionHandler_ThrowException(\
+      "Differential pulse voltammetry step, timing and sampling window should be positive.\n");
+  }
+
+  // Steps include both of the start and the end potentials. Pulse is in the scan
+  // direction.
+  VoltammetryCore_PlanStaircase(&Staircase, pSetupParams->startPotential,
+                                pSetupParams->endPotential, pSetupParams->stepPotential,
+                                pSetupParams->amplitude, VOLTAMMETRY_CORE_PULSES_FORWARD);
+
+  // Setup of voltammetry core. Base and pulse currents are two datapoints.
+  vcore_setup_params.datapointCount = (uint16_t)(2U * Staircase.stepCount);
+  vcore_setup_params.equilibriumPeriod = pSetupParams->equilibriumPeriod;
+  vcore_setup_params.generatorFunctionInterface = generatorFunctionImplementation;
+  vcore_setup_params.waveform.type = VOLTAMMETRY_CORE_WAVEFORM_CUSTOM;
+  vcore_setup_params.maxRelSamplingFreqErr = pSetupParams->maxRelSamplingFreqErr;
+  vcore_setup_params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  vcore_setup_params.newDatapointDelegate = newDatapointEventHandler;
+  vcore_setup_params.samplingFrequency = 1.0f / pSetupParams->stepPeriod;
+  vcore_setup_params.samplingWindow = 0.0f;
+  VoltammetryCore_Setup(&vcore_setup_params, &tick_period);
+
+  // Windows are gated in ticks; both of them should fit into their part of the step.
+  // Pulse and window are rounded separately, so a timing which fits in seconds may
+  // overflow by a tick. They are clamped into the step then.
+  StepTicks = VoltammetryCore_GetDownsamplingNumber();
+  pulse_ticks = (uint32_t)((pSetupParams->pulseWidth / tick_period) + 0.5f);
+  window_ticks = (uint32_t)((pSetupParams->samplingWindow / tick_period) + 0.5f);
+
+  if (StepTicks < 2)
+  {
+    ExceptionHandler_ThrowException(\
+      "Differential pulse voltammetry step is too short for the windows.\n");
+  }
+
+  if (window_ticks == 0)
+  {
+    window_ticks = 1;
+  }
+  else if ((2 * window_ticks) > StepTicks)
+  {
+    window_ticks = StepTicks / 2;
+  }
+
+  if (pulse_ticks < window_ticks)
+  {
+    pulse_ticks = window_ticks;
+  }
+  else if ((pulse_ticks + window_ticks) > StepTicks)
+  {
+    pulse_ticks = StepTicks - window_ticks;
+  }
+
+  PulseStartTick = StepTicks - pulse_ticks;
+
+  pattern.periodTicks = StepTicks;
+  pattern.edgeCount = 2;
+  pattern.edgeTicks[0] = PulseStartTick;
+  pattern.edgeTicks[1] = StepTicks;
+  pattern.windowTicks[0] = window_ticks;
+  pattern.windowTicks[1] = window_ticks;
+  VoltammetryCore_SetSamplingPattern(&pattern);
+
+  // Save feedback path.
+  Staircase.analogConfig.fbPath = pSetupParams->feedbackPath;
+
+  // Save correction values.
+  CurrentGainCorrection = pSetupParams->currentGainCorrection;
+  CurrentOffsetCorrection = pSetupParams->currentOffsetCorrection;
+
+  // Calculate ADC 1LSB current.
+  ADC1LSBCurrent = Board_GetADC1LSBCurrent(Staircase.analogConfig.fbPath);
+
+  // Set callback function pointer.
+  MeasurementCompletedDelegate = pSetupParams->measurementCompletedDelegate;
+  MeasurementAbortedDelegate = pSetupParams->measurementAbortedDelegate;
+  NewDatapointDelegate = pSetupParams->newDatapointDelegate;
+
+  State = DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_READY;
+}
+
+/**
+  * @Brief      Starts differential pulse voltammetry.
+  */
+void DifferentialPulseVoltammetry_Start(void)
+{
+  // Guard for improper calls.
+  if (State != DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Differential pulse voltammetry module Start function called when the module isn't ready.\n");
+  }
+
+  // Pairing starts from the first step.
+  Staircase.stepIndex = 0;
+
+  // Turn on analog circuitry, signal DAC starts at the start potential.
+  VoltammetryCore_TurnOnAnalog(&Staircase.analogConfig, generatorFunctionImplementation(-1));
+
+  // Start voltammetry core.
+  VoltammetryCore_Start();
+
+  State = DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_OPERATING;
+}
+
+/**
+  * @Brief      Differential pulse voltammetry task executer and event processor.
+  */
+void DifferentialPulseVoltammetry_Execute(void)
+{
+  // If not operating, return.
+  if (State != DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_OPERATING)
+  {
+    return;
+  }
+
+  // Run subthreads.
+  VoltammetryCore_Execute();
+
+  // Datapoints were lost if the core overran, abort the measurement.
+  if ((State == DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_OPERATING) && VoltammetryCore_IsOverrun())
+  {
+    DifferentialPulseVoltammetry_Stop();
+    
+    if (MeasurementAbortedDelegate != NULL)
+    {
+      MeasurementAbortedDelegate();
+    }
+  }
+}
+
+/***
+  * @Brief      Stops differential pulse voltammetry measurement.
+  */
+void DifferentialPulseVoltammetry_Stop(void)
+{
+  // Guard for improper calls.
+  if (State != DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Differential pulse voltammetry module Stop function called when the module isn't operating.\n");
+  }
+
+  // Stop submodules.
+  VoltammetryCore_Stop();
+
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+
+  State = DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+DifferentialPulseVoltammetry_State_t DifferentialPulseVoltammetry_GetState(void)
+{
+  return State;
+}
+
+/***
+  * @Brief      Checks whether the DACs cover the scan with the pulses on it.
+  *
+  * @Param      startPotential->Start potential of the base.
+  * @Param      endPotential->End potential of the base.
+  * @Param      amplitude->Pulse height.
+  *
+  * @Return     TRUE if the scan is covered, FALSE otherwise.
+  */
+Bool_t DifferentialPulseVoltammetry_IsPotentialRangeValid(float startPotential,
+                                                          float endPotential, float amplitude)
+{
+  return VoltammetryCore_IsStaircaseValid(startPotential, endPotential, amplitude,
+                                          VOLTAMMETRY_CORE_PULSES_FORWARD);
+}
+
+/* Private function implementations. -----------------------------------------*/
+/***
+  * @Brief      Callback function which is triggered when new datapoint parsed.
+  *             Edge zero is the start of the pulse, edge one is the end of it. Step
+  *             is reported after its pulse current.
+  */
+static void newDatapointEventHandler(float datapoint, uint8_t edgeIndex)
+{
+  float current;
+  float potential;
+  float base_current;
+
+  current = (float)(ADC1LSBCurrent * datapoint * CurrentGainCorrection + \
+                    CurrentOffsetCorrection);
+
+  // Call delegate if it's set, once both currents of the step are sampled.
+  if (VoltammetryCore_PairStaircaseCurrents(&Staircase, current, edgeIndex, &potential,
+                                            &base_current) && (NewDatapointDelegate != NULL))
+  {
+    NewDatapointDelegate(potential, base_current, current, current - base_current);
+  }
+}
+
+/***
+  * @Brief      Callback function which is triggered when the
+  *             measurement is completed.
+  */
+static void measurementCompletedEventHandler(void)
+{
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+
+  // Send signal to the upper layer via callback function.
+  if (MeasurementCompletedDelegate != NULL)
+  {
+    MeasurementCompletedDelegate();
+  }
+
+  State = DIFFERENTIAL_PULSE_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Function which is called when voltammetry core updates
+  *             generated signal. Called from the tick ISR, so it uses integer
+  *             arithmetic only. Pulse is applied at the end of each step. Start
+  *             potential is held during the equilibrium period.
+  *
+  * @Param      tickCounter->Ticks since the end of the equilibrium period.
+  */
+static uint16_t generatorFunctionImplementation(int32_t tickCounter)
+{
+  uint32_t step;
+  uint32_t tick;
+  int64_t code;
+
+  if (tickCounter < 0)
+  {
+    return VoltammetryCore_RoundCode(Staircase.startCode);
+  }
+
+  step = (uint32_t)tickCounter / StepTicks;
+  tick = (uint32_t)tickCounter - step * StepTicks;
+
+  // Hold the last step, until the core stops.
+  code = VoltammetryCore_GetStepCode(&Staircase, step);
+
+  if (tick >= PulseStartTick)
+  {
+    code += Staircase.pulseIncrement;
+  }
+
+  return VoltammetryCore_RoundCode(code);
+}
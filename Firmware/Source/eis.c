@@ -1,563 +1,1888 @@
-/**
-  * @author     Onur Efe
-  */
-
-#include <math.h>
-#include "middlewares.h"
-#include "eis.h"
-
-
-/* Private definitions -------------------------------------------------------*/
-#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
-#define VGND_DAC_CODE_LF                        (((double)(MAX_UINT16 + 1)) / 2)
-
-#define SIGNAL_RANGE_SAFETY_FACTOR              1.05
-#define CALIB_ELEMENT_REAL                      BOARD_CALIB_ELEMENT_IMP_REAL
-#define CALIB_ELEMENT_IMG                       BOARD_CALIB_ELEMENT_IMP_IMG
-
-#define START_EVENT                             0x01
-#define STOP_EVENT                              0x02
-#define EQUILIBRIUM_PERIOD_ELAPSED_EVENT        0x04        
-#define MEASUREMENT_COMPLETED_EVENT             0x08
-
-/* Private function prototypes -----------------------------------------------*/
-static void subtractOffset(double calibMeasReal, double calibMeasImg, double rawMeasReal,
-                           double rawMeasImg, double *pMeasReal, double *pMeasImg);
-
-static void determineDynamicSignalScaling(float amplitudePP, double *pDAC1LSBPotential,
-                                          Board_BinarySignalScaling_t *pBinaryScaling,
-                                          Board_DecimalSignalScaling_t *pDecimalScaling);
-
-static void calculateImpedance(double adc1LSBCurrent, double signalAmpPP, double xAvr, 
-                               double yAvr, double *pReal, double *pImaginary);
-
-static void equilibriumPeriodElapsedEventHandler(void);
-static void measurementCompletedEventHandler(void);
-
-/* Private variables ---------------------------------------------------------*/
-/* Module control variables. */
-static EIS_State_t                      State = EIS_STATE_UNINIT;
-uint8_t                                 Events;
-
-/* Modified variables. */
-static uint16_t                         MeasurementIndex;
-
-/* Store variables. They aren't modified during measurement. */
-static uint32_t                         EquilibriumPeriodInSysTicks;
-static float                            SignalAmplitudePP;
-static double                           ADC1LSBCurrent;
-static double                           SignalDAC1LSBPotential;
-static uint16_t                         BiasDACCode;
-static Board_BinarySignalScaling_t      BinaryScaling;
-static Board_DecimalSignalScaling_t     DecimalScaling;
-static Board_TIAFBPath_t                FBPath;
-static double                           *pFrequency;
-static uint32_t                         *pCycles;
-static double                           *pCalibReal;
-static double                           *pCalibImg;
-static uint16_t                         NumOfMeasurements;
-
-static EIS_MeasurementCompletedDelegate_t       MeasurementCompletedDelegate;
-static EIS_NewDatapointDelegate_t       NewDatapointDelegate;
-
-/* Exported functions --------------------------------------------------------*/
-/***
-  * @Brief      Module setup. Should be called before any other function.
-  *
-  * @Param      pMeasParams-> Pointer to the measurement parameters struct.
-  */
-void EIS_Setup(EIS_MeasurementParams_t *pMeasParams)
-{
-  /* Check for state compatibility. */
-  if ((State == EIS_STATE_OPERATING_EQUILIBRIUM) || (State == EIS_STATE_OPERATING_MEASUREMENT))
-  {
-    ExceptionHandler_ThrowException(\
-      "EIS module setup function called when the module is operating.\n");
-  }
-  
-  // Set store variables. These variables are used during measurements.
-  FBPath = pMeasParams->analog.feedbackPath;
-  pFrequency = pMeasParams->dds.pFrequency;
-  pCycles = pMeasParams->dds.pCycles;
-  pCalibReal = pMeasParams->pCalibReal;
-  pCalibImg = pMeasParams->pCalibImg;
-  NumOfMeasurements = pMeasParams->dds.datapointCount;
-  NewDatapointDelegate = pMeasParams->newDatapointDelegate;
-  MeasurementCompletedDelegate = pMeasParams->measurementCompletedDelegate;
-  
-  // Calculate signal amplitude peak to peak.
-  SignalAmplitudePP = pMeasParams->analog.amplitudeRms * M_ROOT_OF_2;
-  
-  // Parse ADC 1 LSB current.
-  ADC1LSBCurrent = Board_GetADC1LSBCurrent(FBPath);
-  
-  // Calculate Bias DAC code.
-  BiasDACCode = (uint16_t)(VGND_DAC_CODE_LF + pMeasParams->analog.biasPotential / \
-    Board_GetBiasDAC1LSBAppliedPotential());
-    
-  // Determine signal scaling options.
-  determineDynamicSignalScaling(SignalAmplitudePP, &SignalDAC1LSBPotential, 
-                                &BinaryScaling, &DecimalScaling);
-  
-  /* Initial setup of EIS core. */
-  {
-    EISCore_MeasParams_t eis_core;
-        
-    eis_core.frequency = pFrequency[0];
-    eis_core.measurementCompletedDelegate = measurementCompletedEventHandler;
-    eis_core.cycles = pCycles[0];
-    eis_core.signal_amp_pp_dac_code = (uint16_t)fabs(SignalAmplitudePP / SignalDAC1LSBPotential);
-        
-    EISCore_Setup(&eis_core);
-  }
-  
-  // Calculate equilibrium period in system ticks.
-  EquilibriumPeriodInSysTicks = (uint32_t)pMeasParams->equilibriumPeriod * SYS_TICK_FREQ;
-  
-  // Reset events flags.
-  Events = 0;
-  
-  // Set state to ready.
-  State = EIS_STATE_READY;
-}
-
-/***
-  * @Brief      Sets start event.
-  */
-void EIS_Start(void)
-{
-  Events |= START_EVENT;
-}
-
-/***
-  * @Brief      EIS module task executer.
-  */
-void EIS_Execute(void)
-{
-  /* No operation when not in operating state. */
-  if (State == EIS_STATE_UNINIT)
-  {
-    ExceptionHandler_ThrowException(\
-      "EIS module execute function called when the module is not initialized.\n");
-  }
-  
-  // Execute core module. 
-  EISCore_Execute();
-  
-  /* Start event handler. */
-  if (Events & START_EVENT)
-  {
-    if (State == EIS_STATE_READY)
-    {
-      AlarmClock_Req_t alarm;
-      
-      // Reset events flags.
-      MeasurementIndex = 0;
-      Events = 0;
-  
-      // Turn on analog circuitry.
-      Board_TurnOnAnalog();
-        
-      // Set scaling.
-      Board_SetBinarySignalScaling(BinaryScaling);
-      Board_SetDecimalSignalScaling(DecimalScaling);
-    
-      // Set configuration to impedance spectroscopy.
-      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_EIS);
-        
-      // Ensure that all HUB peripherals are deselected. And load pins are activated.
-      Board_TIASetnCS();
-      Board_TIAResetnLATCH();
-        
-      Board_DACBiasSetnCS();
-      Board_DACBiasResetnLDAC();
-        
-      Board_DACSignalSetnCS();
-      Board_DACSignalResetnLDAC();
-        
-      // Select feedback path.
-      Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_TIA);
-      Board_HUBSPIEnable();
-      Board_TIAResetnCS();
-      Board_TIASelectFBPath(FBPath);
-      Board_TIASetnCS();
-      Board_TIASetnLATCH();
-        
-      // Set Bias DAC code.
-      Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_BIAS);
-      Board_HUBSPIEnable();
-        
-      Board_DACBiasResetnCS();
-      Board_HUBSPISend(BiasDACCode);
-      while (Board_HUBSPIIsBusy());
-      Board_DACBiasSetnCS();
-      Board_DACBiasSetnLDAC();
-        
-      Utils_DelayMs(Board_GetDACBiasStabilizationPeriod());
-        
-      // Set Signal DAC code..
-      Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_SIGNAL);
-      Board_HUBSPIEnable();
-      Board_DACSignalResetnCS();
-      Board_HUBSPISend(VGND_DAC_CODE);
-      while (Board_HUBSPIIsBusy());
-      Board_DACSignalSetnCS();
-        
-      /* Set alarm. */
-      alarm.period = EquilibriumPeriodInSysTicks;
-      alarm.timerExpCB = equilibriumPeriodElapsedEventHandler;
-      AlarmClock_SetAlarm(&alarm);
-      
-      // Enable ADC SPI.
-      Board_ADCSPIEnable();
-      
-      State = EIS_STATE_OPERATING_EQUILIBRIUM;
-    }
-
-    Events ^= START_EVENT;
-  }
-  
-  /* Stop event handler. */
-  if (Events & STOP_EVENT)
-  {
-    /* Process or discard event according to state. */
-    if (State == EIS_STATE_OPERATING_EQUILIBRIUM)
-    {
-      /* Cancel alarm. */
-      AlarmClock_CancelReq_t req;
-      req.timerExpCB = equilibriumPeriodElapsedEventHandler;
-      AlarmClock_CancelAlarm(&req);
-      
-      /* Disable SPIs. */
-      Board_HUBSPIDisable();
-      Board_ADCSPIDisable();
-      
-      // Set configuration to off.
-      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
-      
-      // Turn off analog circuitry.
-      Board_TurnOffAnalog();
-      
-      State = EIS_STATE_READY;
-    }
-    else if (State == EIS_STATE_OPERATING_MEASUREMENT)
-    {
-      Board_HUBSPIDisable();
-      Board_ADCSPIDisable();
-      
-      // Set configuration to off.
-      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
-      
-      // Stop submodules.
-      EISCore_Stop();
-      
-      // Turn off analog circuitry.
-      Board_TurnOffAnalog();
-      
-      State = EIS_STATE_READY;
-    }
-
-    Events ^= STOP_EVENT;
-  }
-  
-  /* Equilibrium period completed event. */
-  if (Events & EQUILIBRIUM_PERIOD_ELAPSED_EVENT)
-  {
-    /* Process the event if the state is operating equilibrium. */
-    if (State == EIS_STATE_OPERATING_EQUILIBRIUM)
-    {
-      EISCore_Start();
-      
-      State = EIS_STATE_OPERATING_MEASUREMENT;
-    }
-    
-    Events ^= EQUILIBRIUM_PERIOD_ELAPSED_EVENT;
-  }
-  
-  /* Measurement completed event. */
-  if (Events & MEASUREMENT_COMPLETED_EVENT)
-  {
-    if (State == EIS_STATE_OPERATING_MEASUREMENT)
-    {
-      double core_real, core_img;
-      double imp_real, imp_img;
-      
-      // Parse result.
-      EISCore_GetResult(&core_real, &core_img);
-      MeasurementIndex++;
-      
-      // Calculate impedance.
-      calculateImpedance(ADC1LSBCurrent, SignalAmplitudePP, core_real,
-                         core_img, &imp_real, &imp_img);
-           
-      /* If there is a calibration data, apply it. */
-      if ((pCalibReal != NULL) && (pCalibImg != NULL))
-      {
-        subtractOffset(pCalibReal[MeasurementIndex], pCalibImg[MeasurementIndex], 
-                       imp_real, imp_img, &imp_real, &imp_img);
-      }
-          
-      // Call callback function, if it's set.
-      if (NewDatapointDelegate != NULL)
-      {
-        NewDatapointDelegate(imp_real, imp_img);
-      }
-      
-      if (MeasurementIndex >= NumOfMeasurements)
-      {
-        Board_HUBSPIDisable();
-        Board_ADCSPIDisable();
-        
-        // Set configuration to off.
-        Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
-        
-        // Stop submodules.
-        EISCore_Stop();
-        
-        // Turn off analog circuitry.
-        Board_TurnOffAnalog();
-        
-        // Call callback function, if it's set.
-        if (MeasurementCompletedDelegate != NULL)
-        {
-          MeasurementCompletedDelegate();
-        }
-        
-        State = EIS_STATE_READY;
-      }
-      else
-      { 
-        /* Setup for the next measurement of EIS core. */
-        EISCore_MeasParams_t eis_core;
-      
-        eis_core.signal_amp_pp_dac_code = (uint16_t)fabs(SignalAmplitudePP / SignalDAC1LSBPotential);
-        eis_core.frequency = pFrequency[MeasurementIndex];
-        eis_core.cycles = pCycles[MeasurementIndex];
-        eis_core.measurementCompletedDelegate = measurementCompletedEventHandler;
-      
-        EISCore_Setup(&eis_core);
-        
-        // Start new measurement. 
-        EISCore_Start();
-      }
-    }
-    Events ^= MEASUREMENT_COMPLETED_EVENT;
-  }
-}
-
-/***
-  * @Brief      Sets stop event.
-  */
-void EIS_Stop(void)
-{
-  Events |= STOP_EVENT;
-}
-
-                                    
-/***
-  * @Brief      Returns state of the module.
-  *
-  * @Return     State.
-  */
-EIS_State_t EIS_GetState(void)
-{
-  return State;
-}
-
-/***
-  * @Brief      Creates calibration profile. Uses eeprom emulator module.
-  *
-  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
-  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
-  * @Param      pCalibBuffReal-> Pointer to calibration profile real part.
-  * @Param      pCalibBuffImg-> Pointer to calibration profile imaginary part.
-  * @Param      datapointCount-> Number of datapoints.
-  */
-void EIS_CreateCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
-                                  double *pCalibBuffReal, double *pCalibBuffImg, 
-                                  uint16_t datapointCount)
-{
-  /* Check if the datapoint count is valid. */
-  if (datapointCount > (MAX_UINT16 / sizeof(double)))
-  {
-    ExceptionHandler_ThrowException("EIS module error when saving data to calibration \
-                                     profile.\n");
-  }
-  
-  /* Write calibration profile to ROM. */
-  EepromEmulator_WriteObject(eeObjectIdReal, (datapointCount * sizeof(double)),
-                             (uint8_t *)pCalibBuffReal);
-  
-  EepromEmulator_WriteObject(eeObjectIdImg, (datapointCount * sizeof(double)),
-                             (uint8_t *)pCalibBuffImg);                    
-}
-
-/***
-  * @Brief      Loads calibration profile.
-  *
-  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
-  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
-  * @Param      pCalibBuffReal-> Pointer to parsed calibration profile real part.
-  * @Param      pCalibBuffImg-> Pointer to parsed calibration profile imaginary part.
-  * @Param      pDatapointCount-> Pointer to return number of datapoints.
-  * 
-  * @Return     Profile found of not(TRUE of FALSE).
-  */
-uint8_t EIS_LoadCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
-                                   double *pCalibBuffReal, double *pCalibBuffImg, 
-                                   uint16_t *pDatapointCount)
-{
-  uint8_t profile_real_found;
-  uint8_t profile_img_found;
-  uint16_t length_real;
-  uint16_t length_img;
-  uint8_t retval;
-  
-  /* Load calibration profiles. */
-  profile_real_found = EepromEmulator_ReadObject(eeObjectIdReal, 0U, (MAX_UINT16 / sizeof(double)), 
-                                                 &length_real, ((uint8_t *)pCalibBuffReal));
-  
-  profile_img_found = EepromEmulator_ReadObject(eeObjectIdImg, 0U, (MAX_UINT16 / sizeof(double)), 
-                                                 &length_img, ((uint8_t *)pCalibBuffImg));
-  
-  /* If everything is normal, calculate datapoint count and return TRUE. Otherwise
-    return false. */
-  if ((profile_real_found == TRUE) && (profile_img_found == TRUE) && (length_real == length_img))
-  {
-    *pDatapointCount = length_real / sizeof(double);
-    
-    retval = TRUE;
-  }
-  else
-  {
-    retval = FALSE;
-  }
-  
-  return retval;
-}
-                                    
-/* Private functions ---------------------------------------------------------*/
-/***
-  * @Brief      Callback function which is triggered when the equilibrium period 
-  *             is elapsed.
-  */
-static void equilibriumPeriodElapsedEventHandler(void)
-{
-  // Set event flag.
-  Events |= EQUILIBRIUM_PERIOD_ELAPSED_EVENT;
-}
-
-/***
-  * @Brief      Callback function which is triggered when the measurement is 
-  *             completed.
-  */
-static void measurementCompletedEventHandler(void)
-{
-  // Set event flag.
-  Events |= MEASUREMENT_COMPLETED_EVENT;
-}
-
-/***
-  * @Brief      Determines optimum SNR dynamic scaling.
-  *
-  * @Param      amplitudePP-> Signal amplitude peak to peak, in units of volts.
-  * @Param      pDAC1LSBPotential-> Pointer to DAC 1LSB potential.
-  * @Param      pDynamicScaling-> Pointer to return dynamic scaling.
-  * @Param      pBinaryScaling-> Binary scaling option.
-  * @Param      pDecimalScaling-> Decimal scaling option.
-  */
-static void determineDynamicSignalScaling(float amplitudePP, double *pDAC1LSBPotential,
-                                          Board_BinarySignalScaling_t *pBinaryScaling,
-                                          Board_DecimalSignalScaling_t *pDecimalScaling)
-{
-  double dac1lsb_potential;
-  
-  const Board_BinarySignalScaling_t BinaryScalingTable[] = \
-  {BOARD_BINARY_SIGNAL_SCALING_1_4, BOARD_BINARY_SIGNAL_SCALING_2_4, 
-   BOARD_BINARY_SIGNAL_SCALING_3_4, BOARD_BINARY_SIGNAL_SCALING_4_4};
-
-  const Board_DecimalSignalScaling_t DecimalScalingTable[] = \
-  {BOARD_DECIMAL_SIGNAL_SCALING_1_100, BOARD_DECIMAL_SIGNAL_SCALING_1_10,
-   BOARD_DECIMAL_SIGNAL_SCALING_1_1};
-
-  /* Decision loop. Algorithm tries the smallest range to the biggest range, if the amplitude
-    fits into the range. If it fits, records the scaling options and the value, then returns. */
-  for (uint8_t i = 0; i < sizeof(DecimalScalingTable) / sizeof(DecimalScalingTable[0]); i++)
-  {
-    for (uint8_t j = 0; j < sizeof(BinaryScalingTable) / sizeof(BinaryScalingTable[0]); j++)
-    {
-      dac1lsb_potential = Board_GetSignalDAC1LSBAppliedPotential(BinaryScalingTable[j], 
-                                                                 DecimalScalingTable[i]);
-        
-      /* Check if DAC range is sufficient for this scaling*/
-      if ((((double)MAX_UINT16) / SIGNAL_RANGE_SAFETY_FACTOR) >= fabs(amplitudePP / dac1lsb_potential))
-      {
-        *pDecimalScaling = DecimalScalingTable[i];
-        *pBinaryScaling = BinaryScalingTable[j];
-        *pDAC1LSBPotential = dac1lsb_potential;
-          
-        return;
-      } // end of if.
-    } // end of for 2.
-  } // end of for 1.
-} // end of function.
-
-/***
-  * @Brief      Calculates impedance in units of kilo-ohms.
-  *
-  * @Param      adc1LSBCurrent->1 LSB Current of the ADC in units of microamps.
-  * @Param      signalAmpPP->Peak to peak signal amplitude in units of volts.
-  * @Param      xAvr->Weighted average X parsed from the EIS core.
-  * @Param      yAvr->Weigthed average Y parsed from the EIS core.
-  * @Param      pReal->Pointer to impedance real component.
-  * @Param      pImg->Pointer to impedance imaginary component.
-  */
-static void calculateImpedance(double adc1LSBCurrent, double signalAmpPP, double xAvr,
-                               double yAvr, double *pReal, double *pImaginary)
-{
-  double current_x;
-  double current_y;
-  
-  /* To prevent loss of precision during calculation, cast SumX and SumY to double. */
-  /* Transform SumX, SumY to current_sum_x, current_. */
-  current_x = 2.0 * adc1LSBCurrent * yAvr * 0.001;
-  current_y = 2.0 * adc1LSBCurrent * xAvr * 0.001;
-  
-  /* Calculate impedance. */
-  *pReal = (float)(signalAmpPP * 0.5f * current_x) / \
-    (current_x * current_x + current_y * current_y);
-  
-  *pImaginary = (float)(-signalAmpPP * 0.5f * current_y) / \
-    (current_x * current_x + current_y * current_y);
-}
-                                    
-/***
-  * @Brief      Process raw measurement. Calibration measurement is used as reference.
-  */
-static void subtractOffset(double calibMeasReal, double calibMeasImg, double rawMeasReal, double rawMeasImg,
-                           double *pMeasReal, double *pMeasImg)
-{
-  double calib_mult_real;
-  double calib_mult_img;
-  
-  /* Check if the calibration measurement is valid. */
-  if ((calibMeasReal == 0.0) && (calibMeasImg == 0.0))
-  {
-    ExceptionHandler_ThrowException(\
-      "EIS module calibration measurement data is invalid.");
-  }
-    
-  /* Calculate calibration multiplier. Which equals to calibElement / calibMeas in 
-    complex number system. */
-  calib_mult_real = (CALIB_ELEMENT_REAL * calibMeasReal + CALIB_ELEMENT_IMG * calibMeasImg) / \
-    (calibMeasReal * calibMeasReal + calibMeasImg * calibMeasImg);
-  
-  calib_mult_img = (CALIB_ELEMENT_IMG * calibMeasReal - CALIB_ELEMENT_REAL * calibMeasImg) / \
-    (calibMeasReal * calibMeasReal + calibMeasImg * calibMeasImg);
-  
-  /* Calculate measurement results. */
-  *pMeasReal = rawMeasReal * calib_mult_real - rawMeasImg * calib_mult_img;
-  *pMeasImg = rawMeasImg * calib_mult_real + rawMeasReal * calib_mult_img;
-}
- 
+/**
+  * @author     Onur Efe
+  */
+
+#include <math.h>
+#include "middlewares.h"
+#include "eis.h"
+
+
+/* Private definitions -------------------------------------------------------*/
+#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
+#define VGND_DAC_CODE_LF                        (((double)(MAX_UINT16 + 1)) / 2)
+
+#define SIGNAL_RANGE_SAFETY_FACTOR              1.05
+#define CALIB_ELEMENT_REAL                      BOARD_CALIB_ELEMENT_IMP_REAL
+#define CALIB_ELEMENT_IMG                       BOARD_CALIB_ELEMENT_IMP_IMG
+
+/* Auto range limits of the peak ADC code. Clipped measurement is taken again in the
+  lower range. Valid one isn't taken again, the next measurement is taken in the
+  highest range which keeps the predicted peak below the target. */
+#define RANGE_FULL_SCALE                        32768.0
+#define RANGE_CLIP_LIMIT                        (0.95 * RANGE_FULL_SCALE)
+#define RANGE_TARGET_LIMIT                      (0.7 * RANGE_FULL_SCALE)
+#define RANGE_MAX_RETRIES                       3
+
+/* Amplitude schedule. Peak is predicted to scale with the amplitude, change of the
+  amplitude is limited since the impedance changes between the frequencies. */
+#define AMPLITUDE_TARGET_PEAK                   (0.5 * RANGE_FULL_SCALE)
+#define AMPLITUDE_MAX_STEP_RATIO                4.0
+#define AMPLITUDE_MAX_RETRIES                   3       // Of a clipped measurement.
+
+#define START_EVENT                             0x01
+#define STOP_EVENT                              0x02
+#define EQUILIBRIUM_PERIOD_ELAPSED_EVENT        0x04        
+#define MEASUREMENT_COMPLETED_EVENT             0x08
+#define MEASUREMENT_ABORTED_EVENT               0x10
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Interpolation segment of the calibration profile, in log frequency. It's kept
+  until the frequency leaves its cover, sweeps are monotonic. Cover of the first
+  and the last segments extends outside the profile. */
+typedef struct
+{
+  EIS_Calib_t           *pCalib;
+  uint16_t              indexLow, indexHigh;
+  double                logFrequencyLow, logFrequencyHigh;
+  double                coverLow, coverHigh;
+  double                logMagnitude, logMagnitudeSlope;
+  double                phase, phaseSlope;
+} CalibSegment_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static void subtractOffset(double calibMeasReal, double calibMeasImg, double rawMeasReal,
+                           double rawMeasImg, double *pMeasReal, double *pMeasImg);
+
+static void determineDynamicSignalScaling(float amplitudePP, double *pDAC1LSBPotential,
+                                          Board_BinarySignalScaling_t *pBinaryScaling,
+                                          Board_DecimalSignalScaling_t *pDecimalScaling);
+
+static void calculateImpedance(double adc1LSBCurrent, double signalAmpPP, double xAvr, 
+                               double yAvr, double *pReal, double *pImaginary);
+
+static void setupCoreMeasurement(void);
+static void prepareNextCoreMeasurement(void);
+static uint8_t fillCoreMeasParams(uint16_t measurementIndex, EISCore_MeasParams_t *pCoreParams);
+static void checkFrequencyError(float frequencyError);
+static void reportHarmonics(double coreReal, double coreImg);
+static void planSweep(void);
+static uint8_t getToneCount(uint16_t measurementIndex);
+static uint16_t getLowestFrequencyIndex(uint16_t measurementIndex, uint8_t toneCount);
+static double getFrequency(uint16_t index);
+static uint32_t getCycles(uint16_t index);
+static uint32_t getSettleCycles(uint16_t index);
+static float getBiasPotential(uint16_t stepIndex);
+static void writeBiasDACCode(uint16_t dacCode);
+static void startBiasStep(void);
+static uint8_t isBiasSettled(void);
+static void selectFBPath(Board_TIAFBPath_t fbPath);
+static uint8_t isRangeChangeNeeded(void);
+static uint8_t isBetterRangeAvailable(void);
+static void updateAmplitude(void);
+static uint8_t isAmplitudeRetryNeeded(void);
+static void checkCalibration(EIS_Calib_t *pCalib);
+static void getCalibration(uint16_t index, double *pCalibReal, double *pCalibImg);
+static double locateCalibSegment(uint16_t index);
+static void planCalibSegment(double logFrequency);
+static void calculateCalibCoefficients(EIS_Calib_t *pCalib);
+static double correctThreeTerms(uint16_t index, double *pReal, double *pImg);
+static void multiplyComplex(double aReal, double aImg, double bReal, double bImg,
+                            double *pReal, double *pImg);
+static void divideComplex(double aReal, double aImg, double bReal, double bImg,
+                          double *pReal, double *pImg);
+
+static void equilibriumPeriodElapsedEventHandler(void);
+static void measurementCompletedEventHandler(void);
+static void measurementAbortedEventHandler(void);
+
+/* Private variables ---------------------------------------------------------*/
+/* Module control variables. */
+static EIS_State_t                      State = EIS_STATE_UNINIT;
+uint8_t                                 Events;
+
+/* Modified variables. */
+static uint16_t                         MeasurementIndex;
+static uint8_t                          ToneCount;
+static uint8_t                          NextToneCount;
+static float                            AmplitudePP;
+static float                            MeasAmplitudePP;
+static float                            NextMeasAmplitudePP;
+static uint16_t                         BiasStepIndex;
+static uint8_t                          IsBiasSettling;
+static uint8_t                          SettleRepeatCount;
+static double                           SettleImpedance;
+static Board_TIAFBPath_t                FBPath;
+static Board_TIAFBPath_t                NextFBPath;
+static double                           ADC1LSBCurrent;
+static EIS_Calib_t                      *pActiveCalib;
+static CalibSegment_t                   CalibSegment;
+static uint8_t                          IsRangeChangePending;
+static uint8_t                          RangeRetryCount;
+static uint8_t                          AmplitudeRetryCount;
+
+/* Store variables. They aren't modified during measurement. */
+static uint32_t                         EquilibriumPeriodInSysTicks;
+static float                            SignalAmplitudePP;
+static float                            MinAmplitudePP;
+static float                            MaxAmplitudePP;
+static uint8_t                          IsAmplitudeScheduleEnabled;
+static double                           SignalDAC1LSBPotential;
+static uint16_t                         BiasDACCode;
+static float                            BiasPotential;
+static EIS_BiasSweep_t                  BiasSweep;
+static Board_BinarySignalScaling_t      BinaryScaling;
+static Board_DecimalSignalScaling_t     DecimalScaling;
+static Board_TIAFBPath_t                InitialFBPath;
+static uint8_t                          IsAutoRangeEnabled;
+static EIS_Calib_t                      Calib;
+static EIS_Calib_t                      RangeCalib[EIS_FB_PATH_COUNT];
+static double                           *pFrequency;
+static uint32_t                         *pCycles;
+static uint32_t                         *pMaxCycles;
+static float                            TargetRelUncertainty;
+static float                            MaxRelFreqError;
+static uint32_t                         *pSettleCycles;
+static float                            CellTimeConstant;
+static EISCore_Window_t                 Window;
+static uint8_t                          IsDetrendEnabled;
+static uint8_t                          IsContinuous;
+static uint16_t                         NumOfMeasurements;
+static uint8_t                          TonesPerMeasurement;
+static EIS_Sweep_t                      Sweep;
+static double                           SweepLogStep;
+static double                           SweepExtraTime;
+
+static EIS_MeasurementCompletedDelegate_t       MeasurementCompletedDelegate;
+static EIS_MeasurementAbortedDelegate_t         MeasurementAbortedDelegate;
+static EIS_NewDatapointDelegate_t       NewDatapointDelegate;
+static EIS_NewHarmonicsDelegate_t       NewHarmonicsDelegate;
+static EIS_NewTimestampDelegate_t       NewTimestampDelegate;
+static EIS_NewBiasDelegate_t            NewBiasDelegate;
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      Module setup. Should be called before any other function.
+  *
+  * @Param      pMeasParams-> Pointer to the measurement parameters struct.
+  */
+void EIS_Setup(EIS_MeasurementParams_t *pMeasParams)
+{
+  /* Check for state compatibility. */
+  if ((State == EIS_STATE_OPERATING_EQUILIBRIUM) || (State == EIS_STATE_OPERATING_MEASUREMENT))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called when the module is operating.\n");
+  }
+  
+  /* Check tone count. Zero is treated as single tone measurement. */
+  if (pMeasParams->dds.tonesPerMeasurement > EIS_CORE_MAX_TONES)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called with too many tones per measurement.\n");
+  }
+  
+  /* Continuous mode streams a single frequency. */
+  if ((pMeasParams->dds.isContinuous == TRUE) && (pMeasParams->dds.tonesPerMeasurement > 1))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called with multisine in continuous mode.\n");
+  }
+  
+  /* Bias steps are measured one after another, continuous mode doesn't end. */
+  if (pMeasParams->analog.biasSweep.stepCount > 0)
+  {
+    if (pMeasParams->dds.isContinuous == TRUE)
+    {
+      ExceptionHandler_ThrowException(\
+        "EIS module setup function called with bias steps in continuous mode.\n");
+    }
+    
+    if ((pMeasParams->analog.biasSweep.stopPotential > BOARD_MAX_BIAS_POTENTIAL) || \
+        (pMeasParams->analog.biasSweep.stopPotential < BOARD_MIN_BIAS_POTENTIAL))
+    {
+      ExceptionHandler_ThrowException(\
+        "EIS module setup function called with invalid bias stop potential.\n");
+    }
+  }
+  
+  // Set store variables. These variables are used during measurements.
+  InitialFBPath = pMeasParams->analog.feedbackPath;
+  IsAutoRangeEnabled = pMeasParams->analog.isAutoRangeEnabled;
+  pFrequency = pMeasParams->dds.pFrequency;
+  pCycles = pMeasParams->dds.pCycles;
+  pMaxCycles = pMeasParams->dds.pMaxCycles;
+  TargetRelUncertainty = pMeasParams->dds.targetRelUncertainty;
+  MaxRelFreqError = pMeasParams->dds.maxRelFreqError;
+  pSettleCycles = pMeasParams->dds.pSettleCycles;
+  CellTimeConstant = pMeasParams->dds.cellTimeConstant;
+  Window = pMeasParams->dds.window;
+  IsDetrendEnabled = pMeasParams->dds.isDetrendEnabled;
+  IsContinuous = pMeasParams->dds.isContinuous;
+  Calib = pMeasParams->calib;
+  checkCalibration(&Calib);
+  calculateCalibCoefficients(&Calib);
+  
+  // Profiles might have changed, segment is planned again.
+  CalibSegment.pCalib = NULL;
+  
+  for (uint8_t i = 0; i < EIS_FB_PATH_COUNT; i++)
+  {
+    RangeCalib[i] = pMeasParams->rangeCalib[i];
+    checkCalibration(&RangeCalib[i]);
+    calculateCalibCoefficients(&RangeCalib[i]);
+  }
+  NumOfMeasurements = pMeasParams->dds.datapointCount;
+  TonesPerMeasurement = pMeasParams->dds.tonesPerMeasurement;
+  Sweep = pMeasParams->dds.sweep;
+  NewDatapointDelegate = pMeasParams->newDatapointDelegate;
+  NewHarmonicsDelegate = pMeasParams->newHarmonicsDelegate;
+  NewTimestampDelegate = pMeasParams->newTimestampDelegate;
+  NewBiasDelegate = pMeasParams->newBiasDelegate;
+  MeasurementCompletedDelegate = pMeasParams->measurementCompletedDelegate;
+  MeasurementAbortedDelegate = pMeasParams->measurementAbortedDelegate;
+  
+  // Calculate signal amplitude peak to peak.
+  SignalAmplitudePP = pMeasParams->analog.amplitudeRms * M_ROOT_OF_2;
+  AmplitudePP = SignalAmplitudePP;
+  
+  /* Scheduled amplitudes are in the range of the scaling. */
+  IsAmplitudeScheduleEnabled = (pMeasParams->analog.amplitudeSchedule.maxAmplitudeRms > 0.0f) ? \
+    TRUE : FALSE;
+  
+  if (IsAmplitudeScheduleEnabled == TRUE)
+  {
+    MinAmplitudePP = pMeasParams->analog.amplitudeSchedule.minAmplitudeRms * M_ROOT_OF_2;
+    MaxAmplitudePP = pMeasParams->analog.amplitudeSchedule.maxAmplitudeRms * M_ROOT_OF_2;
+    
+    if ((MinAmplitudePP <= 0.0f) || (MinAmplitudePP > SignalAmplitudePP) || \
+        (SignalAmplitudePP > MaxAmplitudePP))
+    {
+      ExceptionHandler_ThrowException(\
+        "EIS module setup function called with invalid amplitude schedule.\n");
+    }
+  }
+  else
+  {
+    MaxAmplitudePP = SignalAmplitudePP;
+  }
+  
+  // Calculate Bias DAC code.
+  BiasPotential = pMeasParams->analog.biasPotential;
+  BiasSweep = pMeasParams->analog.biasSweep;
+  BiasDACCode = (uint16_t)(VGND_DAC_CODE_LF + BiasPotential / \
+    Board_GetBiasDAC1LSBAppliedPotential());
+    
+  // Determine signal scaling options.
+  determineDynamicSignalScaling(MaxAmplitudePP, &SignalDAC1LSBPotential, 
+                                &BinaryScaling, &DecimalScaling);
+  
+  if (TonesPerMeasurement == 0)
+  {
+    TonesPerMeasurement = 1;
+  }
+  
+  /* Without frequency array, the sweep descriptor is expanded during the measurement. */
+  if (pFrequency == NULL)
+  {
+    planSweep();
+  }
+  
+  /* Initial setup of EIS core. */
+  MeasurementIndex = 0;
+  setupCoreMeasurement();
+  
+  // Calculate equilibrium period in system ticks.
+  EquilibriumPeriodInSysTicks = (uint32_t)pMeasParams->equilibriumPeriod * SYS_TICK_FREQ;
+  
+  // Reset events flags.
+  Events = 0;
+  
+  // Set state to ready.
+  State = EIS_STATE_READY;
+}
+
+/***
+  * @Brief      Sets start event.
+  */
+void EIS_Start(void)
+{
+  Events |= START_EVENT;
+}
+
+/***
+  * @Brief      EIS module task executer.
+  */
+void EIS_Execute(void)
+{
+  /* No operation when not in operating state. */
+  if (State == EIS_STATE_UNINIT)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module execute function called when the module is not initialized.\n");
+  }
+  
+  // Execute core module. 
+  EISCore_Execute();
+  
+  /* Core has aborted the measurement, it's already stopped. Rest of the sweep is
+    cancelled, and the error is reported instead of the completion. */
+  if (Events & MEASUREMENT_ABORTED_EVENT)
+  {
+    if (State == EIS_STATE_OPERATING_MEASUREMENT)
+    {
+      Board_HUBSPIDisable();
+      Board_ADCSPIDisable();
+      
+      // Set configuration to off.
+      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
+      
+      // Turn off analog circuitry.
+      Board_TurnOffAnalog();
+      
+      IsRangeChangePending = FALSE;
+      Events &= ~MEASUREMENT_COMPLETED_EVENT;
+      
+      // Call callback function, if it's set.
+      if (MeasurementAbortedDelegate != NULL)
+      {
+        MeasurementAbortedDelegate();
+      }
+      
+      State = EIS_STATE_READY;
+    }
+    
+    Events ^= MEASUREMENT_ABORTED_EVENT;
+  }
+  
+  /* Range is changed after the core stops, and the current datapoint is measured in
+    it. Measurement which is completed meanwhile is discarded. */
+  if (IsRangeChangePending == TRUE)
+  {
+    Events &= ~MEASUREMENT_COMPLETED_EVENT;
+    
+    if ((State == EIS_STATE_OPERATING_MEASUREMENT) && \
+        (EISCore_GetState() == EIS_CORE_STATE_READY))
+    {
+      IsRangeChangePending = FALSE;
+      
+      selectFBPath(NextFBPath);
+      
+      // Signal DAC is serviced by the core.
+      Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_SIGNAL);
+      Board_HUBSPIEnable();
+      
+      setupCoreMeasurement();
+      EISCore_Start();
+      
+      prepareNextCoreMeasurement();
+    }
+  }
+  
+  /* Start event handler. */
+  if (Events & START_EVENT)
+  {
+    if (State == EIS_STATE_READY)
+    {
+      AlarmClock_Req_t alarm;
+      
+      // Reset events flags.
+      Events = 0;
+      
+      /* Setup of the first measurement, previous run may have left the core
+        at another frequency. */
+      MeasurementIndex = 0;
+      AmplitudePP = SignalAmplitudePP;
+      setupCoreMeasurement();
+      
+      BiasStepIndex = 0;
+      IsBiasSettling = ((BiasSweep.stepCount > 0) && (BiasSweep.maxSettleRepeats > 0)) ? \
+        TRUE : FALSE;
+      SettleRepeatCount = 0;
+      
+      IsRangeChangePending = FALSE;
+      RangeRetryCount = 0;
+      AmplitudeRetryCount = 0;
+  
+      // Turn on analog circuitry.
+      Board_TurnOnAnalog();
+        
+      // Set scaling.
+      Board_SetBinarySignalScaling(BinaryScaling);
+      Board_SetDecimalSignalScaling(DecimalScaling);
+    
+      // Set configuration to impedance spectroscopy.
+      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_EIS);
+        
+      // Ensure that all HUB peripherals are deselected. And load pins are activated.
+      Board_TIASetnCS();
+      Board_TIAResetnLATCH();
+        
+      Board_DACBiasSetnCS();
+      Board_DACBiasResetnLDAC();
+        
+      Board_DACSignalSetnCS();
+      Board_DACSignalResetnLDAC();
+        
+      // Select feedback path.
+      selectFBPath(InitialFBPath);
+        
+      // Set Bias DAC code.
+      writeBiasDACCode(BiasDACCode);
+        
+      Utils_DelayMs(Board_GetDACBiasStabilizationPeriod());
+        
+      // Set Signal DAC code..
+      Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_SIGNAL);
+      Board_HUBSPIEnable();
+      Board_DACSignalResetnCS();
+      Board_HUBSPISend(VGND_DAC_CODE);
+      while (Board_HUBSPIIsBusy());
+      Board_DACSignalSetnCS();
+        
+      /* Set alarm. */
+      alarm.period = EquilibriumPeriodInSysTicks;
+      alarm.timerExpCB = equilibriumPeriodElapsedEventHandler;
+      AlarmClock_SetAlarm(&alarm);
+      
+      // Enable ADC SPI.
+      Board_ADCSPIEnable();
+      
+      State = EIS_STATE_OPERATING_EQUILIBRIUM;
+    }
+
+    Events ^= START_EVENT;
+  }
+  
+  /* Stop event handler. */
+  if (Events & STOP_EVENT)
+  {
+    /* Process or discard event according to state. */
+    if (State == EIS_STATE_OPERATING_EQUILIBRIUM)
+    {
+      /* Cancel alarm. */
+      AlarmClock_CancelReq_t req;
+      req.timerExpCB = equilibriumPeriodElapsedEventHandler;
+      AlarmClock_CancelAlarm(&req);
+      
+      /* Disable SPIs. */
+      Board_HUBSPIDisable();
+      Board_ADCSPIDisable();
+      
+      // Set configuration to off.
+      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
+      
+      // Turn off analog circuitry.
+      Board_TurnOffAnalog();
+      
+      State = EIS_STATE_READY;
+    }
+    else if (State == EIS_STATE_OPERATING_MEASUREMENT)
+    {
+      Board_HUBSPIDisable();
+      Board_ADCSPIDisable();
+      
+      // Set configuration to off.
+      Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
+      
+      // Stop submodules.
+      EISCore_Stop();
+      
+      // Turn off analog circuitry.
+      Board_TurnOffAnalog();
+      
+      IsRangeChangePending = FALSE;
+      
+      State = EIS_STATE_READY;
+    }
+
+    Events ^= STOP_EVENT;
+  }
+  
+  /* Equilibrium period completed event. */
+  if (Events & EQUILIBRIUM_PERIOD_ELAPSED_EVENT)
+  {
+    /* Process the event if the state is operating equilibrium. */
+    if (State == EIS_STATE_OPERATING_EQUILIBRIUM)
+    {
+      EISCore_Start();
+      
+      // Next measurement is prepared while this one is operating.
+      if (IsBiasSettling == FALSE)
+      {
+        prepareNextCoreMeasurement();
+      }
+      
+      State = EIS_STATE_OPERATING_MEASUREMENT;
+    }
+    
+    Events ^= EQUILIBRIUM_PERIOD_ELAPSED_EVENT;
+  }
+  
+  /* Measurement completed event. */
+  if (Events & MEASUREMENT_COMPLETED_EVENT)
+  {
+    if ((State == EIS_STATE_OPERATING_MEASUREMENT) && (IsBiasSettling == TRUE) && \
+        (isBiasSettled() == FALSE))
+    {
+      /* Cell hasn't settled to the new bias yet, repeat the first measurement. */
+      EISCore_Start();
+    }
+    else if ((State == EIS_STATE_OPERATING_MEASUREMENT) && (IsAutoRangeEnabled == TRUE) && \
+             (isRangeChangeNeeded() == TRUE))
+    {
+      /* Core might have swapped in the next measurement. */
+      EISCore_Stop();
+      
+      IsRangeChangePending = TRUE;
+    }
+    else if ((State == EIS_STATE_OPERATING_MEASUREMENT) && (isAmplitudeRetryNeeded() == TRUE))
+    {
+      /* Clipped measurement is taken again with the smaller amplitude. Next measurement
+        isn't prepared in the schedule, so the core is ready. */
+      updateAmplitude();
+      
+      setupCoreMeasurement();
+      EISCore_Start();
+    }
+    else if (State == EIS_STATE_OPERATING_MEASUREMENT)
+    {
+      double core_real, core_img;
+      double imp_real, imp_img;
+      double calib_real, calib_img;
+      double rel_std_error, std_error, error_scale;
+      uint32_t sample_count;
+      uint8_t is_range_better;
+      
+      /* Process every tone of the measurement, in the frequency list order. */
+      for (uint8_t i = 0; i < ToneCount; i++)
+      {
+        // Parse result.
+        EISCore_GetResult(i, &core_real, &core_img);
+        
+        // Calculate impedance.
+        calculateImpedance(ADC1LSBCurrent, MeasAmplitudePP, core_real,
+                           core_img, &imp_real, &imp_img);
+             
+        /* If there is a calibration data, apply it. */
+        if (pActiveCalib->pCoeff != NULL)
+        {
+          error_scale = correctThreeTerms(MeasurementIndex, &imp_real, &imp_img);
+        }
+        else
+        {
+          if ((pActiveCalib->pCalibReal != NULL) && (pActiveCalib->pCalibImg != NULL))
+          {
+            getCalibration(MeasurementIndex, &calib_real, &calib_img);
+            subtractOffset(calib_real, calib_img, imp_real, imp_img, &imp_real, &imp_img);
+          }
+          
+          // Complex multiplication doesn't change the relative error.
+          error_scale = sqrt(imp_real * imp_real + imp_img * imp_img);
+        }
+            
+        /* Relative error of the current is the relative error of the measured
+          impedance. Error scale converts it to the calibrated impedance. */
+        EISCore_GetUncertainty(i, &rel_std_error, &sample_count);
+        
+        if (rel_std_error < 0.0)
+        {
+          std_error = -1.0;
+        }
+        else
+        {
+          std_error = rel_std_error * error_scale;
+        }
+        
+        // Harmonics are demodulated in single tone mode.
+        if ((NewHarmonicsDelegate != NULL) && (ToneCount == 1))
+        {
+          reportHarmonics(core_real, core_img);
+        }
+        
+        if ((NewBiasDelegate != NULL) && (BiasSweep.stepCount > 0) && (MeasurementIndex == 0))
+        {
+          NewBiasDelegate(getBiasPotential(BiasStepIndex));
+        }
+        
+        if ((NewTimestampDelegate != NULL) && (IsContinuous == TRUE))
+        {
+          NewTimestampDelegate(EISCore_GetTimestamp());
+        }
+        
+        // Call callback function, if it's set.
+        if (NewDatapointDelegate != NULL)
+        {
+          NewDatapointDelegate(imp_real, imp_img, std_error, sample_count);
+        }
+        
+        MeasurementIndex++;
+      }
+      
+      // Amplitude of the following measurements follows the response.
+      if (IsAmplitudeScheduleEnabled == TRUE)
+      {
+        updateAmplitude();
+      }
+      
+      // Range of the following measurements follows the response too.
+      is_range_better = ((IsAutoRangeEnabled == TRUE) && (isBetterRangeAvailable() == TRUE)) ? \
+        TRUE : FALSE;
+      
+      /* Core repeats the measurement in continuous mode, until it's stopped. Repeat
+        is stopped for the range change. */
+      if (IsContinuous == TRUE)
+      {
+        MeasurementIndex -= ToneCount;
+        
+        if (is_range_better == TRUE)
+        {
+          EISCore_Stop();
+          
+          IsRangeChangePending = TRUE;
+        }
+      }
+      else if ((MeasurementIndex >= NumOfMeasurements) && (BiasStepIndex < BiasSweep.stepCount))
+      {
+        if (is_range_better == TRUE)
+        {
+          selectFBPath(NextFBPath);
+        }
+        
+        startBiasStep();
+      }
+      else if (MeasurementIndex >= NumOfMeasurements)
+      {
+        Board_HUBSPIDisable();
+        Board_ADCSPIDisable();
+        
+        // Set configuration to off.
+        Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
+        
+        // Stop submodules.
+        EISCore_Stop();
+        
+        // Turn off analog circuitry.
+        Board_TurnOffAnalog();
+        
+        // Call callback function, if it's set.
+        if (MeasurementCompletedDelegate != NULL)
+        {
+          MeasurementCompletedDelegate();
+        }
+        
+        State = EIS_STATE_READY;
+      }
+      else if (is_range_better == TRUE)
+      {
+        /* Core might have swapped in the next measurement, it's set up again in the
+          new range. */
+        EISCore_Stop();
+        
+        IsRangeChangePending = TRUE;
+      }
+      else if (EISCore_GetState() == EIS_CORE_STATE_OPERATING)
+      {
+        /* Core has swapped in the next measurement, prepare the one after. */
+        ToneCount = NextToneCount;
+        MeasAmplitudePP = NextMeasAmplitudePP;
+        
+        prepareNextCoreMeasurement();
+      }
+      else
+      { 
+        /* Setup for the next measurement of EIS core. */
+        setupCoreMeasurement();
+        
+        // Start new measurement. 
+        EISCore_Start();
+        
+        prepareNextCoreMeasurement();
+      }
+    }
+    Events ^= MEASUREMENT_COMPLETED_EVENT;
+  }
+}
+
+/***
+  * @Brief      Sets stop event.
+  */
+void EIS_Stop(void)
+{
+  Events |= STOP_EVENT;
+}
+
+                                    
+/***
+  * @Brief      Returns state of the module.
+  *
+  * @Return     State.
+  */
+EIS_State_t EIS_GetState(void)
+{
+  return State;
+}
+
+/***
+  * @Brief      Returns number of datapoints. It's calculated for the sweep.
+  */
+uint16_t EIS_GetDatapointCount(void)
+{
+  return NumOfMeasurements;
+}
+
+/***
+  * @Brief      Returns frequency of a datapoint, before the adjustment for the
+  *             coherent sampling.
+  *
+  * @Param      index->Index of the datapoint.
+  */
+double EIS_GetDatapointFrequency(uint16_t index)
+{
+  return getFrequency(index);
+}
+
+/***
+  * @Brief      Creates calibration profile. Uses eeprom emulator module.
+  *
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalibBuffReal-> Pointer to calibration profile real part.
+  * @Param      pCalibBuffImg-> Pointer to calibration profile imaginary part.
+  * @Param      datapointCount-> Number of datapoints.
+  */
+void EIS_CreateCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
+                                  double *pCalibBuffReal, double *pCalibBuffImg, 
+                                  uint16_t datapointCount)
+{
+  /* Check if the datapoint count is valid. */
+  if (datapointCount > (MAX_UINT16 / sizeof(double)))
+  {
+    ExceptionHandler_ThrowException("EIS module error when saving data to calibration \
+                                     profile.\n");
+  }
+  
+  /* Write calibration profile to ROM. */
+  EepromEmulator_WriteObject(eeObjectIdReal, (datapointCount * sizeof(double)),
+                             (uint8_t *)pCalibBuffReal);
+  
+  EepromEmulator_WriteObject(eeObjectIdImg, (datapointCount * sizeof(double)),
+                             (uint8_t *)pCalibBuffImg);                    
+}
+
+/***
+  * @Brief      Loads calibration profile.
+  *
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalibBuffReal-> Pointer to parsed calibration profile real part.
+  * @Param      pCalibBuffImg-> Pointer to parsed calibration profile imaginary part.
+  * @Param      pDatapointCount-> Pointer to return number of datapoints.
+  * 
+  * @Return     Profile found of not(TRUE of FALSE).
+  */
+uint8_t EIS_LoadCalibrationProfile(uint16_t eeObjectIdReal, uint16_t eeObjectIdImg,
+                                   double *pCalibBuffReal, double *pCalibBuffImg, 
+                                   uint16_t *pDatapointCount)
+{
+  uint8_t profile_real_found;
+  uint8_t profile_img_found;
+  uint16_t length_real;
+  uint16_t length_img;
+  uint8_t retval;
+  
+  /* Load calibration profiles. */
+  profile_real_found = EepromEmulator_ReadObject(eeObjectIdReal, 0U, (MAX_UINT16 / sizeof(double)), 
+                                                 &length_real, ((uint8_t *)pCalibBuffReal));
+  
+  profile_img_found = EepromEmulator_ReadObject(eeObjectIdImg, 0U, (MAX_UINT16 / sizeof(double)), 
+                                                 &length_img, ((uint8_t *)pCalibBuffImg));
+  
+  /* If everything is normal, calculate datapoint count and return TRUE. Otherwise
+    return false. */
+  if ((profile_real_found == TRUE) && (profile_img_found == TRUE) && (length_real == length_img))
+  {
+    *pDatapointCount = length_real / sizeof(double);
+    
+    retval = TRUE;
+  }
+  else
+  {
+    retval = FALSE;
+  }
+  
+  return retval;
+}
+                                    
+/***
+  * @Brief      Creates calibration profile with its frequencies. Uses eeprom
+  *             emulator module.
+  *
+  * @Param      eeObjectIdFreq-> EEPROM Emulator object id for frequencies.
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalib-> Pointer to calibration profile.
+  */
+void EIS_CreateCalibrationTable(uint16_t eeObjectIdFreq, uint16_t eeObjectIdReal,
+                                uint16_t eeObjectIdImg, EIS_Calib_t *pCalib)
+{
+  EIS_CreateCalibrationProfile(eeObjectIdReal, eeObjectIdImg, pCalib->pCalibReal,
+                               pCalib->pCalibImg, pCalib->datapointCount);
+  
+  EepromEmulator_WriteObject(eeObjectIdFreq, (pCalib->datapointCount * sizeof(double)),
+                             (uint8_t *)pCalib->pCalibFrequency);
+}
+
+/***
+  * @Brief      Loads calibration profile with its frequencies. Buffers of the
+  *             profile should be set.
+  *
+  * @Param      eeObjectIdFreq-> EEPROM Emulator object id for frequencies.
+  * @Param      eeObjectIdReal-> EEPROM Emulator object id for real part.
+  * @Param      eeObjectIdImg-> EEPROM Emulator object id for imaginary part.
+  * @Param      pCalib-> Pointer to calibration profile to be loaded.
+  *
+  * @Return     Profile found of not(TRUE of FALSE).
+  */
+uint8_t EIS_LoadCalibrationTable(uint16_t eeObjectIdFreq, uint16_t eeObjectIdReal,
+                                 uint16_t eeObjectIdImg, EIS_Calib_t *pCalib)
+{
+  uint16_t length_freq;
+  
+  if (EIS_LoadCalibrationProfile(eeObjectIdReal, eeObjectIdImg, pCalib->pCalibReal,
+                                 pCalib->pCalibImg, &pCalib->datapointCount) == FALSE)
+  {
+    return FALSE;
+  }
+  
+  if ((EepromEmulator_ReadObject(eeObjectIdFreq, 0U, (MAX_UINT16 / sizeof(double)),
+                                 &length_freq, ((uint8_t *)pCalib->pCalibFrequency)) == FALSE) || \
+      (length_freq != (pCalib->datapointCount * sizeof(double))))
+  {
+    return FALSE;
+  }
+  
+  return TRUE;
+}
+                                    
+/* Private functions ---------------------------------------------------------*/
+/***
+  * @Brief      Sets up EIS core for the measurement starting at the measurement
+  *             index. Consecutive frequencies are measured together as a multisine,
+  *             cycles of the lowest frequency tone is used.
+  */
+static void setupCoreMeasurement(void)
+{
+  EISCore_MeasParams_t eis_core;
+  float frequency_error;
+  
+  ToneCount = fillCoreMeasParams(MeasurementIndex, &eis_core);
+  MeasAmplitudePP = AmplitudePP;
+  
+  EISCore_Setup(&eis_core, &frequency_error);
+  checkFrequencyError(frequency_error);
+}
+
+/***
+  * @Brief      Sets up EIS core for the measurement after the current one, while
+  *             the current one is operating. So the sweep continues without dead
+  *             time between the frequencies.
+  */
+static void prepareNextCoreMeasurement(void)
+{
+  EISCore_MeasParams_t eis_core;
+  uint16_t next_index;
+  float frequency_error;
+  
+  next_index = MeasurementIndex + ToneCount;
+  
+  /* No measurement left. Continuous measurement is repeated by the core. Amplitude
+    schedule sets the next measurement up after the current one completes, since its
+    amplitude follows the response of the current one. */
+  if ((next_index >= NumOfMeasurements) || (IsContinuous == TRUE) || \
+      (IsAmplitudeScheduleEnabled == TRUE))
+  {
+    return;
+  }
+  
+  NextToneCount = fillCoreMeasParams(next_index, &eis_core);
+  NextMeasAmplitudePP = AmplitudePP;
+  
+  EISCore_SetupNext(&eis_core, &frequency_error);
+  checkFrequencyError(frequency_error);
+}
+
+/***
+  * @Brief      Fills EIS core measurement params for the measurement starting at
+  *             the given index.
+  *
+  * @Param      measurementIndex->Index of the first frequency.
+  * @Param      pCoreParams->Pointer to params to be filled.
+  *
+  * @Return     Number of tones. Last measurement might have fewer tones.
+  */
+static uint8_t fillCoreMeasParams(uint16_t measurementIndex, EISCore_MeasParams_t *pCoreParams)
+{
+  uint16_t lowest_index;
+  uint8_t tone_count;
+  
+  tone_count = getToneCount(measurementIndex);
+  lowest_index = getLowestFrequencyIndex(measurementIndex, tone_count);
+  
+  pCoreParams->toneCount = tone_count;
+  
+  for (uint8_t i = 0; i < tone_count; i++)
+  {
+    pCoreParams->frequency[i] = getFrequency(measurementIndex + i);
+  }
+  
+  pCoreParams->cycles = getCycles(lowest_index);
+  
+  /* Early termination, maximum cycles limits the measurement. Sweep allocates the
+    maximum cycles, and its minimum cycles are the lower limit. */
+  if ((pFrequency == NULL) && (TargetRelUncertainty > 0.0f))
+  {
+    pCoreParams->maxCycles = pCoreParams->cycles;
+    pCoreParams->cycles = Sweep.minCycles;
+    pCoreParams->targetRelUncertainty = TargetRelUncertainty;
+  }
+  else if (pMaxCycles != NULL)
+  {
+    pCoreParams->maxCycles = pMaxCycles[lowest_index];
+    pCoreParams->targetRelUncertainty = TargetRelUncertainty;
+  }
+  else
+  {
+    pCoreParams->maxCycles = pCoreParams->cycles;
+    pCoreParams->targetRelUncertainty = 0.0f;
+  }
+  
+  // Transient of the frequency change is excited but not accumulated.
+  pCoreParams->settleCycles = getSettleCycles(lowest_index);
+  
+  pCoreParams->signal_amp_pp_dac_code = (uint16_t)fabs(AmplitudePP / SignalDAC1LSBPotential);
+  pCoreParams->maxRelFreqError = MaxRelFreqError;
+  pCoreParams->isHarmonicsEnabled = (NewHarmonicsDelegate != NULL) ? TRUE : FALSE;
+  pCoreParams->window = Window;
+  pCoreParams->isDetrendEnabled = IsDetrendEnabled;
+  pCoreParams->measurementCompletedDelegate = measurementCompletedEventHandler;
+  pCoreParams->measurementAbortedDelegate = measurementAbortedEventHandler;
+  
+  return tone_count;
+}
+
+/***
+  * @Brief      Checks the frequency error achieved by the core. Core adjusts the
+  *             frequencies for coherent sampling. Zero limit accepts the closest
+  *             achievable frequency.
+  *
+  * @Param      frequencyError->Achieved relative frequency error.
+  */
+static void checkFrequencyError(float frequencyError)
+{
+  if ((MaxRelFreqError > 0.0f) && (frequencyError > MaxRelFreqError))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module frequency can't be generated within the error limit.\n");
+  }
+}
+
+/***
+  * @Brief      Reports harmonics of the current relative to the fundamental. Gain
+  *             and phase of the signal chain are common, so they cancel out.
+  *
+  * @Param      coreReal->Real part of the fundamental core result.
+  * @Param      coreImg->Imaginary part of the fundamental core result.
+  */
+static void reportHarmonics(double coreReal, double coreImg)
+{
+  double harm_real[2], harm_img[2];
+  double magnitude_square;
+  double real;
+  
+  magnitude_square = coreReal * coreReal + coreImg * coreImg;
+  
+  if (magnitude_square == 0.0)
+  {
+    return;
+  }
+  
+  for (uint8_t order = 2; order <= 3; order++)
+  {
+    if (EISCore_GetHarmonic(order, &harm_real[order - 2], &harm_img[order - 2]) == FALSE)
+    {
+      return;
+    }
+    
+    // Complex division by the fundamental.
+    real = (harm_real[order - 2] * coreReal + harm_img[order - 2] * coreImg) / magnitude_square;
+    harm_img[order - 2] = (harm_img[order - 2] * coreReal - harm_real[order - 2] * coreImg) / \
+      magnitude_square;
+    harm_real[order - 2] = real;
+  }
+  
+  NewHarmonicsDelegate(harm_real[0], harm_img[0], harm_real[1], harm_img[1]);
+}
+
+/***
+  * @Brief      Plans the log spaced sweep. Number of datapoints is calculated, so
+  *             the last one is at the stop frequency. Minimum cycles and settle
+  *             cycles are spent anyway, remaining time budget is shared equally
+  *             by the measurements.
+  */
+static void planSweep(void)
+{
+  double decades;
+  double points;
+  double overhead_time;
+  uint16_t num_of_core_measurements;
+  uint16_t lowest_index;
+  uint8_t tone_count;
+  
+  if ((Sweep.startFrequency <= 0.0f) || (Sweep.stopFrequency <= 0.0f) || \
+      (Sweep.pointsPerDecade <= 0.0f))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called with invalid sweep.\n");
+  }
+  
+  decades = log10(((double)Sweep.stopFrequency) / Sweep.startFrequency);
+  points = floor(fabs(decades) * Sweep.pointsPerDecade + 0.5) + 1;
+  
+  if (points > MAX_UINT16)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called with too many sweep points.\n");
+  }
+  
+  NumOfMeasurements = (uint16_t)points;
+  SweepLogStep = (NumOfMeasurements > 1) ? (decades / (NumOfMeasurements - 1)) : 0.0;
+  
+  /* Time spent with the minimum cycles and settle cycles. */
+  overhead_time = 0.0;
+  num_of_core_measurements = 0;
+  
+  for (uint16_t i = 0; i < NumOfMeasurements; i += tone_count)
+  {
+    tone_count = getToneCount(i);
+    lowest_index = getLowestFrequencyIndex(i, tone_count);
+    
+    overhead_time += (Sweep.minCycles + getSettleCycles(lowest_index)) / \
+      getFrequency(lowest_index);
+    num_of_core_measurements++;
+  }
+  
+  SweepExtraTime = 0.0;
+  if (Sweep.timeBudget > overhead_time)
+  {
+    SweepExtraTime = (Sweep.timeBudget - overhead_time) / num_of_core_measurements;
+  }
+}
+
+/***
+  * @Brief      Returns number of tones of the measurement starting at the given
+  *             index. Last measurement might have fewer tones.
+  *
+  * @Param      measurementIndex->Index of the first frequency.
+  */
+static uint8_t getToneCount(uint16_t measurementIndex)
+{
+  uint8_t tone_count = TonesPerMeasurement;
+  
+  if ((NumOfMeasurements - measurementIndex) < tone_count)
+  {
+    tone_count = (uint8_t)(NumOfMeasurements - measurementIndex);
+  }
+  
+  return tone_count;
+}
+
+/***
+  * @Brief      Returns index of the lowest frequency tone of a measurement.
+  *
+  * @Param      measurementIndex->Index of the first frequency.
+  * @Param      toneCount->Number of tones.
+  */
+static uint16_t getLowestFrequencyIndex(uint16_t measurementIndex, uint8_t toneCount)
+{
+  uint16_t lowest_index = measurementIndex;
+  
+  for (uint8_t i = 1; i < toneCount; i++)
+  {
+    if (getFrequency(measurementIndex + i) < getFrequency(lowest_index))
+    {
+      lowest_index = measurementIndex + i;
+    }
+  }
+  
+  return lowest_index;
+}
+
+/***
+  * @Brief      Returns frequency of a datapoint. Sweep frequency is calculated.
+  *
+  * @Param      index->Index of the datapoint.
+  */
+static double getFrequency(uint16_t index)
+{
+  if (pFrequency != NULL)
+  {
+    return pFrequency[index];
+  }
+  
+  return (Sweep.startFrequency * pow(10.0, index * SweepLogStep));
+}
+
+/***
+  * @Brief      Returns cycles of a datapoint. Sweep cycles are allocated from the
+  *             time budget.
+  *
+  * @Param      index->Index of the datapoint.
+  */
+static uint32_t getCycles(uint16_t index)
+{
+  if (pFrequency != NULL)
+  {
+    return pCycles[index];
+  }
+  
+  return (Sweep.minCycles + (uint32_t)(SweepExtraTime * getFrequency(index)));
+}
+
+/***
+  * @Brief      Returns settle cycles of a datapoint. Derived settle period is a
+  *             number of cell time constants.
+  *
+  * @Param      index->Index of the datapoint.
+  */
+static uint32_t getSettleCycles(uint16_t index)
+{
+  if (pSettleCycles != NULL)
+  {
+    return pSettleCycles[index];
+  }
+  
+  return (uint32_t)ceil(EIS_SETTLE_TIME_CONSTANTS * CellTimeConstant * getFrequency(index));
+}
+
+/***
+  * @Brief      Returns bias potential of a bias step.
+  *
+  * @Param      stepIndex->Index of the bias step.
+  */
+static float getBiasPotential(uint16_t stepIndex)
+{
+  if (BiasSweep.stepCount == 0)
+  {
+    return BiasPotential;
+  }
+  
+  return (BiasPotential + (BiasSweep.stopPotential - BiasPotential) * stepIndex / \
+    BiasSweep.stepCount);
+}
+
+/***
+  * @Brief      Writes the Bias DAC code. HUB SPI is left configured for the Bias DAC.
+  *
+  * @Param      dacCode->Bias DAC code.
+  */
+static void writeBiasDACCode(uint16_t dacCode)
+{
+  Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_BIAS);
+  Board_HUBSPIEnable();
+  
+  Board_DACBiasResetnLDAC();
+  Board_DACBiasResetnCS();
+  Board_HUBSPISend(dacCode);
+  while (Board_HUBSPIIsBusy());
+  Board_DACBiasSetnCS();
+  Board_DACBiasSetnLDAC();
+}
+
+/***
+  * @Brief      Steps the bias to the next potential. Excitation and scaling setup
+  *             is kept, only the bias is changed. Measurements are started after
+  *             the settle period of the step, instead of the equilibrium period.
+  */
+static void startBiasStep(void)
+{
+  AlarmClock_Req_t alarm;
+  uint32_t settle_period;
+  float potential;
+  
+  potential = getBiasPotential(BiasStepIndex + 1);
+  settle_period = Board_GetDACBiasSettlePeriod(potential - getBiasPotential(BiasStepIndex), 
+                                               EIS_BIAS_SETTLE_RESIDUAL);
+  BiasStepIndex++;
+  
+  writeBiasDACCode((uint16_t)(VGND_DAC_CODE_LF + potential / \
+    Board_GetBiasDAC1LSBAppliedPotential()));
+  
+  // Signal DAC is serviced by the core.
+  Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_SIGNAL);
+  Board_HUBSPIEnable();
+  
+  /* Core still has the plan of the single measurement. Otherwise the first one
+    is set up again. */
+  MeasurementIndex = 0;
+  
+  if (getToneCount(0) < NumOfMeasurements)
+  {
+    setupCoreMeasurement();
+  }
+  
+  IsBiasSettling = (BiasSweep.maxSettleRepeats > 0) ? TRUE : FALSE;
+  SettleRepeatCount = 0;
+  
+  /* Set alarm. Equilibrium handler starts the measurement. */
+  alarm.period = (settle_period * SYS_TICK_FREQ + 999U) / 1000U;
+  
+  if (alarm.period == 0)
+  {
+    alarm.period = 1;
+  }
+  
+  alarm.timerExpCB = equilibriumPeriodElapsedEventHandler;
+  AlarmClock_SetAlarm(&alarm);
+  
+  State = EIS_STATE_OPERATING_EQUILIBRIUM;
+}
+
+/***
+  * @Brief      Checks whether the cell has settled to the bias step. Impedance of
+  *             the first measurement is compared with its previous repetition.
+  *
+  * @Return     TRUE if settled or the repeat limit is reached, FALSE otherwise.
+  */
+static uint8_t isBiasSettled(void)
+{
+  double core_real, core_img;
+  double imp_real, imp_img;
+  double magnitude;
+  
+  EISCore_GetResult(0, &core_real, &core_img);
+  calculateImpedance(ADC1LSBCurrent, MeasAmplitudePP, core_real, core_img,
+                     &imp_real, &imp_img);
+  magnitude = sqrt(imp_real * imp_real + imp_img * imp_img);
+  
+  if (((SettleRepeatCount > 0) && \
+       (fabs(magnitude - SettleImpedance) <= (BiasSweep.settleTolerance * magnitude))) || \
+      (SettleRepeatCount >= BiasSweep.maxSettleRepeats))
+  {
+    IsBiasSettling = FALSE;
+    
+    return TRUE;
+  }
+  
+  SettleImpedance = magnitude;
+  SettleRepeatCount++;
+  
+  return FALSE;
+}
+
+/***
+  * @Brief      Selects the TIA feedback path, with its current scaling and its
+  *             calibration in auto range. HUB SPI is left configured for the TIA.
+  *
+  * @Param      fbPath->Feedback path.
+  */
+static void selectFBPath(Board_TIAFBPath_t fbPath)
+{
+  FBPath = fbPath;
+  ADC1LSBCurrent = Board_GetADC1LSBCurrent(FBPath);
+  
+  pActiveCalib = (IsAutoRangeEnabled == TRUE) ? &RangeCalib[FBPath] : &Calib;
+  
+  Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_TIA);
+  Board_HUBSPIEnable();
+  
+  Board_TIAResetnLATCH();
+  Board_TIAResetnCS();
+  Board_TIASelectFBPath(FBPath);
+  Board_TIASetnCS();
+  Board_TIASetnLATCH();
+}
+
+/***
+  * @Brief      Checks whether the completed measurement is clipped, and it can be
+  *             taken again in the lower range. Clipped peak isn't known, so the
+  *             range is stepped. Retries are limited.
+  *
+  * @Return     TRUE if the measurement should be taken again in the lower range.
+  */
+static uint8_t isRangeChangeNeeded(void)
+{
+  if ((((double)EISCore_GetPeak()) < RANGE_CLIP_LIMIT) || (FBPath == BOARD_TIA_FB_PATH_0) || \
+      (RangeRetryCount >= RANGE_MAX_RETRIES))
+  {
+    RangeRetryCount = 0;
+    
+    return FALSE;
+  }
+  
+  NextFBPath = (Board_TIAFBPath_t)(FBPath - 1);
+  RangeRetryCount++;
+  
+  return TRUE;
+}
+
+/***
+  * @Brief      Selects the highest feedback path which keeps the predicted peak of
+  *             the completed measurement below the target. Peak is predicted to
+  *             scale with the feedback resistance.
+  *
+  * @Return     TRUE if it's a higher path, which is then the next path.
+  */
+static uint8_t isBetterRangeAvailable(void)
+{
+  Board_TIAFBPath_t path;
+  double peak;
+  double resistance;
+  
+  peak = (double)EISCore_GetPeak();
+  resistance = Board_TIAGetFBResistor(FBPath);
+  path = FBPath;
+  
+  while ((path < BOARD_TIA_FB_PATH_5) && \
+         ((peak * Board_TIAGetFBResistor((Board_TIAFBPath_t)(path + 1)) / resistance) < \
+          RANGE_TARGET_LIMIT))
+  {
+    path = (Board_TIAFBPath_t)(path + 1);
+  }
+  
+  if (path == FBPath)
+  {
+    return FALSE;
+  }
+  
+  NextFBPath = path;
+  
+  return TRUE;
+}
+
+/***
+  * @Brief      Checks the calibration profile. Frequencies should be ascending for
+  *             the interpolation.
+  *
+  * @Param      pCalib->Pointer to calibration profile.
+  */
+static void checkCalibration(EIS_Calib_t *pCalib)
+{
+  /* Three terms need all of the standards. */
+  if ((pCalib->pCoeff != NULL) && \
+      ((pCalib->pCalibReal == NULL) || (pCalib->pCalibImg == NULL) || \
+       (pCalib->pOpenReal == NULL) || (pCalib->pOpenImg == NULL) || \
+       (pCalib->pShortReal == NULL) || (pCalib->pShortImg == NULL) || \
+       (pCalib->datapointCount == 0)))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called with incomplete three term calibration.\n");
+  }
+  
+  if ((pCalib->pCalibFrequency == NULL) || (pCalib->pCalibReal == NULL) || \
+      (pCalib->pCalibImg == NULL))
+  {
+    return;
+  }
+  
+  if (pCalib->datapointCount == 0)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module setup function called with empty calibration profile.\n");
+  }
+  
+  for (uint16_t i = 1; i < pCalib->datapointCount; i++)
+  {
+    if (pCalib->pCalibFrequency[i] <= pCalib->pCalibFrequency[i - 1])
+    {
+      ExceptionHandler_ThrowException(\
+        "EIS module setup function called with unordered calibration frequencies.\n");
+    }
+  }
+}
+
+/***
+  * @Brief      Returns calibration measurement of a datapoint. Profile with the
+  *             frequencies is interpolated, and it's held constant outside its range.
+  *
+  * @Param      index->Index of the datapoint.
+  * @Param      pCalibReal->Pointer to return real part.
+  * @Param      pCalibImg->Pointer to return imaginary part.
+  */
+static void getCalibration(uint16_t index, double *pCalibReal, double *pCalibImg)
+{
+  double log_frequency;
+  double log_magnitude, phase;
+  
+  if (pActiveCalib->pCalibFrequency == NULL)
+  {
+    *pCalibReal = pActiveCalib->pCalibReal[index];
+    *pCalibImg = pActiveCalib->pCalibImg[index];
+    
+    return;
+  }
+  
+  if (pActiveCalib->datapointCount == 1)
+  {
+    *pCalibReal = pActiveCalib->pCalibReal[0];
+    *pCalibImg = pActiveCalib->pCalibImg[0];
+    
+    return;
+  }
+  
+  log_frequency = locateCalibSegment(index);
+  
+  log_magnitude = CalibSegment.logMagnitude + CalibSegment.logMagnitudeSlope * \
+    (log_frequency - CalibSegment.logFrequencyLow);
+  phase = CalibSegment.phase + CalibSegment.phaseSlope * \
+    (log_frequency - CalibSegment.logFrequencyLow);
+  
+  *pCalibReal = exp(log_magnitude) * cos(phase);
+  *pCalibImg = exp(log_magnitude) * sin(phase);
+}
+
+/***
+  * @Brief      Locates the calibration segment of a datapoint. Profile should have
+  *             the frequencies, and more than one datapoint.
+  *
+  * @Param      index->Index of the datapoint.
+  *
+  * @Return     Log frequency of the datapoint, limited to the profile.
+  */
+static double locateCalibSegment(uint16_t index)
+{
+  double log_frequency;
+  
+  log_frequency = log(getFrequency(index));
+  
+  if ((CalibSegment.pCalib != pActiveCalib) || (log_frequency < CalibSegment.coverLow) || \
+      (log_frequency > CalibSegment.coverHigh))
+  {
+    planCalibSegment(log_frequency);
+  }
+  
+  /* Constant outside the profile. */
+  if (log_frequency < CalibSegment.logFrequencyLow)
+  {
+    log_frequency = CalibSegment.logFrequencyLow;
+  }
+  else if (log_frequency > CalibSegment.logFrequencyHigh)
+  {
+    log_frequency = CalibSegment.logFrequencyHigh;
+  }
+  
+  return log_frequency;
+}
+
+/***
+  * @Brief      Finds the calibration segment of the frequency, and calculates its
+  *             log magnitude and phase lines. Phase difference is unwrapped.
+  *
+  * @Param      logFrequency->Natural logarithm of the frequency.
+  */
+static void planCalibSegment(double logFrequency)
+{
+  uint16_t low, high, middle;
+  double magnitude_low, magnitude_high;
+  double phase_low, phase_high;
+  double span;
+  
+  /* Binary search of the segment, it's the first or the last outside the profile. */
+  low = 0;
+  high = pActiveCalib->datapointCount - 1;
+  
+  while ((high - low) > 1)
+  {
+    middle = (low + high) / 2;
+    
+    if (log(pActiveCalib->pCalibFrequency[middle]) <= logFrequency)
+    {
+      low = middle;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  
+  magnitude_low = sqrt(pActiveCalib->pCalibReal[low] * pActiveCalib->pCalibReal[low] + \
+    pActiveCalib->pCalibImg[low] * pActiveCalib->pCalibImg[low]);
+  magnitude_high = sqrt(pActiveCalib->pCalibReal[high] * pActiveCalib->pCalibReal[high] + \
+    pActiveCalib->pCalibImg[high] * pActiveCalib->pCalibImg[high]);
+  
+  if ((magnitude_low == 0.0) || (magnitude_high == 0.0))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module calibration measurement data is invalid.");
+  }
+  
+  phase_low = atan2(pActiveCalib->pCalibImg[low], pActiveCalib->pCalibReal[low]);
+  phase_high = atan2(pActiveCalib->pCalibImg[high], pActiveCalib->pCalibReal[high]);
+  
+  if ((phase_high - phase_low) > M_PI)
+  {
+    phase_high -= 2.0 * M_PI;
+  }
+  else if ((phase_high - phase_low) < -M_PI)
+  {
+    phase_high += 2.0 * M_PI;
+  }
+  
+  CalibSegment.pCalib = pActiveCalib;
+  CalibSegment.indexLow = low;
+  CalibSegment.indexHigh = high;
+  CalibSegment.logFrequencyLow = log(pActiveCalib->pCalibFrequency[low]);
+  CalibSegment.logFrequencyHigh = log(pActiveCalib->pCalibFrequency[high]);
+  CalibSegment.coverLow = (low == 0) ? -HUGE_VAL : CalibSegment.logFrequencyLow;
+  CalibSegment.coverHigh = (high == (pActiveCalib->datapointCount - 1)) ? \
+    HUGE_VAL : CalibSegment.logFrequencyHigh;
+  
+  span = CalibSegment.logFrequencyHigh - CalibSegment.logFrequencyLow;
+  
+  CalibSegment.logMagnitude = log(magnitude_low);
+  CalibSegment.logMagnitudeSlope = (log(magnitude_high) - CalibSegment.logMagnitude) / span;
+  CalibSegment.phase = phase_low;
+  CalibSegment.phaseSlope = (phase_high - phase_low) / span;
+}
+
+/***
+  * @Brief      Calculates the three term coefficients of every calibration datapoint.
+  *             Z = Zl * (Zm - Zs) * (Zo - Zlm) / ((Zlm - Zs) * (Zo - Zm)), where Zlm
+  *             is the measured load, which gives A = K / Zo, B = -A * Zs and
+  *             C = -1 / Zo with K = Zl * (Zo - Zlm) / (Zlm - Zs).
+  *
+  * @Param      pCalib->Pointer to calibration profile.
+  */
+static void calculateCalibCoefficients(EIS_Calib_t *pCalib)
+{
+  double k_real, k_img;
+  double num_real, num_img;
+  double den_real, den_img;
+  EIS_CalibCoeff_t *p_coeff;
+  
+  if (pCalib->pCoeff == NULL)
+  {
+    return;
+  }
+  
+  for (uint16_t i = 0; i < pCalib->datapointCount; i++)
+  {
+    p_coeff = &pCalib->pCoeff[i];
+    
+    den_real = pCalib->pCalibReal[i] - pCalib->pShortReal[i];
+    den_img = pCalib->pCalibImg[i] - pCalib->pShortImg[i];
+    
+    if (((den_real == 0.0) && (den_img == 0.0)) || \
+        ((pCalib->pOpenReal[i] == 0.0) && (pCalib->pOpenImg[i] == 0.0)))
+    {
+      ExceptionHandler_ThrowException(\
+        "EIS module calibration measurement data is invalid.");
+    }
+    
+    multiplyComplex(CALIB_ELEMENT_REAL, CALIB_ELEMENT_IMG,
+                    pCalib->pOpenReal[i] - pCalib->pCalibReal[i],
+                    pCalib->pOpenImg[i] - pCalib->pCalibImg[i], &num_real, &num_img);
+    divideComplex(num_real, num_img, den_real, den_img, &k_real, &k_img);
+    
+    divideComplex(k_real, k_img, pCalib->pOpenReal[i], pCalib->pOpenImg[i],
+                  &p_coeff->aReal, &p_coeff->aImg);
+    multiplyComplex(-p_coeff->aReal, -p_coeff->aImg, pCalib->pShortReal[i],
+                    pCalib->pShortImg[i], &p_coeff->bReal, &p_coeff->bImg);
+    divideComplex(-1.0, 0.0, pCalib->pOpenReal[i], pCalib->pOpenImg[i],
+                  &p_coeff->cReal, &p_coeff->cImg);
+  }
+}
+
+/***
+  * @Brief      Applies the three term correction to the measured impedance.
+  *
+  * @Param      index->Index of the datapoint.
+  * @Param      pReal->Pointer to the real part, it's corrected in place.
+  * @Param      pImg->Pointer to the imaginary part, it's corrected in place.
+  *
+  * @Return     Error scale, which is the change of the corrected impedance per
+  *             relative change of the measured impedance.
+  */
+static double correctThreeTerms(uint16_t index, double *pReal, double *pImg)
+{
+  EIS_CalibCoeff_t coeff;
+  EIS_CalibCoeff_t *p_low, *p_high;
+  double ratio;
+  double num_real, num_img;
+  double den_real, den_img;
+  double der_real, der_img;
+  double den_square;
+  
+  if (pActiveCalib->pCalibFrequency == NULL)
+  {
+    coeff = pActiveCalib->pCoeff[index];
+  }
+  else if (pActiveCalib->datapointCount == 1)
+  {
+    coeff = pActiveCalib->pCoeff[0];
+  }
+  else
+  {
+    ratio = (locateCalibSegment(index) - CalibSegment.logFrequencyLow) / \
+      (CalibSegment.logFrequencyHigh - CalibSegment.logFrequencyLow);
+    
+    p_low = &pActiveCalib->pCoeff[CalibSegment.indexLow];
+    p_high = &pActiveCalib->pCoeff[CalibSegment.indexHigh];
+    
+    coeff.aReal = p_low->aReal + ratio * (p_high->aReal - p_low->aReal);
+    coeff.aImg = p_low->aImg + ratio * (p_high->aImg - p_low->aImg);
+    coeff.bReal = p_low->bReal + ratio * (p_high->bReal - p_low->bReal);
+    coeff.bImg = p_low->bImg + ratio * (p_high->bImg - p_low->bImg);
+    coeff.cReal = p_low->cReal + ratio * (p_high->cReal - p_low->cReal);
+    coeff.cImg = p_low->cImg + ratio * (p_high->cImg - p_low->cImg);
+  }
+  
+  /* Numerator and denominator are complex multiply-adds. */
+  num_real = coeff.aReal * (*pReal) - coeff.aImg * (*pImg) + coeff.bReal;
+  num_img = coeff.aReal * (*pImg) + coeff.aImg * (*pReal) + coeff.bImg;
+  den_real = coeff.cReal * (*pReal) - coeff.cImg * (*pImg) + 1.0;
+  den_img = coeff.cReal * (*pImg) + coeff.cImg * (*pReal);
+  
+  /* Derivative is (A - B * C) / (C * Zm + 1)^2, scaled by the measured magnitude. */
+  der_real = coeff.aReal - (coeff.bReal * coeff.cReal - coeff.bImg * coeff.cImg);
+  der_img = coeff.aImg - (coeff.bReal * coeff.cImg + coeff.bImg * coeff.cReal);
+  den_square = den_real * den_real + den_img * den_img;
+  
+  if (den_square == 0.0)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module measured impedance is at the open calibration.");
+  }
+  
+  ratio = sqrt(((der_real * der_real + der_img * der_img) * \
+    ((*pReal) * (*pReal) + (*pImg) * (*pImg)))) / den_square;
+  
+  divideComplex(num_real, num_img, den_real, den_img, pReal, pImg);
+  
+  return ratio;
+}
+
+/***
+  * @Brief      Multiplies complex numbers.
+  */
+static void multiplyComplex(double aReal, double aImg, double bReal, double bImg,
+                            double *pReal, double *pImg)
+{
+  double real;
+  
+  real = aReal * bReal - aImg * bImg;
+  *pImg = aReal * bImg + aImg * bReal;
+  *pReal = real;
+}
+
+/***
+  * @Brief      Divides complex numbers. Divisor shouldn't be zero.
+  */
+static void divideComplex(double aReal, double aImg, double bReal, double bImg,
+                          double *pReal, double *pImg)
+{
+  double magnitude_square;
+  double real;
+  
+  magnitude_square = bReal * bReal + bImg * bImg;
+  
+  real = (aReal * bReal + aImg * bImg) / magnitude_square;
+  *pImg = (aImg * bReal - aReal * bImg) / magnitude_square;
+  *pReal = real;
+}
+
+/***
+  * @Brief      Checks whether the completed measurement is clipped, and it can be
+  *             taken again with a smaller amplitude. Retries are limited.
+  *
+  * @Return     TRUE if the measurement should be taken again.
+  */
+static uint8_t isAmplitudeRetryNeeded(void)
+{
+  if ((IsAmplitudeScheduleEnabled == FALSE) || (IsContinuous == TRUE) || \
+      (((double)EISCore_GetPeak()) < RANGE_CLIP_LIMIT) || (MeasAmplitudePP <= MinAmplitudePP) || \
+      (AmplitudeRetryCount >= AMPLITUDE_MAX_RETRIES))
+  {
+    AmplitudeRetryCount = 0;
+    
+    return FALSE;
+  }
+  
+  AmplitudeRetryCount++;
+  
+  return TRUE;
+}
+
+/***
+  * @Brief      Chooses the amplitude of the following measurements from the peak
+  *             ADC code of the completed measurement. High impedance gets larger
+  *             amplitude for SNR, and the response near the saturation gets smaller.
+  */
+static void updateAmplitude(void)
+{
+  double peak;
+  double ratio;
+  
+  peak = (double)EISCore_GetPeak();
+  
+  if (peak < 1.0)
+  {
+    peak = 1.0;
+  }
+  
+  ratio = AMPLITUDE_TARGET_PEAK / peak;
+  
+  if (ratio > AMPLITUDE_MAX_STEP_RATIO)
+  {
+    ratio = AMPLITUDE_MAX_STEP_RATIO;
+  }
+  else if (ratio < (1.0 / AMPLITUDE_MAX_STEP_RATIO))
+  {
+    ratio = 1.0 / AMPLITUDE_MAX_STEP_RATIO;
+  }
+  
+  AmplitudePP = (float)(MeasAmplitudePP * ratio);
+  
+  if (AmplitudePP > MaxAmplitudePP)
+  {
+    AmplitudePP = MaxAmplitudePP;
+  }
+  else if (AmplitudePP < MinAmplitudePP)
+  {
+    AmplitudePP = MinAmplitudePP;
+  }
+}
+
+/***
+  * @Brief      Callback function which is triggered when the equilibrium period 
+  *             is elapsed.
+  */
+static void equilibriumPeriodElapsedEventHandler(void)
+{
+  // Set event flag.
+  Events |= EQUILIBRIUM_PERIOD_ELAPSED_EVENT;
+}
+
+/***
+  * @Brief      Callback function which is triggered when the measurement is 
+  *             completed.
+  */
+static void measurementCompletedEventHandler(void)
+{
+  // Set event flag.
+  Events |= MEASUREMENT_COMPLETED_EVENT;
+}
+
+/***
+  * @Brief      Callback function which is triggered when the core aborts the
+  *             measurement.
+  */
+static void measurementAbortedEventHandler(void)
+{
+  // Set event flag.
+  Events |= MEASUREMENT_ABORTED_EVENT;
+}
+
+/***
+  * @Brief      Determines optimum SNR dynamic scaling.
+  *
+  * @Param      amplitudePP-> Signal amplitude peak to peak, in units of volts.
+  * @Param      pDAC1LSBPotential-> Pointer to DAC 1LSB potential.
+  * @Param      pDynamicScaling-> Pointer to return dynamic scaling.
+  * @Param      pBinaryScaling-> Binary scaling option.
+  * @Param      pDecimalScaling-> Decimal scaling option.
+  */
+static void determineDynamicSignalScaling(float amplitudePP, double *pDAC1LSBPotential,
+                                          Board_BinarySignalScaling_t *pBinaryScaling,
+                                          Board_DecimalSignalScaling_t *pDecimalScaling)
+{
+  double dac1lsb_potential;
+  
+  const Board_BinarySignalScaling_t BinaryScalingTable[] = \
+  {BOARD_BINARY_SIGNAL_SCALING_1_4, BOARD_BINARY_SIGNAL_SCALING_2_4, 
+   BOARD_BINARY_SIGNAL_SCALING_3_4, BOARD_BINARY_SIGNAL_SCALING_4_4};
+
+  const Board_DecimalSignalScaling_t DecimalScalingTable[] = \
+  {BOARD_DECIMAL_SIGNAL_SCALING_1_100, BOARD_DECIMAL_SIGNAL_SCALING_1_10,
+   BOARD_DECIMAL_SIGNAL_SCALING_1_1};
+
+  /* Decision loop. Algorithm tries the smallest range to the biggest range, if the amplitude
+    fits into the range. If it fits, records the scaling options and the value, then returns. */
+  for (uint8_t i = 0; i < sizeof(DecimalScalingTable) / sizeof(DecimalScalingTable[0]); i++)
+  {
+    for (uint8_t j = 0; j < sizeof(BinaryScalingTable) / sizeof(BinaryScalingTable[0]); j++)
+    {
+      dac1lsb_potential = Board_GetSignalDAC1LSBAppliedPotential(BinaryScalingTable[j], 
+                                                                 DecimalScalingTable[i]);
+        
+      /* Check if DAC range is sufficient for this scaling*/
+      if ((((double)MAX_UINT16) / SIGNAL_RANGE_SAFETY_FACTOR) >= fabs(amplitudePP / dac1lsb_potential))
+      {
+        *pDecimalScaling = DecimalScalingTable[i];
+        *pBinaryScaling = BinaryScalingTable[j];
+        *pDAC1LSBPotential = dac1lsb_potential;
+          
+        return;
+      } // end of if.
+    } // end of for 2.
+  } // end of for 1.
+} // end of function.
+
+/***
+  * @Brief      Calculates impedance in units of kilo-ohms.
+  *
+  * @Param      adc1LSBCurrent->1 LSB Current of the ADC in units of microamps.
+  * @Param      signalAmpPP->Peak to peak signal amplitude in units of volts.
+  * @Param      xAvr->Weighted average X parsed from the EIS core.
+  * @Param      yAvr->Weigthed average Y parsed from the EIS core.
+  * @Param      pReal->Pointer to impedance real component.
+  * @Param      pImg->Pointer to impedance imaginary component.
+  */
+static void calculateImpedance(double adc1LSBCurrent, double signalAmpPP, double xAvr,
+                               double yAvr, double *pReal, double *pImaginary)
+{
+  double current_x;
+  double current_y;
+  
+  /* To prevent loss of precision during calculation, cast SumX and SumY to double. */
+  /* Transform SumX, SumY to current_sum_x, current_. */
+  current_x = 2.0 * adc1LSBCurrent * yAvr * 0.001;
+  current_y = 2.0 * adc1LSBCurrent * xAvr * 0.001;
+  
+  /* Calculate impedance. */
+  *pReal = (float)(signalAmpPP * 0.5f * current_x) / \
+    (current_x * current_x + current_y * current_y);
+  
+  *pImaginary = (float)(-signalAmpPP * 0.5f * current_y) / \
+    (current_x * current_x + current_y * current_y);
+}
+                                    
+/***
+  * @Brief      Process raw measurement. Calibration measurement is used as reference.
+  */
+static void subtractOffset(double calibMeasReal, double calibMeasImg, double rawMeasReal, double rawMeasImg,
+                           double *pMeasReal, double *pMeasImg)
+{
+  double calib_mult_real;
+  double calib_mult_img;
+  
+  /* Check if the calibration measurement is valid. */
+  if ((calibMeasReal == 0.0) && (calibMeasImg == 0.0))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS module calibration measurement data is invalid.");
+  }
+    
+  /* Calculate calibration multiplier. Which equals to calibElement / calibMeas in 
+    complex number system. */
+  calib_mult_real = (CALIB_ELEMENT_REAL * calibMeasReal + CALIB_ELEMENT_IMG * calibMeasImg) / \
+    (calibMeasReal * calibMeasReal + calibMeasImg * calibMeasImg);
+  
+  calib_mult_img = (CALIB_ELEMENT_IMG * calibMeasReal - CALIB_ELEMENT_REAL * calibMeasImg) / \
+    (calibMeasReal * calibMeasReal + calibMeasImg * calibMeasImg);
+  
+  /* Calculate measurement results. */
+  *pMeasReal = rawMeasReal * calib_mult_real - rawMeasImg * calib_mult_img;
+  *pMeasImg = rawMeasImg * calib_mult_real + rawMeasReal * calib_mult_img;
+}
+ 
                                     
\ No newline at end of file
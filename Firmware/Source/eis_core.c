@@ -1,367 +1,2171 @@
-/**
-  * @author     Onur Efe
-  */
-
-#include <math.h>
-#include "board.h"
-#include "eis_core.h"
-#include "middlewares.h"
-#include "generic.h"
-    
-/* Prequisities --------------------------------------------------------------*/
-/*
-  This module is critical in some ways. Overhead to the EISCore_MicroSchedulerTickISR
-  function should be minimum. Other way, the program will crash, because of the
-  interrupt function operation shouldn't be completed. So, the measurement results will
-  be errorenous. Such an error wouldn't be detected because a detection mechanism 
-  also would cause an overhead.
-  Besides this, microscheduler timer frequency and microscheduler prescaler range
-  is defined in this module. Any timer shouldn't be used by any other module. 
-*/
-
-/* Private definitions -------------------------------------------------------*/
-#define VGND_DAC_CODE_FL                        ((float)(MAX_UINT16 + 1) / 2)
-#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
-
-#define TICK_FREQUENCY                          ((double)400000.0)
-#define TICK_PERIOD                             ((double)1 / TICK_FREQUENCY)
-#define TIM_PRESCALER                           0U
-#define TIM_RELOAD                              210
-    
-#define SUBSAMPLING_NUMBER                      65536            // Should be even number.
-#define SUBSAMPLING_MASK                        0x8000FFFF                    
-
-#define START_EVENT                             0x01
-#define SAMPLING_EVENT                          0x02
-#define STOP_EVENT                              0x04
-
-/* Private function prototypes -----------------------------------------------*/
-static inline void rotatePhasor(float *pX, float *pY, float xr, float yr);
-
-/* Private variables ---------------------------------------------------------*/
-/* Measurement state. */
-static EISCore_State_t  State = EIS_CORE_STATE_UNINIT;
-static uint8_t          Events;
-static uint8_t          IsLocked = FALSE;
-
-/* Store variables. */
-EISCore_MeasurementCompletedDelegate_t  MeasurementCompletedDelegate;
-
-static uint32_t         LeapTicks;
-static uint32_t         NumOfSubSamples;
-static float            AmplitudeCoeff;
-
-static float            PhasorBaseXStart;
-static float            PhasorBaseYStart;
-
-/* Modified variables. */
-static volatile float   ConversionValue;
-
-static float            PhasorX, PhasorY;
-static float            PhasorBaseX, PhasorBaseY;
-
-static float            MicroRotX, MicroRotY;
-static float            MacroRotX, MacroRotY;
-
-static float            SubSumX, SubSumY;
-static volatile float   SampleX, SampleY;
-static double           SumX, SumY;
-
-static uint32_t         TickCounter;
-static uint32_t         SubSampleCounter;
-
-
-/* Exported functions --------------------------------------------------------*/
-/***
-  * @Brief      ISR routine for timer interrupt. Should be called with minimum 
-  *             overhead. 
-  */
-void EISCore_TimerTickISR(void)
-{
-  if ((State != EIS_CORE_STATE_OPERATING) || (IsLocked == TRUE))
-  {
-    return;
-  }
-    
-  Board_DACSignalSetnCS();
-  
-  /* Get last conversion result. */
-  ConversionValue = (float)Board_ADCGetValue();
-
-  SubSumX += (ConversionValue * PhasorX);
-  SubSumY += (ConversionValue * PhasorY);
-  
-  Board_DACSignalResetnCS();            // Frame signal DAC data.
-  
-  // Generate DAC code and set it to DAC.
-  SPI_I2S_SendDataOpt(HUB_SPI, ((uint16_t)(VGND_DAC_CODE_FL + PhasorY * AmplitudeCoeff)));
-  
-  // Trigger next conversion.
-  Board_ADCTriggerConvert();
-  
-  // Rotate phasor.
-  rotatePhasor(&PhasorX, &PhasorY, MicroRotX, MicroRotY);
-  
-  /* Check for subsampling instant */
-  if ((++TickCounter & SUBSAMPLING_MASK) == 0)
-  {
-    SampleX = SubSumX;
-    SampleY = SubSumY;
-    
-    PhasorX = PhasorBaseX;
-    PhasorY = PhasorBaseY;
-    
-    SubSumX = 0.0f;
-    SubSumY = 0.0f;
-    
-    Events |= SAMPLING_EVENT;                   // Set sampling event.
-  }
-}
-
-/***
-  * @Brief      Setup function of the EIS core. Function should called before any
-  *             other operation.
-  *
-  * @Param      pMeasParams->Pointer to measurement params struct.
-  */
-void EISCore_Setup(EISCore_MeasParams_t *pMeasParams)
-{
-  double total_measurement_time;
-  double subsampling_period = (((double)SUBSAMPLING_NUMBER) / TICK_FREQUENCY);
-  
-  /* Check state. */
-  if (State == EIS_CORE_STATE_OPERATING)
-  {
-    ExceptionHandler_ThrowException(\
-      "EIS core module setup function called when the module is operating.\n");
-  }
-  
-  // Calculate total measurement time.
-  total_measurement_time = ((double)pMeasParams->cycles) / pMeasParams->frequency;
-  
-  // Calculate leap ticks.
-  LeapTicks = (uint32_t)(TICK_FREQUENCY * \
-    fmod(total_measurement_time, subsampling_period));
-  
-  // Make leap ticks even.
-  if ((LeapTicks % 2) != 0)
-  {
-    LeapTicks++;
-  }
-  
-  /* Calculate number of sub samples. */
-  NumOfSubSamples = (uint32_t)(total_measurement_time / subsampling_period);
-  
-  /* Set phasors. */
-  {
-    double norm_freq;
-    double small_angle;
-    double big_angle;
-  
-    norm_freq = pMeasParams->frequency / TICK_FREQUENCY;
-    small_angle = 2.0 * M_PI * norm_freq;
-    big_angle = small_angle * SUBSAMPLING_NUMBER;
-      
-    /* Calculate phasors. */
-    MicroRotX = cos(small_angle);
-    MicroRotY = sin(small_angle);
-    MacroRotX = cos(big_angle);
-    MacroRotY = sin(big_angle);
-    
-    /* Patch leap ticks to initial subsampling period. */
-    PhasorBaseXStart = cos(small_angle * LeapTicks);
-    PhasorBaseYStart = sin(small_angle * LeapTicks);
-  }
-  
-  MeasurementCompletedDelegate = pMeasParams->measurementCompletedDelegate;
-  AmplitudeCoeff = ((float)pMeasParams->signal_amp_pp_dac_code) / 2;
-    
-  /* Configure timer. */
-  TIM_PrescalerConfig(EIS_CORE_TIMER, TIM_PRESCALER, TIM_PSCReloadMode_Immediate);
-  TIM_SetAutoreload(EIS_CORE_TIMER, TIM_RELOAD);
-  
-  Events = 0;
-  
-  // Set state to ready.
-  State = EIS_CORE_STATE_READY;
-}
-
-/***
-  * @Brief      Sets start event. 
-  */
-void EISCore_Start(void)
-{
-  Events |= START_EVENT;
-}
-
-/***
-  * @Brief      EIS Core module's task executer. Should be called periodically.
-  */
-void EISCore_Execute(void)
-{
-  uint8_t __events;
-  
-  if (State == EIS_CORE_STATE_UNINIT)
-  {
-    ExceptionHandler_ThrowException(\
-      "EIS core executer called when the module isn't initialized.\n");
-  }
-                                    
-  /* Events register is sampled due to prevent race condition over events register.
-    There is no need to sample state register, because it can't be changed outside
-    of the execute function. */
-  __events = Events;
-  
-  /* Sampling event occurred. */
-  if (__events & SAMPLING_EVENT)
-  {
-    if (State == EIS_CORE_STATE_OPERATING)
-    {
-      IsLocked = TRUE;
-      
-      /* Add sampled sums. */
-      SumX += (double)SampleX;
-      SumY += (double)SampleY;
- 
-      // Update Base Phasor.
-      rotatePhasor(&PhasorBaseX, &PhasorBaseY, MacroRotX, MacroRotY);
-      
-      /* Increase subsample counter. */
-      if (SubSampleCounter++ >= NumOfSubSamples)
-      {
-        TIM_Cmd(EIS_CORE_TIMER, DISABLE);
-      
-        // Set Signal DAC value.
-        Board_DACSignalResetnCS();
-        Board_HUBSPISend(VGND_DAC_CODE);
-      
-        // Wait until the HUB SPI finished it's process.
-        while (Board_HUBSPIIsBusy());
-        Board_DACSignalSetnCS();
-      
-        MeasurementCompletedDelegate();
-        
-        /* State to pending ready. */
-        State = EIS_CORE_STATE_READY;
-      }
-      
-      IsLocked = FALSE;
-    }
-    
-    __events ^= SAMPLING_EVENT;
-  }
-  
-  /* Start event occurred. */
-  if (__events & START_EVENT)
-  {
-    if (State == EIS_CORE_STATE_READY)
-    {
-      IsLocked = TRUE;
-      
-      /* Reset variables. */
-      PhasorX = 1.0f;
-      PhasorY = 0.0f;
-      PhasorBaseX = PhasorBaseXStart;
-      PhasorBaseY = PhasorBaseYStart;
-      
-      SumX = 0.0f;
-      SumY = 0.0f;
-      SubSumX = 0.0f;
-      SubSumY = 0.0f;
-      
-      SubSampleCounter = 0;
-      TickCounter = MAX_UINT32 - LeapTicks;
-  
-      /* Set initial potential. */
-      Board_DACSignalResetnCS();
-      Board_HUBSPISend(VGND_DAC_CODE);
-      
-      // Trigger first conversion.
-      Board_ADCTriggerConvert();
-      
-      /* Reset Timer. */
-      TIM_SetCounter(EIS_CORE_TIMER, 0U);
-      TIM_ClearFlagOpt(EIS_CORE_TIMER, TIM_IT_Update);
-
-      // Enable timer.
-      TIM_Cmd(EIS_CORE_TIMER, ENABLE);
-      
-      State = EIS_CORE_STATE_OPERATING;
-      
-      IsLocked = FALSE;
-    }
-    
-    __events ^= START_EVENT;
-  }
-  
-  /* Stop event occurred. */
-  if (__events & STOP_EVENT)
-  {
-    /* Process event if the state is operating. */
-    if (State == EIS_CORE_STATE_OPERATING)
-    {
-      IsLocked = TRUE;
-      
-      TIM_Cmd(EIS_CORE_TIMER, DISABLE);
-      
-      // Set Signal DAC value. 
-      Board_DACSignalResetnCS();
-      Board_HUBSPISend(VGND_DAC_CODE);
-      
-      // Wait until the HUB SPI finished it's process.
-      while (Board_HUBSPIIsBusy());
-      Board_DACSignalSetnCS();
-      
-      /* State to pending ready. */
-      State = EIS_CORE_STATE_READY;
-      
-      IsLocked = FALSE;
-    }
-    
-    __events ^= STOP_EVENT;
-  }
-  
-  // Update events register.
-  Events = __events;
-}
-
-/***
-  * @Brief      Sets stop event.
-  */
-void EISCore_Stop(void)
-{
-  Events |= STOP_EVENT;
-}
-
-/***
-  * @Brief      Gets module's state.
-  */
-EISCore_State_t EISCore_GetState(void)
-{
-  return State;
-}
-
-/***
-  * @Brief      Gets result.
-  */
-void EISCore_GetResult(double *pAverageX, double *pAverageY)
-{
-  uint32_t num_of_samples;
-  
-  num_of_samples = SUBSAMPLING_NUMBER * NumOfSubSamples + LeapTicks;
-  
-  /* Calculate averages. */
-  *pAverageX = SumX / num_of_samples;
-  *pAverageY = SumY / num_of_samples;
-}
-
-/* Private function implementations-------------------------------------------*/
-static inline void rotatePhasor(float *pX, float *pY, float xr, float yr)
-{
-  static float temp;
-  
-  /* Calculate rotated phasor. */
-  temp = (*pX) * xr - (*pY) * yr;
-  (*pY) = (*pX) * yr + (*pY) * xr;
-  (*pX) = temp;
-}
\ No newline at end of file
+/**
+  * @author     Onur Efe
+  */
+
+#include <math.h>
+#include "board.h"
+#include "eis_core.h"
+#include "middlewares.h"
+#include "generic.h"
+
+/* Prequisities --------------------------------------------------------------*/
+/*
+  This module is critical in some ways. Overhead to the EISCore_MicroSchedulerTickISR
+  function should be minimum. Other way, the program will crash, because of the
+  interrupt function operation shouldn't be completed. So, the measurement results will
+  be errorenous. Such an error wouldn't be detected because a detection mechanism
+  also would cause an overhead.
+  Besides this, microscheduler timer frequency and microscheduler prescaler range
+  is defined in this module. Any timer shouldn't be used by any other module.
+
+  With EIS_CORE_USE_DMA_SAMPLE_PATH, the tick ISR isn't used. Sampler timer and DMA
+  streams drive the DAC and the ADC, and the executer demodulates the completed
+  ADC blocks while refilling the DAC blocks. Then the executer should be called at
+  least once in a block period, otherwise the measurement is aborted.
+
+  Excitation and demodulation references are generated by 64 bit phase accumulators
+  indexing the sine table in flash. Phase is exact integer arithmetic, so it doesn't drift
+  and it doesn't need to be renormalized. Products are accumulated into 64 bit
+  integers.
+
+  With EIS_CORE_USE_FLOAT_PHASOR, demodulation references of the non decimating path
+  are float phasors rotated once in a tick. Rounding of the rotation drifts, so the
+  phasors are rebased from the phase accumulators at every sub sample boundary.
+  Excitation and the decimating path still use the table.
+
+  In multisine mode, every tone has its own phase accumulator and accumulators, so
+  the cost of a sample grows linearly with the tone count. Tick ISR should complete
+  a sample inside its tick period. DMA sample path only relaxes the latency to a
+  block; a block should still be demodulated inside a block period together with
+  the rest of the executer, otherwise the overrun aborts the measurement. So both
+  paths have the same budget of a tick period per sample on average, and
+  EIS_CORE_MAX_TONES is chosen to keep the worst case sample inside it.
+
+  When a target relative uncertainty is given, every sub sample is treated as an
+  independent estimate of the tone phasor. Their running variance (Welford) gives
+  the standard error of the average, and the measurement is terminated as soon as
+  the standard error relative to the magnitude drops below the target. Requested
+  cycles are the minimum, and the maximum cycles cap the measurement. Relative
+  uncertainty of the current phasor is also the relative uncertainty of the impedance.
+
+  Tick period and number of ticks are planned per measurement, so the measurement
+  covers exactly integer number of signal periods and there is no spectral leakage.
+  Frequency is adjusted slightly instead, and the achieved error is reported.
+
+  Low frequencies take the decimating path. Tick rate is lowered, and conversions
+  are summed by a boxcar filter into decimated samples, which are demodulated at
+  the decimated rate by the executer. So the tick ISR only generates the excitation
+  signal. Demodulation reference is evaluated at the center of the boxcar window,
+  and the boxcar gain is compensated in the result. Decimation ratio divides the
+  sub sampling number, so sub samples still consist of integer number of ticks.
+
+  In a sweep, the next measurement is planned while the current one is operating,
+  into the second plan buffer. Every measurement ends at a signal period boundary,
+  where the phases are at their start values again. So the plans are swapped inside
+  the sampling path at the end of the measurement, and the excitation continues
+  without dead time and without a DC step. Tick period and decimation ratio should
+  be the same for the swap, otherwise sampling stops as before.
+
+  Every measurement might start with a settle block, which covers integer number
+  of signal periods. Excitation runs and it's demodulated as usual, but the sums are
+  discarded at the end of the block. So the transient of the frequency change
+  doesn't get into the result, and it doesn't need extra measurement cycles to
+  average it out.
+
+  In single tone mode, 2nd and 3rd harmonics of the response can be demodulated in
+  the same acquisition. Their references are derived from the fundamental reference
+  by complex multiplication, so no more table lookups are needed. Harmonic sums are
+  kept in the demodulator slots after the tone, which are free in single tone mode.
+
+  Lock-in integration is rectangular by default. Optionally, sub samples are weighted
+  by a Hann or flat top window at the sub sample center, which suppresses the drift
+  and the interference leaking from the other frequencies. Weights are calculated
+  by the executer from the sine table, so the tick ISR isn't affected at all.
+  Result is normalized by the weighted number of samples.
+
+  Optionally, drift of the current is removed. DC sum of every sub sample is also
+  accumulated, and a running linear least squares fit over the sub samples gives
+  the drift. Leakage of a linear drift into the demodulated sums is known in closed
+  form, so it's accumulated per sub sample with the same window weight, and the
+  fitted leakage is subtracted at the end of the measurement.
+
+  In continuous mode, the plan is repeated until the module is stopped. Phases
+  aren't reset at the repetition, since the measurement covers integer number of
+  periods. So there is no setup and no gap between the measurements. Settle block
+  is only at the first run. Every result has the timestamp of its center.
+*/
+
+/* Private definitions -------------------------------------------------------*/
+#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
+
+#define TIM_PRESCALER                           0U
+#define TIM_RELOAD                              210             // Minimum, due to the tick budget.
+
+/* Tick period in timer clocks is searched in a range from the minimum, which is
+  wide enough to find a number of ticks close to the exact one. Sampler timer
+  reload is 16 bits, which limits the tick period. */
+#define MIN_TICK_PERIOD                         (TIM_RELOAD + 1)
+#define MAX_TICK_PERIOD                         ((MAX_UINT16 + 1) / SAMPLER_TIM_CLOCK_RATIO)
+#define TICK_PERIOD_SEARCH_RANGE                2
+
+/* Phase accumulator. Upper 32 bits of the phase are the waveform table phase. */
+#define PHASE_FULL_CYCLE                        18446744073709551616.0  // 2^64
+#define PHASE_TO_TABLE_PHASE_SHIFT              32
+#define AMPLITUDE_CODE_SHIFT                    15
+
+#define SUBSAMPLING_NUMBER                      65536            // Should be even number.
+#define SUBSAMPLING_MASK                        0x8000FFFF
+#define SUBSAMPLING_MAX_TICKS                   0x80000000U     // Tick counter sign bit.
+
+/* Sampler timer ticks at the same rate with the EIS core timer. */
+#define SAMPLER_TIM_CLOCK_RATIO                 (EIS_SAMPLER_TIMER_FREQUENCY / EIS_CORE_TIMER_FREQUENCY)
+#define SAMPLER_BLOCK_LENGTH                    1024            // About 2.6ms at tick frequency.
+#define SAMPLER_BUFFER_LENGTH                   (2 * SAMPLER_BLOCK_LENGTH)
+
+/* DAC phase lags the demodulation phase by a tick in the DMA sample path, since the
+  conversion of a tick sees the DAC code of the previous tick. */
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+#define DAC_PHASE_LAG_TICKS                     1
+#else
+#define DAC_PHASE_LAG_TICKS                     0
+#endif
+
+/* Decimating path for the low frequencies. Minimum tick period and decimation ratio
+  are chosen as high as possible while keeping the given number of ticks and
+  decimated samples per period of the highest tone. Decimation ratio is a power of 2. */
+#define DECIMATION_MAX_FREQUENCY                10.0
+#define DECIMATION_MIN_TICKS_PER_PERIOD         4096
+#define DECIMATION_MIN_SAMPLES_PER_PERIOD       64
+#define MAX_DECIMATION_RATIO                    256
+#define DECIMATED_QUEUE_LENGTH                  128
+
+/* Multisine tones are placed on the harmonics of a common base frequency. So the
+  measurement covers integer number of periods of every tone and tones don't leak
+  into each other. Base frequency is the lowest tone frequency divided by an integer. */
+#define MULTISINE_MAX_BASE_DIVIDER              64
+#define MULTISINE_MAX_REL_FREQ_ERROR            0.005
+#define CREST_FACTOR_EVALUATION_BITS            12
+#define CREST_FACTOR_SAFETY_FACTOR              1.02f
+
+/* Early termination is enabled only when a sub sample covers enough periods, so
+  sub samples are nearly independent of the phase and truncation leakage is low. */
+#define EARLY_TERMINATION_MIN_PERIODS_PER_SUBSAMPLE     4
+#define EARLY_TERMINATION_MIN_SUBSAMPLES                4
+
+/* Window needs enough sub samples to resolve its shape, and sub samples should cover
+  enough periods for the same reason as the early termination. Weight is applied per
+  sub sample, so the window is a staircase. Highest sidelobe of the Hann staircase is
+  -23dB at 8 sub samples, -29dB at 16 and reaches -32dB of the continuous window at
+  32. Flat top staircase needs more steps; -14dB at 8, -21dB at 16, -34dB at 64 and
+  -93dB at 256. At 8 sub samples it leaks more than rectangular, so it has its own
+  minimum. Levels are from Tools/eis_window_leakage_benchmark.py. */
+#define WINDOW_MIN_SUBSAMPLES                   8
+#define FLAT_TOP_WINDOW_MIN_SUBSAMPLES          16
+#define WINDOW_MIN_PERIODS_PER_SUBSAMPLE        EARLY_TERMINATION_MIN_PERIODS_PER_SUBSAMPLE
+
+/* Flat top window coefficients. */
+#define FLAT_TOP_A0                             0.21557895
+#define FLAT_TOP_A1                             0.41663158
+#define FLAT_TOP_A2                             0.277263158
+#define FLAT_TOP_A3                             0.083578947
+#define FLAT_TOP_A4                             0.006947368
+
+/* Harmonics are demodulated only when the 3rd harmonic is below the Nyquist
+  frequency of the demodulation. */
+#define HARMONIC_MIN_SAMPLES_PER_PERIOD         2.5
+
+#define START_EVENT                             0x01
+#define SAMPLING_EVENT                          0x02
+#define STOP_EVENT                              0x04
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Measurement plan. Everything which is calculated by the setup and used during the
+  measurement. */
+typedef struct
+{
+  uint8_t       toneCount;
+  uint8_t       demodulatorCount;       // Tones and harmonics.
+  float         amplitudeCoeff;
+  int32_t       toneAmplitudeCode;
+  uint32_t      tickPeriod;
+  uint32_t      decimationRatio;
+  uint32_t      settleTicks;
+  uint32_t      numOfTicks;
+  uint32_t      firstSubSampleTicks;
+  uint32_t      numOfSubSamples;
+  uint32_t      minNumOfSubSamples;
+  uint8_t       isEarlyTerminationEnabled;
+  uint8_t       isDetrendEnabled;
+  uint8_t       isContinuous;
+  EISCore_Window_t window;
+  double        targetRelUncertaintySquare;
+  uint64_t      phaseStart[EIS_CORE_MAX_TONES];
+  uint64_t      phaseIncrement[EIS_CORE_MAX_TONES];
+  uint64_t      decimatedPhaseIncrement[EIS_CORE_MAX_TONES];
+  uint64_t      decimatedPhaseOffset[EIS_CORE_MAX_TONES];
+  double        boxcarGain[EIS_CORE_MAX_TONES];
+#if EIS_CORE_USE_FLOAT_PHASOR
+  float         tickRotX[EIS_CORE_MAX_TONES];
+  float         tickRotY[EIS_CORE_MAX_TONES];
+#endif
+} MeasPlan_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static inline void checkSubsampling(uint32_t tickCount);
+static inline void getReference(uint8_t toneIndex, int32_t *pSine, int32_t *pCosine);
+#if EIS_CORE_USE_FLOAT_PHASOR
+static void rebasePhasors(void);
+#endif
+static inline void demodulateDecimatedSample(int32_t decimatedSample);
+static inline void demodulateHarmonics(int64_t sample, int32_t sine, int32_t cosine);
+static inline uint16_t generateDACCode(void);
+static inline void resetTickCounter(void);
+static inline void updatePeak(int32_t conversionValue);
+static void swapPlan(void);
+static void completeMeasurement(void);
+static void resetAccumulators(void);
+static double calculateWindowWeight(uint32_t subSampleIndex, uint32_t *pSubSampleTicks);
+static void updateDetrend(double weight, uint32_t subSampleTicks);
+static void removeDrift(void);
+static void calculateReferenceAngles(uint8_t demodulatorIndex, double *pStartAngle,
+                                     double *pAngle);
+static void stopSampling(void);
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+static void startSampling(void);
+static void processSamplerBlock(void);
+#else
+static void processDecimatedQueue(void);
+#endif
+static void planMeasurement(EISCore_MeasParams_t *pMeasParams, uint32_t fixedTickPeriod,
+                            MeasPlan_t *pMeasPlan, float *pRelFrequencyError);
+static double planCoherentSampling(double signalFrequency, uint32_t signalPeriods,
+                                   double highestFrequency, float maxRelFreqError,
+                                   uint32_t fixedTickPeriod, uint32_t *pTickPeriod,
+                                   uint32_t *pNumOfTicks, uint32_t *pDecimationRatio);
+static uint32_t calculateDecimationRatio(double tickFrequency, double highestFrequency);
+static double calculateBoxcarGain(uint32_t decimationRatio, double tickAngle);
+static double placeTonesOnHarmonics(double *pFrequency, uint8_t toneCount);
+static float calculateCrestPeak(double *pFrequency, uint64_t *pPhase, uint8_t toneCount,
+                                double baseFrequency);
+static uint64_t radiansToPhase(double angle);
+static void updateStatistics(void);
+static uint8_t isTargetUncertaintyReached(void);
+static double calculateRelVarianceOfMean(uint8_t toneIndex);
+
+/* Private variables ---------------------------------------------------------*/
+/* Measurement state. */
+static EISCore_State_t  State = EIS_CORE_STATE_UNINIT;
+static uint8_t          Events;
+static uint8_t          IsLocked = FALSE;
+
+/* Store variables. */
+EISCore_MeasurementCompletedDelegate_t  MeasurementCompletedDelegate;
+EISCore_MeasurementAbortedDelegate_t    MeasurementAbortedDelegate;
+
+/* Measurement plans. Demodulation plan is swapped at the end of the measurement,
+  DAC plan is swapped at the end of the excitation, which leads the demodulation
+  in the DMA sample path. Result plan belongs to the measurement, which is being
+  accumulated by the executer. */
+static MeasPlan_t       Plans[2];
+static MeasPlan_t       *pPlan = &Plans[0];
+static MeasPlan_t       *pDACPlan = &Plans[0];
+static MeasPlan_t       *pResultPlan = &Plans[0];
+static MeasPlan_t       *pNextPlan = &Plans[1];
+
+static volatile uint8_t IsNextPlanArmed = FALSE;
+static volatile uint8_t IsDACPlanSwapped = FALSE;
+static volatile uint8_t IsPlanSwapped = FALSE;
+
+/* Modified variables. Phase is the demodulation phase, and DAC phase is the
+  excitation phase when they are separated. */
+static uint64_t         Phase[EIS_CORE_MAX_TONES];
+static uint64_t         DACPhase[EIS_CORE_MAX_TONES];
+#if EIS_CORE_USE_FLOAT_PHASOR
+static float            PhasorX[EIS_CORE_MAX_TONES], PhasorY[EIS_CORE_MAX_TONES];
+#endif
+static uint32_t         DACPhaseIndex;
+
+static int32_t          DecimationSum;
+static uint32_t         DecimationCounter;
+
+static int64_t          SubSumX[EIS_CORE_MAX_TONES], SubSumY[EIS_CORE_MAX_TONES];
+static volatile int64_t SampleX[EIS_CORE_MAX_TONES], SampleY[EIS_CORE_MAX_TONES];
+static double           SumX[EIS_CORE_MAX_TONES], SumY[EIS_CORE_MAX_TONES];
+
+/* DC sums and the running linear fit of the drift, in units of the demodulated
+  samples. Leakage sums are of the unit drift, and of the unit slope. */
+static int64_t          DCSubSum;
+static volatile int64_t DCSample;
+
+/* Peak of the absolute ADC code in a sub sample, and in the measurement. */
+static uint32_t         PeakSubSample;
+static volatile uint32_t PeakSample;
+static uint32_t         PeakMax;
+static double           DetrendSampleIndex;
+static double           DetrendW, DetrendSc, DetrendScc, DetrendSy, DetrendScy;
+static double           LeakageX[EIS_CORE_MAX_TONES], LeakageY[EIS_CORE_MAX_TONES];
+static double           SlopeLeakageX[EIS_CORE_MAX_TONES], SlopeLeakageY[EIS_CORE_MAX_TONES];
+
+static uint32_t         TickCounter;
+static uint32_t         PlanSubSampleCounter;
+static uint8_t          IsSettling;
+static uint32_t         SubSampleCounter;
+static double           WeightedNumOfSamples;
+
+/* Sub sample statistics. First sub sample is excluded, since its length differs. */
+static uint32_t         StatCount;
+static double           StatMeanX[EIS_CORE_MAX_TONES], StatMeanY[EIS_CORE_MAX_TONES];
+static double           StatM2[EIS_CORE_MAX_TONES];
+
+/* Results of the last completed measurement. */
+static double           ResultX[EIS_CORE_MAX_TONES], ResultY[EIS_CORE_MAX_TONES];
+static double           ResultRelStdError[EIS_CORE_MAX_TONES];
+static uint32_t         ResultSubSampleCount;
+static uint8_t          ResultDemodulatorCount;
+static double           ResultTimestamp;
+static uint32_t         ResultPeak;
+
+/* Start of the result measurement in ticks since the start, and the number of its
+  repetitions in continuous mode. */
+static uint64_t         ResultStartTicks;
+static uint32_t         ResultRepeatCount;
+
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+static uint16_t         DACBuffer[SAMPLER_BUFFER_LENGTH];
+static int16_t          ADCBuffer[SAMPLER_BUFFER_LENGTH];
+#else
+/* Decimated samples from the tick ISR to the executer. */
+static QueueGeneric_Buffer_t    DecimatedQueue;
+static int32_t          DecimatedQueueContainer[DECIMATED_QUEUE_LENGTH];
+#endif
+
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      ISR routine for timer interrupt. Should be called with minimum
+  *             overhead.
+  */
+void EISCore_TimerTickISR(void)
+{
+  MeasPlan_t *p_plan;
+  int32_t conversion_value;
+  int32_t dac_value;
+  int32_t sine, cosine;
+
+  if ((State != EIS_CORE_STATE_OPERATING) || (IsLocked == TRUE))
+  {
+    return;
+  }
+
+  Board_DACSignalSetnCS();
+
+  /* Get last conversion result. */
+  conversion_value = Board_ADCGetValue();
+  updatePeak(conversion_value);
+
+  p_plan = pPlan;
+
+  if (p_plan->decimationRatio == 1)
+  {
+    dac_value = VGND_DAC_CODE;
+
+    /* Demodulate every tone and superpose the excitation signal. */
+    for (uint8_t i = 0; i < p_plan->toneCount; i++)
+    {
+      getReference(i, &sine, &cosine);
+
+      SubSumX[i] += (conversion_value * cosine);
+      SubSumY[i] += (conversion_value * sine);
+
+      dac_value += ((sine * p_plan->toneAmplitudeCode) >> AMPLITUDE_CODE_SHIFT);
+    }
+
+    // Harmonics of the single tone.
+    if (p_plan->demodulatorCount > p_plan->toneCount)
+    {
+      demodulateHarmonics(conversion_value, sine, cosine);
+    }
+
+    DCSubSum += conversion_value;
+  }
+  else
+  {
+    /* Decimating path, only generate the excitation signal. */
+    dac_value = generateDACCode();
+  }
+
+  Board_DACSignalResetnCS();            // Frame signal DAC data.
+
+  // Set generated DAC code to DAC.
+  SPI_I2S_SendDataOpt(HUB_SPI, ((uint16_t)dac_value));
+
+  // Trigger next conversion.
+  Board_ADCTriggerConvert();
+
+  if (p_plan->decimationRatio == 1)
+  {
+    checkSubsampling(1);
+  }
+#if !EIS_CORE_USE_DMA_SAMPLE_PATH
+  else
+  {
+    /* Boxcar filter. Decimated sample is demodulated by the executer. */
+    DecimationSum += conversion_value;
+
+    if (++DecimationCounter >= p_plan->decimationRatio)
+    {
+      QueueGeneric_Enqueue(&DecimatedQueue, (uint8_t *)&DecimationSum);
+
+      DecimationSum = 0;
+      DecimationCounter = 0;
+    }
+  }
+#endif
+}
+
+/***
+  * @Brief      Setup function of the EIS core. Function should called before any
+  *             other operation.
+  *
+  * @Param      pMeasParams->Pointer to measurement params struct.
+  * @Param      pRelFrequencyError->Pointer to return the maximum relative frequency
+  *             error of the tones.
+  */
+void EISCore_Setup(EISCore_MeasParams_t *pMeasParams, float *pRelFrequencyError)
+{
+  /* Check state. */
+  if (State == EIS_CORE_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core module setup function called when the module is operating.\n");
+  }
+
+  pPlan = &Plans[0];
+  pDACPlan = pPlan;
+  pResultPlan = pPlan;
+  pNextPlan = &Plans[1];
+
+  IsNextPlanArmed = FALSE;
+  IsDACPlanSwapped = FALSE;
+  IsPlanSwapped = FALSE;
+
+  planMeasurement(pMeasParams, 0, pPlan, pRelFrequencyError);
+
+  MeasurementCompletedDelegate = pMeasParams->measurementCompletedDelegate;
+  MeasurementAbortedDelegate = pMeasParams->measurementAbortedDelegate;
+
+  /* Configure timer. */
+  TIM_PrescalerConfig(EIS_CORE_TIMER, TIM_PRESCALER, TIM_PSCReloadMode_Immediate);
+  TIM_SetAutoreload(EIS_CORE_TIMER, pPlan->tickPeriod - 1);
+
+  Events = 0;
+
+  // Set state to ready.
+  State = EIS_CORE_STATE_READY;
+}
+
+/***
+  * @Brief      Sets up the next measurement, while the current one is operating.
+  *             Next measurement is swapped in at the end of the current one,
+  *             without stopping the excitation. Tick period is kept, so the frequency
+  *             error might be higher than a separate setup. If the next measurement
+  *             needs another decimation ratio, or the current measurement terminates
+  *             early, the module stops at the end of the current measurement.
+  *
+  * @Param      pMeasParams->Pointer to measurement params struct.
+  * @Param      pRelFrequencyError->Pointer to return the maximum relative frequency
+  *             error of the tones.
+  */
+void EISCore_SetupNext(EISCore_MeasParams_t *pMeasParams, float *pRelFrequencyError)
+{
+  /* Check state. */
+  if (State == EIS_CORE_STATE_UNINIT)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core module setup next function called when the module isn't initialized.\n");
+  }
+
+  /* Previous next measurement should have been swapped in. */
+  if ((IsNextPlanArmed == TRUE) || (IsDACPlanSwapped == TRUE) || (IsPlanSwapped == TRUE))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core module setup next function called when the next measurement is pending.\n");
+  }
+
+  pNextPlan = (pResultPlan == &Plans[0]) ? &Plans[1] : &Plans[0];
+
+  planMeasurement(pMeasParams, pResultPlan->tickPeriod, pNextPlan, pRelFrequencyError);
+
+  /* Decimation should be the same, so the boxcar windows continue. */
+  if (pNextPlan->decimationRatio == pResultPlan->decimationRatio)
+  {
+    IsNextPlanArmed = TRUE;
+  }
+}
+
+/***
+  * @Brief      Sets start event.
+  */
+void EISCore_Start(void)
+{
+  Events |= START_EVENT;
+}
+
+/***
+  * @Brief      EIS Core module's task executer. Should be called periodically.
+  */
+void EISCore_Execute(void)
+{
+  uint8_t __events;
+
+  if (State == EIS_CORE_STATE_UNINIT)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core executer called when the module isn't initialized.\n");
+  }
+
+  /* Demodulate completed sampler block or decimated samples. It might set the
+    sampling event. */
+  if (State == EIS_CORE_STATE_OPERATING)
+  {
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+    processSamplerBlock();
+#else
+    processDecimatedQueue();
+#endif
+  }
+
+  /* Events register is sampled due to prevent race condition over events register.
+    There is no need to sample state register, because it can't be changed outside
+    of the execute function. */
+  __events = Events;
+
+  /* Sampling event occurred. Samples are stable until the next sub sample, so the
+    tick ISR isn't locked. Sweep continues during the processing. */
+  if (__events & SAMPLING_EVENT)
+  {
+    if (State == EIS_CORE_STATE_OPERATING)
+    {
+      double weight;
+      uint32_t sub_sample_ticks;
+
+      weight = calculateWindowWeight(SubSampleCounter, &sub_sample_ticks);
+      WeightedNumOfSamples += weight * sub_sample_ticks;
+
+      if (PeakSample > PeakMax)
+      {
+        PeakMax = PeakSample;
+      }
+
+      if (pResultPlan->isDetrendEnabled == TRUE)
+      {
+        updateDetrend(weight, sub_sample_ticks);
+      }
+
+      /* Add sampled sums. */
+      for (uint8_t i = 0; i < pResultPlan->demodulatorCount; i++)
+      {
+        SumX[i] += weight * SampleX[i];
+        SumY[i] += weight * SampleY[i];
+      }
+
+      /* First sub sample has another length. */
+      if (SubSampleCounter != 0)
+      {
+        updateStatistics();
+      }
+
+      /* Increase subsample counter. */
+      if ((SubSampleCounter++ >= pResultPlan->numOfSubSamples) || isTargetUncertaintyReached())
+      {
+        completeMeasurement();
+      }
+    }
+
+    __events ^= SAMPLING_EVENT;
+  }
+
+  /* Start event occurred. */
+  if (__events & START_EVENT)
+  {
+    if (State == EIS_CORE_STATE_READY)
+    {
+      IsLocked = TRUE;
+
+      /* Reset variables. */
+      for (uint8_t i = 0; i < pPlan->toneCount; i++)
+      {
+        Phase[i] = pPlan->phaseStart[i];
+
+        if (pPlan->decimationRatio > 1)
+        {
+          Phase[i] += pPlan->decimatedPhaseOffset[i];
+        }
+      }
+
+#if EIS_CORE_USE_FLOAT_PHASOR
+      rebasePhasors();
+#endif
+
+      for (uint8_t i = 0; i < pPlan->demodulatorCount; i++)
+      {
+        SubSumX[i] = 0;
+        SubSumY[i] = 0;
+      }
+
+      DCSubSum = 0;
+      PeakSubSample = 0;
+
+      resetAccumulators();
+
+      ResultStartTicks = 0;
+      ResultRepeatCount = 0;
+
+      IsDACPlanSwapped = FALSE;
+      IsPlanSwapped = FALSE;
+
+      resetTickCounter();
+
+      DecimationSum = 0;
+      DecimationCounter = 0;
+
+      /* Set initial potential. */
+      Board_DACSignalResetnCS();
+      Board_HUBSPISend(VGND_DAC_CODE);
+
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+      // Wait until the HUB SPI finished it's process.
+      while (Board_HUBSPIIsBusy());
+      Board_DACSignalSetnCS();
+
+      startSampling();
+#else
+      for (uint8_t i = 0; i < pPlan->toneCount; i++)
+      {
+        DACPhase[i] = pPlan->phaseStart[i];
+      }
+
+      DACPhaseIndex = 0;
+
+      QueueGeneric_InitBuffer(&DecimatedQueue, (uint8_t *)DecimatedQueueContainer,
+                              sizeof(DecimatedQueueContainer[0]), DECIMATED_QUEUE_LENGTH);
+
+      // Trigger first conversion.
+      Board_ADCTriggerConvert();
+
+      /* Reset Timer. */
+      TIM_SetCounter(EIS_CORE_TIMER, 0U);
+      TIM_ClearFlagOpt(EIS_CORE_TIMER, TIM_IT_Update);
+
+      // Enable timer.
+      TIM_Cmd(EIS_CORE_TIMER, ENABLE);
+#endif
+
+      State = EIS_CORE_STATE_OPERATING;
+
+      IsLocked = FALSE;
+    }
+
+    __events ^= START_EVENT;
+  }
+
+  /* Stop event occurred. */
+  if (__events & STOP_EVENT)
+  {
+    /* Process event if the state is operating. */
+    if (State == EIS_CORE_STATE_OPERATING)
+    {
+      IsLocked = TRUE;
+
+      stopSampling();
+
+      /* State to pending ready. */
+      State = EIS_CORE_STATE_READY;
+
+      IsLocked = FALSE;
+    }
+
+    IsNextPlanArmed = FALSE;
+
+    __events ^= STOP_EVENT;
+  }
+
+  // Update events register.
+  Events = __events;
+}
+
+/***
+  * @Brief      Sets stop event.
+  */
+void EISCore_Stop(void)
+{
+  Events |= STOP_EVENT;
+}
+
+/***
+  * @Brief      Gets module's state.
+  */
+EISCore_State_t EISCore_GetState(void)
+{
+  return State;
+}
+
+/***
+  * @Brief      Gets result of a tone. Result is normalized to the full signal
+  *             amplitude, so multisine tones are processed like a single sine.
+  *
+  * @Param      toneIndex->Index of the tone in the measurement params.
+  */
+void EISCore_GetResult(uint8_t toneIndex, double *pAverageX, double *pAverageY)
+{
+  *pAverageX = ResultX[toneIndex];
+  *pAverageY = ResultY[toneIndex];
+}
+
+/***
+  * @Brief      Gets uncertainty of a tone result. Sub samples are treated as
+  *             independent estimates of the tone phasor.
+  *
+  * @Param      toneIndex->Index of the tone in the measurement params.
+  * @Param      pRelStdError->Standard error of the average, relative to the
+  *             magnitude. Negative when there are fewer than two sub samples.
+  * @Param      pSubSampleCount->Number of sub samples in the statistics.
+  */
+void EISCore_GetUncertainty(uint8_t toneIndex, double *pRelStdError,
+                            uint32_t *pSubSampleCount)
+{
+  *pRelStdError = ResultRelStdError[toneIndex];
+  *pSubSampleCount = ResultSubSampleCount;
+}
+
+/***
+  * @Brief      Gets timestamp of the result. It's the center of the measured part,
+  *             in seconds since the start.
+  */
+double EISCore_GetTimestamp(void)
+{
+  return ResultTimestamp;
+}
+
+/***
+  * @Brief      Gets peak of the absolute ADC code in the result. Settle block is
+  *             excluded.
+  */
+uint32_t EISCore_GetPeak(void)
+{
+  return ResultPeak;
+}
+
+/***
+  * @Brief      Gets a harmonic of the single tone result. It's normalized like the
+  *             fundamental, so the ratio of them is the relative harmonic content.
+  *
+  * @Param      order->Order of the harmonic, 2 or 3.
+  *
+  * @Return     TRUE if the harmonic is demodulated, FALSE otherwise.
+  */
+uint8_t EISCore_GetHarmonic(uint8_t order, double *pAverageX, double *pAverageY)
+{
+  if ((order < 2) || (order > ResultDemodulatorCount))
+  {
+    return FALSE;
+  }
+
+  *pAverageX = ResultX[order - 1];
+  *pAverageY = ResultY[order - 1];
+
+  return TRUE;
+}
+
+/* Private function implementations-------------------------------------------*/
+/***
+  * @Brief      Checks for the subsampling instant. Sub sums are sampled. At the
+  *             end of the measurement, next plan is swapped in if it's ready.
+  *
+  * @Param      tickCount->Number of ticks elapsed. Should divide the sub sampling
+  *             number.
+  */
+static inline void checkSubsampling(uint32_t tickCount)
+{
+  uint8_t is_next_plan_ready;
+
+  TickCounter += tickCount;
+
+  if ((TickCounter & SUBSAMPLING_MASK) == 0)
+  {
+#if EIS_CORE_USE_FLOAT_PHASOR
+    rebasePhasors();
+#endif
+
+    /* End of the settle block. Sums are discarded, and the measurement starts. */
+    if (IsSettling == TRUE)
+    {
+      for (uint8_t i = 0; i < pPlan->demodulatorCount; i++)
+      {
+        SubSumX[i] = 0;
+        SubSumY[i] = 0;
+      }
+
+      DCSubSum = 0;
+      PeakSubSample = 0;
+
+      IsSettling = FALSE;
+      TickCounter = 0U - pPlan->firstSubSampleTicks;
+
+      return;
+    }
+
+    for (uint8_t i = 0; i < pPlan->demodulatorCount; i++)
+    {
+      SampleX[i] = SubSumX[i];
+      SampleY[i] = SubSumY[i];
+
+      SubSumX[i] = 0;
+      SubSumY[i] = 0;
+    }
+
+    DCSample = DCSubSum;
+    DCSubSum = 0;
+
+    PeakSample = PeakSubSample;
+    PeakSubSample = 0;
+
+    /* End of the measurement, which is a signal period boundary. */
+    if (++PlanSubSampleCounter > pPlan->numOfSubSamples)
+    {
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+      is_next_plan_ready = IsDACPlanSwapped;
+#else
+      /* Without decimation, the tick ISR excites from the demodulation phase. */
+      is_next_plan_ready = (pPlan->decimationRatio == 1) ? IsNextPlanArmed : IsDACPlanSwapped;
+#endif
+
+      if (is_next_plan_ready == TRUE)
+      {
+        swapPlan();
+      }
+      else if (pPlan->isContinuous == TRUE)
+      {
+        /* Repeat the plan, phases continue. */
+        TickCounter = 0U - pPlan->firstSubSampleTicks;
+        PlanSubSampleCounter = 0;
+
+        IsPlanSwapped = TRUE;
+      }
+    }
+
+    Events |= SAMPLING_EVENT;                   // Set sampling event.
+  }
+}
+
+/***
+  * @Brief      Gets demodulation references of a tone at the current tick, and
+  *             advances its phase by a tick.
+  *
+  * @Param      toneIndex->Index of the tone.
+  * @Param      pSine->Pointer to return the sine reference.
+  * @Param      pCosine->Pointer to return the cosine reference.
+  */
+static inline void getReference(uint8_t toneIndex, int32_t *pSine, int32_t *pCosine)
+{
+#if EIS_CORE_USE_FLOAT_PHASOR
+  float x = PhasorX[toneIndex];
+  float y = PhasorY[toneIndex];
+
+  *pSine = (int32_t)(y * WAVEFORM_TABLE_AMPLITUDE);
+  *pCosine = (int32_t)(x * WAVEFORM_TABLE_AMPLITUDE);
+
+  // Rotate phasor.
+  PhasorX[toneIndex] = x * pPlan->tickRotX[toneIndex] - y * pPlan->tickRotY[toneIndex];
+  PhasorY[toneIndex] = x * pPlan->tickRotY[toneIndex] + y * pPlan->tickRotX[toneIndex];
+#else
+  uint32_t table_phase;
+
+  table_phase = (uint32_t)(Phase[toneIndex] >> PHASE_TO_TABLE_PHASE_SHIFT);
+  *pSine = WaveformTable_GetSine(table_phase);
+  *pCosine = WaveformTable_GetCosine(table_phase);
+#endif
+
+  Phase[toneIndex] += pPlan->phaseIncrement[toneIndex];
+}
+
+#if EIS_CORE_USE_FLOAT_PHASOR
+/***
+  * @Brief      Sets the phasors to the phase accumulators, which removes the
+  *             rounding drift of the rotations.
+  */
+static void rebasePhasors(void)
+{
+  float angle;
+
+  for (uint8_t i = 0; i < pPlan->toneCount; i++)
+  {
+    angle = (float)(2.0 * M_PI / 4294967296.0) * \
+      (float)(uint32_t)(Phase[i] >> PHASE_TO_TABLE_PHASE_SHIFT);
+
+    PhasorX[i] = cosf(angle);
+    PhasorY[i] = sinf(angle);
+  }
+}
+#endif
+
+/***
+  * @Brief      Swaps the next plan in for the demodulation.
+  */
+static void swapPlan(void)
+{
+  pPlan = pNextPlan;
+  pDACPlan = pNextPlan;
+
+  for (uint8_t i = 0; i < pPlan->toneCount; i++)
+  {
+    Phase[i] = pPlan->phaseStart[i];
+
+    if (pPlan->decimationRatio > 1)
+    {
+      Phase[i] += pPlan->decimatedPhaseOffset[i];
+    }
+  }
+
+#if EIS_CORE_USE_FLOAT_PHASOR
+  rebasePhasors();
+#endif
+
+  resetTickCounter();
+
+  IsNextPlanArmed = FALSE;
+  IsDACPlanSwapped = FALSE;
+  IsPlanSwapped = TRUE;
+}
+
+/***
+  * @Brief      Resets the tick counter to the start of the demodulation plan. Plan
+  *             starts with the settle block, if there is.
+  */
+static inline void resetTickCounter(void)
+{
+  PlanSubSampleCounter = 0;
+
+  if (pPlan->settleTicks != 0)
+  {
+    IsSettling = TRUE;
+    TickCounter = 0U - pPlan->settleTicks;
+  }
+  else
+  {
+    IsSettling = FALSE;
+    TickCounter = 0U - pPlan->firstSubSampleTicks;
+  }
+}
+
+/***
+  * @Brief      Demodulates a decimated sample, which is the sum of the conversions
+  *             in a boxcar window.
+  *
+  * @Param      decimatedSample->Boxcar sum.
+  */
+static inline void demodulateDecimatedSample(int32_t decimatedSample)
+{
+  int32_t sine, cosine;
+  uint32_t table_phase;
+
+  for (uint8_t i = 0; i < pPlan->toneCount; i++)
+  {
+    table_phase = (uint32_t)(Phase[i] >> PHASE_TO_TABLE_PHASE_SHIFT);
+    sine = WaveformTable_GetSine(table_phase);
+    cosine = WaveformTable_GetCosine(table_phase);
+
+    SubSumX[i] += ((int64_t)decimatedSample * cosine);
+    SubSumY[i] += ((int64_t)decimatedSample * sine);
+
+    Phase[i] += pPlan->decimatedPhaseIncrement[i];
+  }
+
+  // Harmonics of the single tone.
+  if (pPlan->demodulatorCount > pPlan->toneCount)
+  {
+    demodulateHarmonics(decimatedSample, sine, cosine);
+  }
+
+  DCSubSum += decimatedSample;
+
+  checkSubsampling(pPlan->decimationRatio);
+}
+
+/***
+  * @Brief      Demodulates 2nd and 3rd harmonics of the single tone. References are
+  *             the double and triple angle of the fundamental reference.
+  *
+  * @Param      sample->Conversion value or decimated sample.
+  * @Param      sine->Sine reference of the fundamental.
+  * @Param      cosine->Cosine reference of the fundamental.
+  */
+static inline void demodulateHarmonics(int64_t sample, int32_t sine, int32_t cosine)
+{
+  int32_t sine2, cosine2;
+  int32_t sine3, cosine3;
+
+  // Double angle.
+  cosine2 = ((cosine * cosine) - (sine * sine)) >> AMPLITUDE_CODE_SHIFT;
+  sine2 = (2 * sine * cosine) >> AMPLITUDE_CODE_SHIFT;
+
+  // Triple angle, double angle rotated by the fundamental.
+  cosine3 = ((cosine2 * cosine) - (sine2 * sine)) >> AMPLITUDE_CODE_SHIFT;
+  sine3 = ((sine2 * cosine) + (cosine2 * sine)) >> AMPLITUDE_CODE_SHIFT;
+
+  SubSumX[1] += (sample * cosine2);
+  SubSumY[1] += (sample * sine2);
+  SubSumX[2] += (sample * cosine3);
+  SubSumY[2] += (sample * sine3);
+}
+
+/***
+  * @Brief      Generates the DAC code from the DAC phases, and advances them. At
+  *             the end of the excitation, next plan is swapped in if it's armed.
+  */
+static inline uint16_t generateDACCode(void)
+{
+  MeasPlan_t *p_plan = pDACPlan;
+  int32_t dac_value = VGND_DAC_CODE;
+
+  for (uint8_t i = 0; i < p_plan->toneCount; i++)
+  {
+    dac_value += ((WaveformTable_GetSine((uint32_t)(DACPhase[i] >> PHASE_TO_TABLE_PHASE_SHIFT)) * \
+      p_plan->toneAmplitudeCode) >> AMPLITUDE_CODE_SHIFT);
+
+    DACPhase[i] += p_plan->phaseIncrement[i];
+  }
+
+  /* Excitation makes integer number of periods, phases are at the start again. */
+  if (++DACPhaseIndex == (p_plan->settleTicks + p_plan->numOfTicks))
+  {
+    if (IsNextPlanArmed == TRUE)
+    {
+      pDACPlan = pNextPlan;
+
+      for (uint8_t i = 0; i < pDACPlan->toneCount; i++)
+      {
+        DACPhase[i] = pDACPlan->phaseStart[i] - \
+          pDACPlan->phaseIncrement[i] * DAC_PHASE_LAG_TICKS;
+      }
+
+      DACPhaseIndex = 0;
+
+      IsNextPlanArmed = FALSE;
+      IsDACPlanSwapped = TRUE;
+    }
+    else if (p_plan->isContinuous == TRUE)
+    {
+      // Repetition of the plan, without the settle block.
+      DACPhaseIndex = p_plan->settleTicks;
+    }
+  }
+
+  return ((uint16_t)dac_value);
+}
+
+/***
+  * @Brief      Saves the results of the measurement. If the next plan is swapped
+  *             in, sweep continues with it. Otherwise sampling is stopped.
+  */
+static void completeMeasurement(void)
+{
+  double num_of_samples;
+  uint64_t measured_ticks;
+
+  if (pResultPlan->isDetrendEnabled == TRUE)
+  {
+    removeDrift();
+  }
+
+  /* Measurement might be terminated early, so completed sub samples are counted. */
+  num_of_samples = WeightedNumOfSamples;
+
+  /* Scale with the sine table amplitude and the tone amplitude ratio. */
+  num_of_samples *= WAVEFORM_TABLE_AMPLITUDE;
+  num_of_samples *= (((double)pResultPlan->toneAmplitudeCode) * WAVEFORM_TABLE_AMPLITUDE / \
+    (1 << AMPLITUDE_CODE_SHIFT)) / pResultPlan->amplitudeCoeff;
+
+  for (uint8_t i = 0; i < pResultPlan->demodulatorCount; i++)
+  {
+    /* Compensate the boxcar filter gain of the decimating path. */
+    ResultX[i] = SumX[i] / (num_of_samples * pResultPlan->boxcarGain[i]);
+    ResultY[i] = SumY[i] / (num_of_samples * pResultPlan->boxcarGain[i]);
+
+    ResultRelStdError[i] = -1.0;
+    if ((StatCount >= 2) && (i < pResultPlan->toneCount))
+    {
+      ResultRelStdError[i] = sqrt(calculateRelVarianceOfMean(i));
+    }
+  }
+
+  ResultDemodulatorCount = pResultPlan->demodulatorCount;
+
+  ResultSubSampleCount = StatCount;
+  ResultPeak = PeakMax;
+
+  /* Timestamp of the measured part's center. Settle block is only at the first run. */
+  if (ResultRepeatCount == 0)
+  {
+    ResultStartTicks += pResultPlan->settleTicks;
+  }
+
+  measured_ticks = pResultPlan->firstSubSampleTicks + \
+    ((uint64_t)SUBSAMPLING_NUMBER) * (SubSampleCounter - 1);
+  ResultTimestamp = (ResultStartTicks + measured_ticks / 2.0) * \
+    ((TIM_PRESCALER + 1) * pResultPlan->tickPeriod) / EIS_CORE_TIMER_FREQUENCY;
+  ResultStartTicks += measured_ticks;
+
+  if (IsPlanSwapped == TRUE)
+  {
+    /* Next measurement is already being accumulated. It might be the repetition. */
+    ResultRepeatCount = (pPlan == pResultPlan) ? (ResultRepeatCount + 1) : 0;
+
+    pResultPlan = pPlan;
+    IsPlanSwapped = FALSE;
+
+    resetAccumulators();
+  }
+  else
+  {
+    IsLocked = TRUE;
+
+    stopSampling();
+
+    IsNextPlanArmed = FALSE;
+
+    /* State to pending ready. */
+    State = EIS_CORE_STATE_READY;
+
+    IsLocked = FALSE;
+  }
+
+  MeasurementCompletedDelegate();
+}
+
+/***
+  * @Brief      Updates peak of the sub sample with the ADC code.
+  *
+  * @Param      conversionValue->ADC code.
+  */
+static inline void updatePeak(int32_t conversionValue)
+{
+  uint32_t magnitude;
+
+  magnitude = (conversionValue < 0) ? ((uint32_t)-conversionValue) : ((uint32_t)conversionValue);
+
+  if (magnitude > PeakSubSample)
+  {
+    PeakSubSample = magnitude;
+  }
+}
+
+/***
+  * @Brief      Resets the executer accumulators and statistics.
+  */
+static void resetAccumulators(void)
+{
+  for (uint8_t i = 0; i < EIS_CORE_MAX_TONES; i++)
+  {
+    SumX[i] = 0.0;
+    SumY[i] = 0.0;
+
+    StatMeanX[i] = 0.0;
+    StatMeanY[i] = 0.0;
+    StatM2[i] = 0.0;
+  }
+
+  SubSampleCounter = 0;
+  StatCount = 0;
+  WeightedNumOfSamples = 0.0;
+  PeakMax = 0;
+
+  for (uint8_t i = 0; i < EIS_CORE_MAX_TONES; i++)
+  {
+    LeakageX[i] = 0.0;
+    LeakageY[i] = 0.0;
+    SlopeLeakageX[i] = 0.0;
+    SlopeLeakageY[i] = 0.0;
+  }
+
+  DetrendSampleIndex = 0.0;
+  DetrendW = 0.0;
+  DetrendSc = 0.0;
+  DetrendScc = 0.0;
+  DetrendSy = 0.0;
+  DetrendScy = 0.0;
+}
+
+/***
+  * @Brief      Updates the drift fit with the DC sum of the sub sample, and adds
+  *             the leakage of the unit drift and the unit slope in the sub sample.
+  *             Leakage is the sum of the reference phasor over the sub sample,
+  *             which is a geometric series.
+  *
+  * @Param      weight->Window weight of the sub sample.
+  * @Param      subSampleTicks->Number of ticks in the sub sample.
+  */
+static void updateDetrend(double weight, uint32_t subSampleTicks)
+{
+  double length;
+  double center;
+  double dc_sum;
+  double start_angle, angle;
+  double sum0_x, sum0_y, sum1_x, sum1_y;
+  double zl_x, zl_y, den_x, den_y, den_mag;
+  double num_x, num_y, tmp_x, tmp_y;
+  double start_x, start_y;
+
+  // Sub sample in the demodulated samples.
+  length = subSampleTicks / pResultPlan->decimationRatio;
+  center = DetrendSampleIndex + (length - 1) / 2;
+  dc_sum = (double)DCSample;
+
+  /* Running sums of the least squares fit of the sub sample means. */
+  DetrendW += length;
+  DetrendSc += length * center;
+  DetrendScc += length * center * center;
+  DetrendSy += dc_sum;
+  DetrendScy += center * dc_sum;
+
+  for (uint8_t i = 0; i < pResultPlan->demodulatorCount; i++)
+  {
+    calculateReferenceAngles(i, &start_angle, &angle);
+
+    /* Sum0 = (z^L - 1) / (z - 1), Sum1 = z * (1 - L * z^(L - 1) + (L - 1) * z^L) / (z - 1)^2,
+      where z is the reference phasor advance in a sample. */
+    zl_x = cos(length * angle) - 1.0;
+    zl_y = sin(length * angle);
+    den_x = cos(angle) - 1.0;
+    den_y = sin(angle);
+    den_mag = den_x * den_x + den_y * den_y;
+
+    sum0_x = (zl_x * den_x + zl_y * den_y) / den_mag;
+    sum0_y = (zl_y * den_x - zl_x * den_y) / den_mag;
+
+    // Numerator, z * (1 - L * z^(L - 1)) + (L - 1) * z^(L + 1).
+    num_x = cos(angle) - length * cos(length * angle) + (length - 1) * cos((length + 1) * angle);
+    num_y = sin(angle) - length * sin(length * angle) + (length - 1) * sin((length + 1) * angle);
+
+    // Division by the square of the denominator.
+    tmp_x = den_x * den_x - den_y * den_y;
+    tmp_y = 2 * den_x * den_y;
+    den_mag *= den_mag;
+    sum1_x = (num_x * tmp_x + num_y * tmp_y) / den_mag;
+    sum1_y = (num_y * tmp_x - num_x * tmp_y) / den_mag;
+
+    /* Shift to the sub sample start. Slope leakage is of the sample index. */
+    sum1_x += DetrendSampleIndex * sum0_x;
+    sum1_y += DetrendSampleIndex * sum0_y;
+
+    start_x = cos(start_angle + DetrendSampleIndex * angle) * weight;
+    start_y = sin(start_angle + DetrendSampleIndex * angle) * weight;
+
+    LeakageX[i] += start_x * sum0_x - start_y * sum0_y;
+    LeakageY[i] += start_x * sum0_y + start_y * sum0_x;
+    SlopeLeakageX[i] += start_x * sum1_x - start_y * sum1_y;
+    SlopeLeakageY[i] += start_x * sum1_y + start_y * sum1_x;
+  }
+
+  DetrendSampleIndex += length;
+}
+
+/***
+  * @Brief      Subtracts the leakage of the fitted drift from the sums.
+  */
+static void removeDrift(void)
+{
+  double denominator;
+  double offset, slope;
+
+  if (DetrendW == 0.0)
+  {
+    return;
+  }
+
+  /* Single sub sample gives only the offset. */
+  denominator = DetrendW * DetrendScc - DetrendSc * DetrendSc;
+  slope = (denominator > 0.0) ? ((DetrendW * DetrendScy - DetrendSc * DetrendSy) / denominator) : 0.0;
+  offset = (DetrendSy - slope * DetrendSc) / DetrendW;
+
+  for (uint8_t i = 0; i < pResultPlan->demodulatorCount; i++)
+  {
+    SumX[i] -= WAVEFORM_TABLE_AMPLITUDE * (offset * LeakageX[i] + slope * SlopeLeakageX[i]);
+    SumY[i] -= WAVEFORM_TABLE_AMPLITUDE * (offset * LeakageY[i] + slope * SlopeLeakageY[i]);
+  }
+}
+
+/***
+  * @Brief      Calculates reference angle of a demodulator at the first measured
+  *             sample, and its advance in a demodulated sample. Harmonics are the
+  *             multiples of the single tone.
+  *
+  * @Param      demodulatorIndex->Index of the demodulator.
+  * @Param      pStartAngle->Pointer to return the start angle in radians.
+  * @Param      pAngle->Pointer to return the advance in radians.
+  */
+static void calculateReferenceAngles(uint8_t demodulatorIndex, double *pStartAngle,
+                                     double *pAngle)
+{
+  uint8_t tone_index = demodulatorIndex;
+  uint8_t order = 1;
+  uint64_t phase;
+
+  if (demodulatorIndex >= pResultPlan->toneCount)
+  {
+    tone_index = 0;
+    order = demodulatorIndex + 1;
+  }
+
+  /* Phase accumulator is exact, so the phase after the settle block and the
+    repetitions is known. */
+  phase = pResultPlan->phaseStart[tone_index] + pResultPlan->phaseIncrement[tone_index] * \
+    (pResultPlan->settleTicks + ((uint64_t)pResultPlan->numOfTicks) * ResultRepeatCount);
+
+  if (pResultPlan->decimationRatio > 1)
+  {
+    phase += pResultPlan->decimatedPhaseOffset[tone_index];
+  }
+
+  *pStartAngle = order * (2.0 * M_PI * phase / PHASE_FULL_CYCLE);
+  *pAngle = order * (2.0 * M_PI * pResultPlan->decimatedPhaseIncrement[tone_index] / \
+    PHASE_FULL_CYCLE);
+}
+
+/***
+  * @Brief      Calculates window weight of a sub sample, at the center of it.
+  *             Cosine terms are taken from the sine table. Weight is constant in
+  *             the sub sample, see WINDOW_MIN_SUBSAMPLES for the achieved sidelobes.
+  *
+  * @Param      subSampleIndex->Index of the sub sample in the measurement.
+  * @Param      pSubSampleTicks->Pointer to return number of ticks in the sub sample.
+  */
+static double calculateWindowWeight(uint32_t subSampleIndex, uint32_t *pSubSampleTicks)
+{
+  double center;
+  uint32_t phase;
+
+  if (subSampleIndex == 0)
+  {
+    *pSubSampleTicks = pResultPlan->firstSubSampleTicks;
+    center = pResultPlan->firstSubSampleTicks / 2.0;
+  }
+  else
+  {
+    *pSubSampleTicks = SUBSAMPLING_NUMBER;
+    center = pResultPlan->firstSubSampleTicks + \
+      ((double)SUBSAMPLING_NUMBER) * (subSampleIndex - 1) + (SUBSAMPLING_NUMBER / 2);
+  }
+
+  // Position in the measurement as the table phase.
+  phase = (uint32_t)(center / pResultPlan->numOfTicks * 4294967296.0);
+
+  switch (pResultPlan->window)
+  {
+  case EIS_CORE_WINDOW_HANN:
+    return (0.5 - 0.5 * WaveformTable_GetCosine(phase) / WAVEFORM_TABLE_AMPLITUDE);
+
+  case EIS_CORE_WINDOW_FLAT_TOP:
+    return (FLAT_TOP_A0 - \
+      (FLAT_TOP_A1 * WaveformTable_GetCosine(phase) - \
+       FLAT_TOP_A2 * WaveformTable_GetCosine(2 * phase) + \
+       FLAT_TOP_A3 * WaveformTable_GetCosine(3 * phase) - \
+       FLAT_TOP_A4 * WaveformTable_GetCosine(4 * phase)) / WAVEFORM_TABLE_AMPLITUDE);
+
+  default:
+    return 1.0;
+  }
+}
+
+/***
+  * @Brief      Plans a measurement. Tones are placed, and tick period and number
+  *             of ticks are planned for the coherent sampling.
+  *
+  * @Param      pMeasParams->Pointer to measurement params struct.
+  * @Param      fixedTickPeriod->Tick period to be kept. Zero for searching.
+  * @Param      pMeasPlan->Pointer to the plan to be filled.
+  * @Param      pRelFrequencyError->Pointer to return the maximum relative frequency
+  *             error of the tones.
+  */
+static void planMeasurement(EISCore_MeasParams_t *pMeasParams, uint32_t fixedTickPeriod,
+                            MeasPlan_t *pMeasPlan, float *pRelFrequencyError)
+{
+  double frequency[EIS_CORE_MAX_TONES];
+  double phase[EIS_CORE_MAX_TONES];
+  uint32_t harmonic[EIS_CORE_MAX_TONES];
+  double base_frequency = 0.0;
+  double signal_frequency;
+  double highest_frequency;
+  double tick_frequency;
+  double error;
+  double max_error;
+  uint32_t cycles_per_signal_period;
+  uint32_t max_cycles;
+  uint32_t signal_periods;
+  uint32_t min_signal_periods;
+  uint32_t settle_signal_periods;
+  uint32_t num_of_ticks;
+  uint32_t min_num_of_ticks;
+  uint8_t tone_count;
+
+  /* Check tone count. */
+  if ((pMeasParams->toneCount == 0) || (pMeasParams->toneCount > EIS_CORE_MAX_TONES))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core module setup function called with invalid tone count.\n");
+  }
+
+  tone_count = pMeasParams->toneCount;
+  pMeasPlan->toneCount = tone_count;
+
+  highest_frequency = 0.0;
+  for (uint8_t i = 0; i < tone_count; i++)
+  {
+    frequency[i] = pMeasParams->frequency[i];
+
+    if (frequency[i] > highest_frequency)
+    {
+      highest_frequency = frequency[i];
+    }
+  }
+
+  if (tone_count == 1)
+  {
+    signal_frequency = frequency[0];
+    harmonic[0] = 1;
+    cycles_per_signal_period = 1;
+
+    phase[0] = 0.0;
+  }
+  else
+  {
+    base_frequency = placeTonesOnHarmonics(frequency, tone_count);
+
+    /* Signal period is the base period. Lowest tone makes base divider cycles in
+      one base period. */
+    signal_frequency = base_frequency;
+    cycles_per_signal_period = MAX_UINT32;
+    for (uint8_t i = 0; i < tone_count; i++)
+    {
+      harmonic[i] = (uint32_t)(floor(frequency[i] / base_frequency + 0.5));
+
+      if (harmonic[i] < cycles_per_signal_period)
+      {
+        cycles_per_signal_period = harmonic[i];
+      }
+    }
+
+    /* Schroeder phases keep the crest factor of the superposed signal low. */
+    for (uint8_t i = 0; i < tone_count; i++)
+    {
+      phase[i] = -M_PI * i * (i + 1) / tone_count;
+    }
+  }
+
+  /* Early termination needs a target and room above the requested cycles. Sub
+    samples should cover enough periods, it's checked after the planning. Repeated
+    measurements of the continuous mode have the fixed length. */
+  max_cycles = pMeasParams->cycles;
+  pMeasPlan->isEarlyTerminationEnabled = FALSE;
+
+  if ((pMeasParams->targetRelUncertainty > 0.0f) && \
+      (pMeasParams->maxCycles > pMeasParams->cycles) && \
+      (pMeasParams->isContinuous == FALSE))
+  {
+    max_cycles = pMeasParams->maxCycles;
+    pMeasPlan->isEarlyTerminationEnabled = TRUE;
+  }
+
+  pMeasPlan->targetRelUncertaintySquare = ((double)pMeasParams->targetRelUncertainty) * \
+    pMeasParams->targetRelUncertainty;
+
+  // Integer number of signal periods, which covers at least the requested cycles.
+  signal_periods = (max_cycles + cycles_per_signal_period - 1) / cycles_per_signal_period;
+  min_signal_periods = (pMeasParams->cycles + cycles_per_signal_period - 1) / \
+    cycles_per_signal_period;
+
+  if (signal_periods == 0)
+  {
+    signal_periods = 1;
+  }
+
+  /* Plan the tick period and the number of ticks. */
+  signal_frequency = planCoherentSampling(signal_frequency, signal_periods, highest_frequency,
+                                          pMeasParams->maxRelFreqError, fixedTickPeriod,
+                                          &pMeasPlan->tickPeriod, &num_of_ticks,
+                                          &pMeasPlan->decimationRatio);
+  tick_frequency = ((double)EIS_CORE_TIMER_FREQUENCY) / \
+    ((TIM_PRESCALER + 1) * pMeasPlan->tickPeriod);
+
+  if (num_of_ticks >= SUBSAMPLING_MAX_TICKS)
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core module setup function called with too many cycles.\n");
+  }
+
+  pMeasPlan->numOfTicks = num_of_ticks;
+
+  /* Settle block, rounded to the decimation ratio. Excitation phase at the end of
+    the plan is off by less than a decimated sample, which is the phase step at
+    the swap of the plans. */
+  settle_signal_periods = (pMeasParams->settleCycles + cycles_per_signal_period - 1) / \
+    cycles_per_signal_period;
+
+  if ((((double)num_of_ticks) * settle_signal_periods / signal_periods) >= \
+      (SUBSAMPLING_MAX_TICKS - num_of_ticks))
+  {
+    ExceptionHandler_ThrowException(\
+      "EIS core module setup function called with too many settle cycles.\n");
+  }
+
+  pMeasPlan->settleTicks = (uint32_t)(floor(((double)num_of_ticks) * settle_signal_periods / \
+    (((double)signal_periods) * pMeasPlan->decimationRatio) + 0.5) * pMeasPlan->decimationRatio);
+
+  /* First sub sample takes the remainder. It's kept longer than the half sub sample,
+    so sub samples are far enough apart, also at the swap of the measurements. */
+  pMeasPlan->numOfSubSamples = num_of_ticks / SUBSAMPLING_NUMBER;
+  pMeasPlan->firstSubSampleTicks = num_of_ticks % SUBSAMPLING_NUMBER;
+
+  if ((pMeasPlan->firstSubSampleTicks < (SUBSAMPLING_NUMBER / 2)) && \
+      (pMeasPlan->numOfSubSamples > 0))
+  {
+    pMeasPlan->firstSubSampleTicks += SUBSAMPLING_NUMBER;
+    pMeasPlan->numOfSubSamples--;
+  }
+
+  if ((SUBSAMPLING_NUMBER * signal_frequency / tick_frequency) < \
+      EARLY_TERMINATION_MIN_PERIODS_PER_SUBSAMPLE)
+  {
+    pMeasPlan->isEarlyTerminationEnabled = FALSE;
+  }
+
+  pMeasPlan->isDetrendEnabled = pMeasParams->isDetrendEnabled;
+  pMeasPlan->isContinuous = pMeasParams->isContinuous;
+
+  /* Window falls back to rectangular for the short measurements. Windowed
+    measurement should complete, so it isn't terminated early. */
+  pMeasPlan->window = pMeasParams->window;
+
+  if ((pMeasPlan->numOfSubSamples < WINDOW_MIN_SUBSAMPLES) || \
+      ((SUBSAMPLING_NUMBER * signal_frequency / tick_frequency) < WINDOW_MIN_PERIODS_PER_SUBSAMPLE))
+  {
+    pMeasPlan->window = EIS_CORE_WINDOW_RECTANGULAR;
+  }
+
+  if ((pMeasPlan->window == EIS_CORE_WINDOW_FLAT_TOP) && \
+      (pMeasPlan->numOfSubSamples < FLAT_TOP_WINDOW_MIN_SUBSAMPLES))
+  {
+    pMeasPlan->window = EIS_CORE_WINDOW_HANN;
+  }
+
+  if (pMeasPlan->window != EIS_CORE_WINDOW_RECTANGULAR)
+  {
+    pMeasPlan->isEarlyTerminationEnabled = FALSE;
+  }
+
+  min_num_of_ticks = (uint32_t)(((double)num_of_ticks) * min_signal_periods / signal_periods);
+  pMeasPlan->minNumOfSubSamples = (min_num_of_ticks + SUBSAMPLING_NUMBER - 1) / \
+    SUBSAMPLING_NUMBER;
+
+  if (pMeasPlan->minNumOfSubSamples < EARLY_TERMINATION_MIN_SUBSAMPLES)
+  {
+    pMeasPlan->minNumOfSubSamples = EARLY_TERMINATION_MIN_SUBSAMPLES;
+  }
+
+  /* Set phase accumulators. Every tone makes integer number of cycles in the
+    measurement, error of the increment is below 1 LSB per tick. */
+  max_error = 0.0;
+  for (uint8_t i = 0; i < tone_count; i++)
+  {
+    uint32_t decimation_ratio = pMeasPlan->decimationRatio;
+    uint64_t phase_increment;
+    double tick_angle;
+
+    frequency[i] = harmonic[i] * signal_frequency;
+    tick_angle = 2.0 * M_PI * frequency[i] / tick_frequency;
+
+    phase_increment = (uint64_t)(((((double)signal_periods) * harmonic[i]) / num_of_ticks) * \
+      PHASE_FULL_CYCLE + 0.5);
+
+    pMeasPlan->phaseIncrement[i] = phase_increment;
+    pMeasPlan->phaseStart[i] = radiansToPhase(phase[i]);
+
+#if EIS_CORE_USE_FLOAT_PHASOR
+    pMeasPlan->tickRotX[i] = (float)cos(2.0 * M_PI * phase_increment / PHASE_FULL_CYCLE);
+    pMeasPlan->tickRotY[i] = (float)sin(2.0 * M_PI * phase_increment / PHASE_FULL_CYCLE);
+#endif
+
+    /* Decimated sample is demodulated at the center of the boxcar window, which is
+      (ratio - 1) / 2 ticks after the window start. */
+    pMeasPlan->decimatedPhaseIncrement[i] = phase_increment * decimation_ratio;
+    pMeasPlan->decimatedPhaseOffset[i] = phase_increment * ((decimation_ratio - 1) >> 1);
+    if (((decimation_ratio - 1) & 1) != 0)
+    {
+      pMeasPlan->decimatedPhaseOffset[i] += (phase_increment >> 1);
+    }
+
+    pMeasPlan->boxcarGain[i] = calculateBoxcarGain(decimation_ratio, tick_angle);
+
+    // Achieved frequency error, including the harmonic placement.
+    error = fabs(frequency[i] - pMeasParams->frequency[i]) / pMeasParams->frequency[i];
+    if (error > max_error)
+    {
+      max_error = error;
+    }
+  }
+
+  /* Harmonics of the single tone are demodulated into the following slots. */
+  pMeasPlan->demodulatorCount = tone_count;
+
+  if ((tone_count == 1) && (pMeasParams->isHarmonicsEnabled == TRUE) && \
+      ((tick_frequency / pMeasPlan->decimationRatio) >= \
+       (EIS_CORE_HIGHEST_HARMONIC * frequency[0] * HARMONIC_MIN_SAMPLES_PER_PERIOD)))
+  {
+    pMeasPlan->demodulatorCount = EIS_CORE_HIGHEST_HARMONIC;
+
+    for (uint8_t order = 2; order <= EIS_CORE_HIGHEST_HARMONIC; order++)
+    {
+      pMeasPlan->boxcarGain[order - 1] = calculateBoxcarGain(pMeasPlan->decimationRatio, \
+        2.0 * M_PI * order * frequency[0] / tick_frequency);
+    }
+  }
+
+  *pRelFrequencyError = (float)max_error;
+
+  pMeasPlan->amplitudeCoeff = ((float)pMeasParams->signal_amp_pp_dac_code) / 2;
+
+  /* Share the amplitude between tones, so the superposed signal fits the range. */
+  if (tone_count == 1)
+  {
+    pMeasPlan->toneAmplitudeCode = (int32_t)(pMeasPlan->amplitudeCoeff + 0.5f);
+  }
+  else
+  {
+    pMeasPlan->toneAmplitudeCode = (int32_t)(pMeasPlan->amplitudeCoeff / \
+      calculateCrestPeak(frequency, pMeasPlan->phaseStart, tone_count, base_frequency));
+  }
+}
+
+/***
+  * @Brief      Plans tick period and number of ticks, so the measurement covers
+  *             exactly the given number of signal periods. Achieved frequency is
+  *             the signal periods over the measurement duration. Tick period is
+  *             searched upwards from the minimum, and the first one which satisfies
+  *             the frequency error limit is chosen, since it gives the highest tick
+  *             rate. If there isn't any, the one with the lowest error is chosen.
+  *             Fixed tick period is used as is, only the number of ticks is planned.
+  *
+  * @Param      signalFrequency->Frequency of the signal. Base frequency for multisine.
+  * @Param      signalPeriods->Number of signal periods to be covered.
+  * @Param      highestFrequency->Frequency of the highest tone.
+  * @Param      maxRelFreqError->Maximum relative frequency error.
+  * @Param      fixedTickPeriod->Tick period to be kept. Zero for searching.
+  * @Param      pTickPeriod->Pointer to return tick period in timer clocks.
+  * @Param      pNumOfTicks->Pointer to return number of ticks, which is a multiple
+  *             of the decimation ratio.
+  * @Param      pDecimationRatio->Pointer to return decimation ratio.
+  *
+  * @Return     Achieved signal frequency.
+  */
+static double planCoherentSampling(double signalFrequency, uint32_t signalPeriods,
+                                   double highestFrequency, float maxRelFreqError,
+                                   uint32_t fixedTickPeriod, uint32_t *pTickPeriod,
+                                   uint32_t *pNumOfTicks, uint32_t *pDecimationRatio)
+{
+  uint32_t min_tick_period;
+  uint32_t max_tick_period;
+  uint32_t decimation_ratio;
+  double tick_frequency;
+  double num_of_ticks;
+  double achieved_frequency;
+  double error;
+  double best_error = HUGE_VAL;
+  double best_frequency = signalFrequency;
+
+  /* Decimating path runs at a lower tick rate. */
+  min_tick_period = MIN_TICK_PERIOD;
+  if (highestFrequency <= DECIMATION_MAX_FREQUENCY)
+  {
+    min_tick_period = (uint32_t)(EIS_CORE_TIMER_FREQUENCY / \
+      (highestFrequency * DECIMATION_MIN_TICKS_PER_PERIOD));
+  }
+
+  if (min_tick_period < MIN_TICK_PERIOD)
+  {
+    min_tick_period = MIN_TICK_PERIOD;
+  }
+  else if (min_tick_period > (MAX_TICK_PERIOD / TICK_PERIOD_SEARCH_RANGE))
+  {
+    min_tick_period = MAX_TICK_PERIOD / TICK_PERIOD_SEARCH_RANGE;
+  }
+
+  max_tick_period = min_tick_period * TICK_PERIOD_SEARCH_RANGE;
+
+  if (fixedTickPeriod != 0)
+  {
+    min_tick_period = fixedTickPeriod;
+    max_tick_period = fixedTickPeriod;
+  }
+
+  for (uint32_t tick_period = min_tick_period; tick_period <= max_tick_period; tick_period++)
+  {
+    tick_frequency = ((double)EIS_CORE_TIMER_FREQUENCY) / ((TIM_PRESCALER + 1) * tick_period);
+    decimation_ratio = calculateDecimationRatio(tick_frequency, highestFrequency);
+
+    // Number of ticks, rounded to the nearest multiple of the decimation ratio.
+    num_of_ticks = floor((signalPeriods * tick_frequency / signalFrequency) / \
+      decimation_ratio + 0.5) * decimation_ratio;
+
+    if (num_of_ticks < decimation_ratio)
+    {
+      num_of_ticks = decimation_ratio;
+    }
+
+    // Back calculate the frequency.
+    achieved_frequency = signalPeriods * tick_frequency / num_of_ticks;
+    error = fabs(achieved_frequency - signalFrequency) / signalFrequency;
+
+    if (error < best_error)
+    {
+      best_error = error;
+      best_frequency = achieved_frequency;
+
+      *pTickPeriod = tick_period;
+      *pNumOfTicks = (num_of_ticks < SUBSAMPLING_MAX_TICKS) ? \
+        (uint32_t)num_of_ticks : SUBSAMPLING_MAX_TICKS;
+      *pDecimationRatio = decimation_ratio;
+    }
+
+    if (error <= maxRelFreqError)
+    {
+      break;
+    }
+  }
+
+  return best_frequency;
+}
+
+/***
+  * @Brief      Calculates decimation ratio. High frequencies aren't decimated.
+  *
+  * @Param      tickFrequency->Tick frequency.
+  * @Param      highestFrequency->Frequency of the highest tone.
+  */
+static uint32_t calculateDecimationRatio(double tickFrequency, double highestFrequency)
+{
+  uint32_t decimation_ratio = 1;
+
+  if (highestFrequency <= DECIMATION_MAX_FREQUENCY)
+  {
+    while (((decimation_ratio * 2) <= MAX_DECIMATION_RATIO) && \
+           ((tickFrequency / (decimation_ratio * 2)) >= \
+            (highestFrequency * DECIMATION_MIN_SAMPLES_PER_PERIOD)))
+    {
+      decimation_ratio *= 2;
+    }
+  }
+
+  return decimation_ratio;
+}
+
+/***
+  * @Brief      Calculates gain of the boxcar filter at a frequency.
+  *
+  * @Param      decimationRatio->Decimation ratio, which is the boxcar length.
+  * @Param      tickAngle->Phase advance of the frequency in a tick, in radians.
+  */
+static double calculateBoxcarGain(uint32_t decimationRatio, double tickAngle)
+{
+  if (decimationRatio == 1)
+  {
+    return 1.0;
+  }
+
+  return (sin(decimationRatio * tickAngle / 2) / (decimationRatio * sin(tickAngle / 2)));
+}
+
+/***
+  * @Brief      Updates running mean and variance of the sub samples with Welford's
+  *             method. Variance is the sum of the X and Y variances.
+  */
+static void updateStatistics(void)
+{
+  double delta_x, delta_y;
+
+  StatCount++;
+
+  for (uint8_t i = 0; i < pResultPlan->toneCount; i++)
+  {
+    delta_x = ((double)SampleX[i]) - StatMeanX[i];
+    delta_y = ((double)SampleY[i]) - StatMeanY[i];
+
+    StatMeanX[i] += delta_x / StatCount;
+    StatMeanY[i] += delta_y / StatCount;
+
+    StatM2[i] += delta_x * (((double)SampleX[i]) - StatMeanX[i]);
+    StatM2[i] += delta_y * (((double)SampleY[i]) - StatMeanY[i]);
+  }
+}
+
+/***
+  * @Brief      Checks if the relative standard error of every tone is below the
+  *             target.
+  *
+  * @Return     TRUE or FALSE.
+  */
+static uint8_t isTargetUncertaintyReached(void)
+{
+  if ((pResultPlan->isEarlyTerminationEnabled == FALSE) || \
+      (StatCount < pResultPlan->minNumOfSubSamples))
+  {
+    return FALSE;
+  }
+
+  for (uint8_t i = 0; i < pResultPlan->toneCount; i++)
+  {
+    if (calculateRelVarianceOfMean(i) > pResultPlan->targetRelUncertaintySquare)
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/***
+  * @Brief      Calculates variance of the sub sample mean, relative to the square
+  *             of the magnitude. There should be at least two sub samples.
+  *
+  * @Param      toneIndex->Index of the tone.
+  */
+static double calculateRelVarianceOfMean(uint8_t toneIndex)
+{
+  double variance_of_mean;
+  double magnitude_square;
+
+  variance_of_mean = StatM2[toneIndex] / (((double)(StatCount - 1)) * StatCount);
+  magnitude_square = StatMeanX[toneIndex] * StatMeanX[toneIndex] + \
+    StatMeanY[toneIndex] * StatMeanY[toneIndex];
+
+  /* Zero magnitude, uncertainty is unbounded. */
+  if (magnitude_square == 0.0)
+  {
+    return HUGE_VAL;
+  }
+
+  return (variance_of_mean / magnitude_square);
+}
+
+/***
+  * @Brief      Stops DAC and ADC servicing, and sets the DAC to virtual ground.
+  */
+static void stopSampling(void)
+{
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+  Board_EISSamplerStop();
+#else
+  TIM_Cmd(EIS_CORE_TIMER, DISABLE);
+#endif
+
+  // Set Signal DAC value.
+  Board_DACSignalResetnCS();
+  Board_HUBSPISend(VGND_DAC_CODE);
+
+  // Wait until the HUB SPI finished it's process.
+  while (Board_HUBSPIIsBusy());
+  Board_DACSignalSetnCS();
+}
+
+#if EIS_CORE_USE_DMA_SAMPLE_PATH
+/***
+  * @Brief      Fills the DAC buffer with the first two blocks and starts the sampler.
+  *             DAC code of the tick n is generated from the demodulation phase of
+  *             the tick n - 1.
+  */
+static void startSampling(void)
+{
+  uint32_t reload;
+
+  /* Conversion of a tick sees the DAC code of the previous tick. DAC phase runs two
+    blocks ahead of the demodulation phase after the fill. */
+  for (uint8_t i = 0; i < pDACPlan->toneCount; i++)
+  {
+    DACPhase[i] = pDACPlan->phaseStart[i] - pDACPlan->phaseIncrement[i] * DAC_PHASE_LAG_TICKS;
+  }
+
+  DACPhaseIndex = 0;
+
+  for (uint16_t n = 0; n < SAMPLER_BUFFER_LENGTH; n++)
+  {
+    DACBuffer[n] = generateDACCode();
+  }
+
+  reload = SAMPLER_TIM_CLOCK_RATIO * pPlan->tickPeriod - 1;
+
+  Board_EISSamplerStart(DACBuffer, ADCBuffer, SAMPLER_BUFFER_LENGTH, (uint16_t)reload);
+}
+
+/***
+  * @Brief      Demodulates the completed ADC block, and refills the DAC block of
+  *             the same half. Arithmetic is the same with the tick ISR. Decimating
+  *             path demodulates boxcar sums of the ADC block instead.
+  */
+static void processSamplerBlock(void)
+{
+  Board_EISSamplerBlock_t block;
+  uint16_t *p_dac;
+  int16_t *p_adc;
+  int32_t conversion_value;
+  int32_t sine, cosine;
+
+  block = Board_EISSamplerGetCompletedBlock();
+
+  if (block == BOARD_EIS_SAMPLER_BLOCK_NONE)
+  {
+    return;
+  }
+
+  /* Executer isn't called frequently enough, a block is overwritten before it's
+    demodulated. Measurement is aborted, since the lost samples can't be recovered. */
+  if (block == BOARD_EIS_SAMPLER_BLOCK_OVERRUN)
+  {
+    IsLocked = TRUE;
+
+    stopSampling();
+
+    IsNextPlanArmed = FALSE;
+    State = EIS_CORE_STATE_READY;
+
+    IsLocked = FALSE;
+
+    MeasurementAbortedDelegate();
+
+    return;
+  }
+
+  if (block == BOARD_EIS_SAMPLER_BLOCK_FIRST_HALF)
+  {
+    p_dac = &DACBuffer[0];
+    p_adc = &ADCBuffer[0];
+  }
+  else
+  {
+    p_dac = &DACBuffer[SAMPLER_BLOCK_LENGTH];
+    p_adc = &ADCBuffer[SAMPLER_BLOCK_LENGTH];
+  }
+
+  for (uint16_t n = 0; n < SAMPLER_BLOCK_LENGTH; n++)
+  {
+    conversion_value = p_adc[n];
+    updatePeak(conversion_value);
+
+    if (pPlan->decimationRatio == 1)
+    {
+      for (uint8_t i = 0; i < pPlan->toneCount; i++)
+      {
+        getReference(i, &sine, &cosine);
+
+        SubSumX[i] += (conversion_value * cosine);
+        SubSumY[i] += (conversion_value * sine);
+      }
+
+      // Harmonics of the single tone.
+      if (pPlan->demodulatorCount > pPlan->toneCount)
+      {
+        demodulateHarmonics(conversion_value, sine, cosine);
+      }
+
+      DCSubSum += conversion_value;
+    }
+
+    // DAC code of the tick two blocks later.
+    p_dac[n] = generateDACCode();
+
+    if (pPlan->decimationRatio == 1)
+    {
+      checkSubsampling(1);
+    }
+    else
+    {
+      DecimationSum += conversion_value;
+
+      if (++DecimationCounter >= pPlan->decimationRatio)
+      {
+        demodulateDecimatedSample(DecimationSum);
+
+        DecimationSum = 0;
+        DecimationCounter = 0;
+      }
+    }
+  }
+}
+#else
+/***
+  * @Brief      Demodulates the decimated samples queued by the tick ISR.
+  */
+static void processDecimatedQueue(void)
+{
+  int32_t decimated_sample;
+
+  while (QueueGeneric_IsEmpty(&DecimatedQueue) == FALSE)
+  {
+    QueueGeneric_Dequeue(&DecimatedQueue, (uint8_t *)&decimated_sample);
+
+    demodulateDecimatedSample(decimated_sample);
+  }
+}
+#endif
+
+/***
+  * @Brief      Places multisine tones on the harmonics of a common base frequency.
+  *             Smallest base divider which satisfies the frequency error limit
+  *             is chosen, since it gives the shortest base period.
+  *
+  * @Param      pFrequency->Tone frequencies. Replaced with the placed frequencies.
+  * @Param      toneCount->Number of tones.
+  *
+  * @Return     Base frequency.
+  */
+static double placeTonesOnHarmonics(double *pFrequency, uint8_t toneCount)
+{
+  double lowest_frequency;
+  double base_frequency;
+  double error;
+  double max_error;
+  double best_error = 1.0;
+  uint32_t base_divider = 1;
+
+  lowest_frequency = pFrequency[0];
+  for (uint8_t i = 1; i < toneCount; i++)
+  {
+    if (pFrequency[i] < lowest_frequency)
+    {
+      lowest_frequency = pFrequency[i];
+    }
+  }
+
+  /* Search for the base divider. */
+  for (uint32_t divider = 1; divider <= MULTISINE_MAX_BASE_DIVIDER; divider++)
+  {
+    base_frequency = lowest_frequency / divider;
+    max_error = 0.0;
+
+    for (uint8_t i = 0; i < toneCount; i++)
+    {
+      error = fabs(floor(pFrequency[i] / base_frequency + 0.5) * base_frequency - \
+        pFrequency[i]) / pFrequency[i];
+
+      /* Tones which fall on the same harmonic aren't separable. */
+      for (uint8_t j = 0; j < i; j++)
+      {
+        if (floor(pFrequency[i] / base_frequency + 0.5) == \
+            floor(pFrequency[j] / base_frequency + 0.5))
+        {
+          error = 1.0;
+        }
+      }
+
+      if (error > max_error)
+      {
+        max_error = error;
+      }
+    }
+
+    if (max_error < best_error)
+    {
+      best_error = max_error;
+      base_divider = divider;
+    }
+
+    if (max_error <= MULTISINE_MAX_REL_FREQ_ERROR)
+    {
+      break;
+    }
+  }
+
+  /* Place tones. */
+  base_frequency = lowest_frequency / base_divider;
+  for (uint8_t i = 0; i < toneCount; i++)
+  {
+    pFrequency[i] = floor(pFrequency[i] / base_frequency + 0.5) * base_frequency;
+  }
+
+  return base_frequency;
+}
+
+/***
+  * @Brief      Calculates peak of the superposed unit amplitude tones. Tones
+  *             should be harmonics of the base frequency, so one base period
+  *             is evaluated.
+  *
+  * @Param      pFrequency->Tone frequencies.
+  * @Param      pPhase->Initial phases of the tones.
+  * @Param      toneCount->Number of tones.
+  * @Param      baseFrequency->Base frequency of the tones.
+  *
+  * @Return     Peak value, with safety factor.
+  */
+static float calculateCrestPeak(double *pFrequency, uint64_t *pPhase, uint8_t toneCount,
+                                double baseFrequency)
+{
+  uint64_t phase[EIS_CORE_MAX_TONES];
+  uint64_t increment[EIS_CORE_MAX_TONES];
+  int32_t value;
+  int32_t peak = 0;
+
+  /* Harmonic number times the phase step of an evaluation point. */
+  for (uint8_t i = 0; i < toneCount; i++)
+  {
+    phase[i] = pPhase[i];
+    increment[i] = ((uint64_t)floor(pFrequency[i] / baseFrequency + 0.5)) << \
+      (64 - CREST_FACTOR_EVALUATION_BITS);
+  }
+
+  /* Evaluate one base period. */
+  for (uint32_t n = 0; n < (1U << CREST_FACTOR_EVALUATION_BITS); n++)
+  {
+    value = 0;
+
+    for (uint8_t i = 0; i < toneCount; i++)
+    {
+      value += WaveformTable_GetSine((uint32_t)(phase[i] >> PHASE_TO_TABLE_PHASE_SHIFT));
+      phase[i] += increment[i];
+    }
+
+    if (value < 0)
+    {
+      value = -value;
+    }
+
+    if (value > peak)
+    {
+      peak = value;
+    }
+  }
+
+  return ((((float)peak) / WAVEFORM_TABLE_AMPLITUDE) * CREST_FACTOR_SAFETY_FACTOR);
+}
+
+/***
+  * @Brief      Converts angle to phase accumulator value.
+  *
+  * @Param      angle->Angle in radians.
+  */
+static uint64_t radiansToPhase(double angle)
+{
+  double cycle;
+
+  cycle = fmod(angle / (2.0 * M_PI), 1.0);
+  if (cycle < 0.0)
+  {
+    cycle += 1.0;
+  }
+
+  /* Prevent overflow due to rounding. */
+  if (cycle >= 1.0)
+  {
+    cycle = 0.0;
+  }
+
+  return ((uint64_t)(cycle * PHASE_FULL_CYCLE));
+}
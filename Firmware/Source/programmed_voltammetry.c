@@ -0,0 +1,208 @@
+/**
+  * @author     Onur Efe
+  */ 
+
+#include "generic.h"
+#include "programmed_voltammetry.h"
+#include "voltammetry_core.h"
+#include "waveform_program.h"
+#include "middlewares.h"
+
+/* Private constants. --------------------------------------------------------*/
+// Virtual ground DAC code.
+#define VGND_DAC_CODE                                   ((MAX_UINT16 + 1) / 2)
+
+/* Private function prototypes.-----------------------------------------------*/
+static void     measurementCompletedEventHandler(void);
+static void     newDatapointEventHandler(float datapoint, uint8_t edgeIndex);
+
+/* Private variables.---------------------------------------------------------*/
+// During initialization.
+static VoltammetryCore_AnalogConfig_t                   AnalogConfig;
+
+// For datapoint process;
+static double                                           ADC1LSBCurrent;
+static double                                           CurrentGainCorrection;
+static double                                           CurrentOffsetCorrection;
+
+// New datapoint delegate.
+static ProgrammedVoltammetry_NewDatapointDelegate_t     NewDatapointDelegate;
+
+// Measurement callback function pointer.
+static ProgrammedVoltammetry_MeasurementCompletedDelegate_t     MeasurementCompletedDelegate;
+static ProgrammedVoltammetry_MeasurementAbortedDelegate_t       MeasurementAbortedDelegate;
+
+// State.
+static ProgrammedVoltammetry_State_t                    State = PROGRAMMED_VOLTAMMETRY_STATE_UNINIT;
+
+/* Public function implementations -------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  * 
+  * @Param      pSetupParams-> Pointer to data structure which holds setup 
+  *             parameters.
+  */
+void ProgrammedVoltammetry_Setup(ProgrammedVoltammetry_SetupParams_t *pSetupParams)
+{
+  float tick_period;
+  VoltammetryCore_SetupParams_t vcore_setup_params;
+  
+  /* Check state. */
+  if (State == PROGRAMMED_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Programmed voltammetry module setup function called when the module is operating.\n");
+  }
+ 
+  // Setup of voltammetry core.
+  vcore_setup_params.datapointCount = pSetupParams->datapointCount;
+  vcore_setup_params.equilibriumPeriod = pSetupParams->equilibriumPeriod;
+  vcore_setup_params.generatorFunctionInterface = WaveformProgram_GetDACCode;
+  vcore_setup_params.waveform.type = VOLTAMMETRY_CORE_WAVEFORM_CUSTOM;
+  vcore_setup_params.maxRelSamplingFreqErr = pSetupParams->maxRelSamplingFreqErr;
+  vcore_setup_params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  vcore_setup_params.newDatapointDelegate = newDatapointEventHandler;
+  vcore_setup_params.samplingFrequency = pSetupParams->samplingFrequency;
+  vcore_setup_params.samplingWindow = pSetupParams->samplingWindow;
+  VoltammetryCore_Setup(&vcore_setup_params, &tick_period);
+  
+  // Program generates the whole potential; full signal scaling, bias at the ground.
+  AnalogConfig.fbPath = pSetupParams->feedbackPath;
+  AnalogConfig.binaryScaling = BOARD_BINARY_SIGNAL_SCALING_4_4;
+  AnalogConfig.decimalScaling = BOARD_DECIMAL_SIGNAL_SCALING_1_1;
+  AnalogConfig.biasDACCode = VGND_DAC_CODE;
+  AnalogConfig.biasPotential = 0.0;
+  AnalogConfig.signalDAC1LSBPotential = \
+    Board_GetSignalDAC1LSBAppliedPotential(AnalogConfig.binaryScaling, AnalogConfig.decimalScaling);
+  
+  // Program is compiled into the ticks and the codes of the scaling.
+  WaveformProgram_Load(pSetupParams->pProgram, pSetupParams->instructionCount, tick_period,
+                       AnalogConfig.signalDAC1LSBPotential);
+  
+  // Save correction values.
+  CurrentGainCorrection = pSetupParams->currentGainCorrection;
+  CurrentOffsetCorrection = pSetupParams->currentOffsetCorrection;
+  
+  // Calculate ADC 1LSB current.
+  ADC1LSBCurrent = Board_GetADC1LSBCurrent(AnalogConfig.fbPath);
+
+  // Set callback function pointer.
+  MeasurementCompletedDelegate = pSetupParams->measurementCompletedDelegate;
+  MeasurementAbortedDelegate = pSetupParams->measurementAbortedDelegate;
+  NewDatapointDelegate = pSetupParams->newDatapointDelegate;
+  
+  State = PROGRAMMED_VOLTAMMETRY_STATE_READY;
+}
+
+/**
+  * @Brief      Starts programmed voltammetry.
+  */
+void ProgrammedVoltammetry_Start(void)
+{
+  // Guard for improper calls.
+  if (State != PROGRAMMED_VOLTAMMETRY_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Programmed voltammetry module Start function called when the module isn't ready.\n");
+  }
+  
+  // Rewind the program, signal DAC starts at its first level.
+  WaveformProgram_Rewind();
+  
+  // Turn on analog circuitry.
+  VoltammetryCore_TurnOnAnalog(&AnalogConfig, WaveformProgram_GetDACCode(0));
+  
+  // Start voltammetry core.
+  VoltammetryCore_Start();
+      
+  State = PROGRAMMED_VOLTAMMETRY_STATE_OPERATING;
+}
+
+/**
+  * @Brief      Programmed voltammetry task executer and event processor.
+  */
+void ProgrammedVoltammetry_Execute(void)
+{
+  // If not operating, return.
+  if (State != PROGRAMMED_VOLTAMMETRY_STATE_OPERATING)
+  {
+    return;
+  }
+  
+  // Run subthreads.
+  VoltammetryCore_Execute();
+
+  // Datapoints were lost if the core overran, abort the measurement.
+  if ((State == PROGRAMMED_VOLTAMMETRY_STATE_OPERATING) && VoltammetryCore_IsOverrun())
+  {
+    ProgrammedVoltammetry_Stop();
+    
+    if (MeasurementAbortedDelegate != NULL)
+    {
+      MeasurementAbortedDelegate();
+    }
+  }
+}
+
+/***
+  * @Brief      Stops programmed voltammetry measurement.
+  */
+void ProgrammedVoltammetry_Stop(void)
+{
+  // Guard for improper calls.
+  if (State != PROGRAMMED_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Programmed voltammetry module Stop function called when the module isn't operating.\n");
+  }
+  
+  // Stop submodules.
+  VoltammetryCore_Stop();
+  
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+  
+  State = PROGRAMMED_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+ProgrammedVoltammetry_State_t ProgrammedVoltammetry_GetState(void)
+{
+  return State;
+}
+
+/* Private function implementations. -----------------------------------------*/
+/***
+  * @Brief      Callback function which is triggered when new datapoint parsed.
+  */
+static void newDatapointEventHandler(float datapoint, uint8_t edgeIndex)
+{
+  // Call delegate if it's set.
+  if (NewDatapointDelegate != NULL)
+  {
+    NewDatapointDelegate((float)(ADC1LSBCurrent * datapoint * CurrentGainCorrection + \
+                         CurrentOffsetCorrection));
+  }
+}
+                                    
+/***
+  * @Brief      Callback function which is triggered when the 
+  *             measurement is completed.
+  */
+static void measurementCompletedEventHandler(void)
+{
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+      
+  // Send signal to the upper layer via callback function.
+  if (MeasurementCompletedDelegate != NULL)
+  {
+    MeasurementCompletedDelegate();
+  }
+      
+  State = PROGRAMMED_VOLTAMMETRY_STATE_READY;
+}
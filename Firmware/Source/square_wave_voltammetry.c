@@ -0,0 +1,299 @@
+/**
+  * @author     Onur Efe
+  */
+
+#include "generic.h"
+#include "square_wave_voltammetry.h"
+#include "voltammetry_core.h"
+#include "middlewares.h"
+
+/* Private function prototypes.-----------------------------------------------*/
+static uint16_t generatorFunctionImplementation(int32_t tickCounter);
+static void     measurementCompletedEventHandler(void);
+static void     newDatapointEventHandler(float datapoint, uint8_t edgeIndex);
+
+/* Private variables.---------------------------------------------------------*/
+// During initialization. Staircase holds the analog configuration.
+static VoltammetryCore_Staircase_t                      Staircase;
+
+// Waveform generator. Codes are in Q16.16 format. Each step is a period, which
+// consists of the forward and the reverse pulses.
+static uint32_t                                         PulseTicks;
+
+// For datapoint process;
+static double                                           ADC1LSBCurrent;
+static double                                           CurrentGainCorrection;
+static double                                           CurrentOffsetCorrection;
+
+// New datapoint delegate.
+static SquareWaveVoltammetry_NewDatapointDelegate_t     NewDatapointDelegate;
+
+// Measurement callback function pointer.
+static SquareWaveVoltammetry_MeasurementCompletedDelegate_t     MeasurementCompletedDelegate;
+static SquareWaveVoltammetry_MeasurementAbortedDelegate_t       MeasurementAbortedDelegate;
+
+// State.
+static SquareWaveVoltammetry_State_t                    State = SQUARE_WAVE_VOLTAMMETRY_STATE_UNINIT;
+
+/* Public function implementations -------------------------------------------*/
+/**
+  * @Brief      Configures module. Should be called before any other function.
+  *             Core samples twice per period, its downsampling period is the pulse.
+  *             So the sampling points are on the pulse edges.
+  *
+  * @Param      pSetupParams-> Pointer to data structure which holds setup
+  *             parameters.
+  */
+void SquareWaveVoltammetry_Setup(SquareWaveVoltammetry_SetupParams_t *pSetupParams)
+{
+  float tick_period;
+  uint32_t window_ticks;
+  VoltammetryCore_SamplingPattern_t pattern;
+  VoltammetryCore_SetupParams_t vcore_setup_params;
+
+  /* Check state. */
+  if (State == SQUARE_WAVE_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Square wave voltammetry module setup function called when the module is operating.\n");
+  }
+
+  if ((pSetupParams->stepPotential <= 0.0f) || (pSetupParams->frequency <= 0.0f) || \
+      (pSetupParams->samplingWindow <= 0.0f))
+  {
+    ExceptionHandler_ThrowException(\
+      "Square wave voltammetry step, frequency and sampling window should be positive.\n");
+  }
+
+  // Steps include both of the start and the end potentials. Forward pulse is in the
+  // scan direction.
+  VoltammetryCore_PlanStaircase(&Staircase, pSetupParams->startPotential,
+                                pSetupParams->endPotential, pSetupParams->stepPotential,
+                                pSetupParams->amplitude, VOLTAMMETRY_CORE_PULSES_BIPOLAR);
+
+  // Setup of voltammetry core. Forward and reverse currents are two datapoints.
+  vcore_setup_params.datapointCount = (uint16_t)(2U * Staircase.stepCount);
+  vcore_setup_params.equilibriumPeriod = pSetupParams->equilibriumPeriod;
+  vcore_setup_params.generatorFunctionInterface = generatorFunctionImplementation;
+  vcore_setup_params.waveform.type = VOLTAMMETRY_CORE_WAVEFORM_CUSTOM;
+  vcore_setup_params.maxRelSamplingFreqErr = pSetupParams->maxRelSamplingFreqErr;
+  vcore_setup_params.measurementCompletedDelegate = measurementCompletedEventHandler;
+  vcore_setup_params.newDatapointDelegate = newDatapointEventHandler;
+  vcore_setup_params.samplingFrequency = 2.0f * pSetupParams->frequency;
+  vcore_setup_params.samplingWindow = 0.0f;
+  VoltammetryCore_Setup(&vcore_setup_params, &tick_period);
+
+  // Pattern has an edge at the end of each pulse, so the currents are paired on the
+  // edges rather than on their order.
+  PulseTicks = VoltammetryCore_GetDownsamplingNumber();
+  window_ticks = (uint32_t)((pSetupParams->samplingWindow * PulseTicks) + 0.5f);
+
+  if (window_ticks == 0)
+  {
+    window_ticks = 1;
+  }
+  else if (window_ticks > PulseTicks)
+  {
+    window_ticks = PulseTicks;
+  }
+
+  pattern.periodTicks = 2U * PulseTicks;
+  pattern.edgeCount = 2;
+  pattern.edgeTicks[0] = PulseTicks;
+  pattern.edgeTicks[1] = 2U * PulseTicks;
+  pattern.windowTicks[0] = window_ticks;
+  pattern.windowTicks[1] = window_ticks;
+  VoltammetryCore_SetSamplingPattern(&pattern);
+
+  // Save feedback path.
+  Staircase.analogConfig.fbPath = pSetupParams->feedbackPath;
+
+  // Save correction values.
+  CurrentGainCorrection = pSetupParams->currentGainCorrection;
+  CurrentOffsetCorrection = pSetupParams->currentOffsetCorrection;
+
+  // Calculate ADC 1LSB current.
+  ADC1LSBCurrent = Board_GetADC1LSBCurrent(Staircase.analogConfig.fbPath);
+
+  // Set callback function pointer.
+  MeasurementCompletedDelegate = pSetupParams->measurementCompletedDelegate;
+  MeasurementAbortedDelegate = pSetupParams->measurementAbortedDelegate;
+  NewDatapointDelegate = pSetupParams->newDatapointDelegate;
+
+  State = SQUARE_WAVE_VOLTAMMETRY_STATE_READY;
+}
+
+/**
+  * @Brief      Starts square wave voltammetry.
+  */
+void SquareWaveVoltammetry_Start(void)
+{
+  // Guard for improper calls.
+  if (State != SQUARE_WAVE_VOLTAMMETRY_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Square wave voltammetry module Start function called when the module isn't ready.\n");
+  }
+
+  // Pairing starts from the first step.
+  Staircase.stepIndex = 0;
+
+  // Turn on analog circuitry, signal DAC starts at the start potential.
+  VoltammetryCore_TurnOnAnalog(&Staircase.analogConfig, generatorFunctionImplementation(-1));
+
+  // Start voltammetry core.
+  VoltammetryCore_Start();
+
+  State = SQUARE_WAVE_VOLTAMMETRY_STATE_OPERATING;
+}
+
+/**
+  * @Brief      Square wave voltammetry task executer and event processor.
+  */
+void SquareWaveVoltammetry_Execute(void)
+{
+  // If not operating, return.
+  if (State != SQUARE_WAVE_VOLTAMMETRY_STATE_OPERATING)
+  {
+    return;
+  }
+
+  // Run subthreads.
+  VoltammetryCore_Execute();
+
+  // Datapoints were lost if the core overran, abort the measurement.
+  if ((State == SQUARE_WAVE_VOLTAMMETRY_STATE_OPERATING) && VoltammetryCore_IsOverrun())
+  {
+    SquareWaveVoltammetry_Stop();
+    
+    if (MeasurementAbortedDelegate != NULL)
+    {
+      MeasurementAbortedDelegate();
+    }
+  }
+}
+
+/***
+  * @Brief      Stops square wave voltammetry measurement.
+  */
+void SquareWaveVoltammetry_Stop(void)
+{
+  // Guard for improper calls.
+  if (State != SQUARE_WAVE_VOLTAMMETRY_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Square wave voltammetry module Stop function called when the module isn't operating.\n");
+  }
+
+  // Stop submodules.
+  VoltammetryCore_Stop();
+
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+
+  State = SQUARE_WAVE_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Gets module's state.
+  *
+  * @Return     State of module.
+  */
+SquareWaveVoltammetry_State_t SquareWaveVoltammetry_GetState(void)
+{
+  return State;
+}
+
+/***
+  * @Brief      Checks whether the DACs cover the scan with the pulses around it.
+  *
+  * @Param      startPotential->Start potential of the staircase.
+  * @Param      endPotential->End potential of the staircase.
+  * @Param      amplitude->Pulse height.
+  *
+  * @Return     TRUE if the scan is covered, FALSE otherwise.
+  */
+Bool_t SquareWaveVoltammetry_IsPotentialRangeValid(float startPotential, float endPotential,
+                                                   float amplitude)
+{
+  return VoltammetryCore_IsStaircaseValid(startPotential, endPotential, amplitude,
+                                          VOLTAMMETRY_CORE_PULSES_BIPOLAR);
+}
+
+/* Private function implementations. -----------------------------------------*/
+/***
+  * @Brief      Callback function which is triggered when new datapoint parsed.
+  *             Edge zero is the end of the forward pulse, edge one is the end of
+  *             the reverse pulse. Step is reported after its reverse current.
+  */
+static void newDatapointEventHandler(float datapoint, uint8_t edgeIndex)
+{
+  float current;
+  float potential;
+  float forward_current;
+
+  current = (float)(ADC1LSBCurrent * datapoint * CurrentGainCorrection + \
+                    CurrentOffsetCorrection);
+
+  // Call delegate if it's set, once both currents of the step are sampled.
+  if (VoltammetryCore_PairStaircaseCurrents(&Staircase, current, edgeIndex, &potential,
+                                            &forward_current) && (NewDatapointDelegate != NULL))
+  {
+    NewDatapointDelegate(potential, forward_current, current, forward_current - current);
+  }
+}
+
+/***
+  * @Brief      Callback function which is triggered when the
+  *             measurement is completed.
+  */
+static void measurementCompletedEventHandler(void)
+{
+  // Turn off analog circuitry.
+  VoltammetryCore_TurnOffAnalog();
+
+  // Send signal to the upper layer via callback function.
+  if (MeasurementCompletedDelegate != NULL)
+  {
+    MeasurementCompletedDelegate();
+  }
+
+  State = SQUARE_WAVE_VOLTAMMETRY_STATE_READY;
+}
+
+/***
+  * @Brief      Function which is called when voltammetry core updates
+  *             generated signal. Called from the tick ISR, so it uses integer
+  *             arithmetic only. Pulses are switched on the downsampling period
+  *             edges. Start potential is held during the equilibrium period.
+  *
+  * @Param      tickCounter->Ticks since the end of the equilibrium period.
+  */
+static uint16_t generatorFunctionImplementation(int32_t tickCounter)
+{
+  uint32_t pulse;
+  uint32_t step;
+  int64_t code;
+
+  if (tickCounter < 0)
+  {
+    return VoltammetryCore_RoundCode(Staircase.startCode);
+  }
+
+  pulse = (uint32_t)tickCounter / PulseTicks;
+  step = pulse >> 1;
+
+  // Hold the last step, until the core stops.
+  code = VoltammetryCore_GetStepCode(&Staircase, step);
+
+  if (pulse & 1U)
+  {
+    code -= Staircase.pulseIncrement;
+  }
+  else
+  {
+    code += Staircase.pulseIncrement;
+  }
+
+  return VoltammetryCore_RoundCode(code);
+}
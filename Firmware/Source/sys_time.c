@@ -1,8 +1,8 @@
-#include "sys_time.h"
-
-volatile uint32_t SysTime = 0U;
-
-uint32_t SysTime_GetTick(void)
-{
-  return SysTime;
+#include "sys_time.h"
+
+volatile uint32_t SysTime = 0U;
+
+uint32_t SysTime_GetTick(void)
+{
+  return SysTime;
 }
\ No newline at end of file
@@ -1,371 +1,1136 @@
-/**
-  * @author     Onur Efe
-  */ 
-
-#include "voltammetry_core.h"
-#include "math.h"
-#include "board.h"
-#include "middlewares.h"
-    
-/* Private constants ---------------------------------------------------------*/
-#define MAX_TICK_FREQUENCY                      50000U
-
-#define DATA_SAMPLED_EVENT                      0x01
-
-#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
-
-#define DOWNSAMPLING_FILTER_MAGIC_NUMBER        1.333
-
-/* Public variables ----------------------------------------------------------*/
-uint16_t ADCConversionResult[2];
-
-/* Private function prototypes -----------------------------------------------*/
-static uint16_t defaultGeneratorFunctionImplementation(int32_t tickValue);
-static void adjustParameters(uint32_t timClockFrequency, uint32_t timMaxReload,
-                             uint16_t timMaxPrescaler, float requiredSamplingFreq,
-                             float maxRelSamplingFreqErr, uint32_t *pTimReload,
-                             uint16_t *pTimPrescaler, uint32_t *pDownsamplingNumber,
-                             float *pTickPeriod);
-
-/* Private variables ---------------------------------------------------------*/
-// During operation.
-static uint16_t                 NumberOfDatapoints;
-static uint16_t                 DatapointCounter;
-
-static int32_t                  TickCounterReset;
-static int32_t                  TickCounter;
-static int32_t                  NextSamplingTick;
-static uint32_t                 DownsamplingNumber;
-                 
-static float                    DownsamplingFilterCoefficient;
-static float                    DownsamplingFilterOutput1;
-static float                    DownsamplingFilterOutput2;
-static float                    DownsamplingFilterOutput3;
-static float                    DownsamplingFilterOutput4;
-
-static float                    DownsamplingResult;
-
-static int16_t                  ConversionValue;
-
-// Function pointers.
-static VoltammetryCore_NewDatapointDelegate_t           NewDatapointDelegate;
-static VoltammetryCore_MeasurementCompletedDelegate_t   MeasurementCompletedDelegate;
-static VoltammetryCore_GeneratorFunctionInterface_t     GeneratorFunctionInterface;
-
-// State.
-static VoltammetryCore_State_t  State = VOLTAMMETRY_CORE_STATE_UNINIT;
-
-// Events.
-static volatile uint8_t         Events;
-
-// Lock status.
-static uint8_t                  IsLocked = FALSE;
-
-
-/* Public function implementations -------------------------------------------*/
-/***
-  * @Brief      Interrupt service routine for timer period elapsed event. Should 
-  *             be exported.
-  */
-void VoltammetryCore_TimerTickISR(void)
-{
-  static uint16_t dac_code;
-  
-  // Discard incompatible operations or race conditions.
-  if ((State != VOLTAMMETRY_CORE_STATE_OPERATING) || (IsLocked == TRUE))
-  {
-    return;
-  }
-  
-  Board_DACSignalSetnCS();
-  
-  // Get last conversion result.
-  ConversionValue = Board_ADCGetValue();
-  
-  // Trigger next conversion.
-  Board_ADCTriggerConvert();
-  
-  Board_DACSignalResetnCS();
-  
-  // Filter conversion value with fourth order filter. Filter is cascaded ema filter.
-  DownsamplingFilterOutput1 *= (1.0f - DownsamplingFilterCoefficient);
-  DownsamplingFilterOutput1 += (ConversionValue * DownsamplingFilterCoefficient);
-  
-  DownsamplingFilterOutput2 *= (1.0f - DownsamplingFilterCoefficient);
-  DownsamplingFilterOutput2 += (DownsamplingFilterOutput1 * DownsamplingFilterCoefficient);
-  
-  DownsamplingFilterOutput3 *= (1.0f - DownsamplingFilterCoefficient);
-  DownsamplingFilterOutput3 += (DownsamplingFilterOutput2 * DownsamplingFilterCoefficient);
-  
-  DownsamplingFilterOutput4 *= (1.0f - DownsamplingFilterCoefficient);
-  DownsamplingFilterOutput4 += (DownsamplingFilterOutput3 * DownsamplingFilterCoefficient);
-
-  // Generate DAC code.
-  dac_code = GeneratorFunctionInterface(TickCounter);
-  
-  // Set Signal DAC value. Sequence may seem weird. But this is used for framing data.
-  Board_HUBSPISend(dac_code);
-  
-  if (TickCounter >= NextSamplingTick)
-  {
-    NextSamplingTick += DownsamplingNumber;
-    DownsamplingResult = DownsamplingFilterOutput4;
-    Events |= DATA_SAMPLED_EVENT;                      // Set data sampled event.
-  }
-  
-  TickCounter++;
-}
-
-/***
-  * @Brief      Initializes the module. Should be called before any other function.
-  *             It's assumed that interrupt priority is always higher than the 
-  *             execute function's priority.
-  * @Param      pSetupParams-> Setup parameters for the module.
-  * @Param      pTickPeriod-> Pointer to return calculated tick period.
-  */
-void VoltammetryCore_Setup(VoltammetryCore_SetupParams_t *pSetupParams, 
-                           float *pTickPeriod)
-{
-  uint32_t tim_reload;
-  uint16_t tim_prescaler;
-  float tick_period;
-  
-  /* Check state. */
-  if (State == VOLTAMMETRY_CORE_STATE_OPERATING)
-  {
-    ExceptionHandler_ThrowException("Voltammetry core module setup function called when the module is \
-                                     operating.\n");
-  }
-  
-  /* Adjust parameters. */
-  adjustParameters(VOLTAMMETRY_CORE_TIMER_FREQUENCY, VOLTAMMETRY_CORE_TIMER_MAX_RELOAD, 
-                   VOLTAMMETRY_CORE_TIMER_MAX_PRESCALER, pSetupParams->samplingFrequency, 
-                   pSetupParams->maxRelSamplingFreqErr, &tim_reload, &tim_prescaler, 
-                   &DownsamplingNumber, &tick_period);
-
-  /* Set local parameters. */
-  NumberOfDatapoints = pSetupParams->datapointCount;
-  
-  /* Configure timer. */
-  TIM_PrescalerConfig(VOLTAMMETRY_CORE_TIMER, tim_prescaler, TIM_PSCReloadMode_Immediate);
-  TIM_SetAutoreload(VOLTAMMETRY_CORE_TIMER, tim_reload);
-  
-  /* Tick counter initialized from negative value. This is due to apply equilibrium
-    period naturally. */
-  TickCounterReset = -(int32_t)((pSetupParams->equilibriumPeriod / tick_period) + 0.5f);
-  DownsamplingFilterCoefficient = 1.0f / ((float)(DOWNSAMPLING_FILTER_MAGIC_NUMBER * DownsamplingNumber));
-  
-  // Set delegates and interfaces.
-  NewDatapointDelegate = pSetupParams->newDatapointDelegate;
-  MeasurementCompletedDelegate = pSetupParams->measurementCompletedDelegate;
-  GeneratorFunctionInterface = pSetupParams->generatorFunctionInterface;
-  
-  // There should be a generator function!
-  if (!GeneratorFunctionInterface)
-  {
-    GeneratorFunctionInterface = defaultGeneratorFunctionImplementation;
-  }
-  
-  *pTickPeriod = tick_period;
-  
-  // Set state to ready.
-  State = VOLTAMMETRY_CORE_STATE_READY;
-}
-
-void VoltammetryCore_Start(void)
-{
-  // If not ready; throw exception.
-  if (State != VOLTAMMETRY_CORE_STATE_READY)
-  {
-    ExceptionHandler_ThrowException(\
-      "Voltammetry core Start function called when the module isn't ready.\n");
-  }
-  
-  // Reset modified variables.
-  DownsamplingFilterOutput1 = 0.0f;
-  DownsamplingFilterOutput2 = 0.0f;
-  DownsamplingFilterOutput3 = 0.0f;
-  DownsamplingFilterOutput4 = 0.0f;
-    
-  TickCounter = TickCounterReset;
-  NextSamplingTick = DownsamplingNumber;
-  DatapointCounter = 0U;
-      
-  // Set initial potential.
-  Board_DACSignalResetnCS();
-  Board_HUBSPISend(GeneratorFunctionInterface(0.0f));
-
-  // Trigger first conversion.
-  Board_ADCTriggerConvert();
-    
-  // Enable timer.
-  TIM_Cmd(VOLTAMMETRY_CORE_TIMER, ENABLE);
-  
-  // Reset events.
-  Events = 0;
-  
-  State = VOLTAMMETRY_CORE_STATE_OPERATING;
-}
-
-/***
-  * @Brief      Module task executer and event processor.
-  */
-void VoltammetryCore_Execute(void)
-{
-  uint8_t __events;
-  
-  // If the module isn't initialized. 
-  if (State != VOLTAMMETRY_CORE_STATE_OPERATING)
-  {
-    return;
-  }
- 
-  __events = Events;
-  
-  // If a data is sampled.
-  if (__events & DATA_SAMPLED_EVENT)
-  {
-    if (State == VOLTAMMETRY_CORE_STATE_OPERATING)
-    {
-      IsLocked = TRUE;
-      
-      NewDatapointDelegate(DownsamplingResult);
-      
-      if (++DatapointCounter >= NumberOfDatapoints)
-      {
-        TIM_Cmd(VOLTAMMETRY_CORE_TIMER, DISABLE);
-      
-        // Set Signal DAC value.
-        Board_DACSignalResetnCS();
-        Board_HUBSPISend(VGND_DAC_CODE);
-        
-        // Wait until the HUB SPI finished it's process.
-        while (Board_HUBSPIIsBusy());
-        Board_DACSignalSetnCS();
-        
-        State = VOLTAMMETRY_CORE_STATE_READY;
-        
-        // If measurement completed delegate is set; call it.
-        if (MeasurementCompletedDelegate)
-        {
-          MeasurementCompletedDelegate();
-        }
-      }
-      
-      IsLocked = FALSE;    
-    }
-    
-    __events ^= DATA_SAMPLED_EVENT;
-  }
-  
-  Events = __events;
-}
-
-/***
-  * @Brief      Stops the module.
-  */
-void VoltammetryCore_Stop(void)
-{
-  // If not operating; throw exception.
-  if (State != VOLTAMMETRY_CORE_STATE_OPERATING)
-  {
-    ExceptionHandler_ThrowException(\
-      "Voltammetry core Stop function called when the module isn't operating.\n");
-  }
-  
-  TIM_Cmd(VOLTAMMETRY_CORE_TIMER, DISABLE);
-      
-  // Set Signal DAC value. 
-  Board_DACSignalResetnCS();
-  Board_HUBSPISend(VGND_DAC_CODE);
-      
-  // Wait until the HUB SPI finishes it's process.
-  while (Board_HUBSPIIsBusy());
-  Board_DACSignalSetnCS();
-      
-  // State to pending ready.
-  State = VOLTAMMETRY_CORE_STATE_READY;
-}
-
-/***
-  * @Brief      Returns state of the voltammetry core module.
-  */
-VoltammetryCore_State_t VoltammetryCore_GetState(void)
-{
-  return State;
-}
-
-/* Private function implementations-------------------------------------------*/
-static uint16_t defaultGeneratorFunctionImplementation(int32_t tickValue)
-{
-  return VGND_DAC_CODE;
-}
-                                    
-/***
-  * @Brief      Adjusts timer parameters according to required sampling frequency 
-  *             and tolerances.
-  * @Param      timClockFrequency-> Clock frequency of the timer.                     
-  * @Param      timMaxReload-> Maximum reload value of the timer.
-  * @Param      timMaxPrescaler-> Maximum prescaler value of the timer.
-  * @Param      requiredSamplingFreq-> Required sampling frequency value.
-  * @Param      maxRelSamplingFreqErr-> There may be some error when adjusting timer.
-  *             There is a limit for this value. This parameter dictates the maximum
-  *             relative sampling frequency error.
-  * @Param      pTimReload-> Pointer for the calculated reload value.
-  * @Param      pTimPrescaler-> Pointer for the calculated prescaler value.
-  * @Param      pDownsamplingNumber-> Downsampling number indicates the downsampling
-  *             ratio. Conversion value isn't recorded every timer ISR. It has been
-  *             passed from a low pass filter, then downsampled and stored. Downsampling
-  *             number is always equal to a power of 2.
-  * @Param      pTickPeriod->Pointer for calculated tick period.
-  */
-static void adjustParameters(uint32_t timClockFrequency, uint32_t timMaxReload, 
-                             uint16_t timMaxPrescaler, float requiredSamplingFreq, 
-                             float maxRelSamplingFreqErr, uint32_t *pTimReload,
-                             uint16_t *pTimPrescaler, uint32_t *pDownsamplingNumber, 
-                             float *pTickPeriod)
-{
-  uint32_t downsampling_number;
-  uint32_t tim_min_reload;
-  float sampling_frequency;    
-  float relative_sampling_frequency_error;
-  
-  // Chose tick frequency as high as possible. 
-  // Maximum sampling frequency error should be lower than maximum relative frequency error.
-  for (uint16_t tim_prescaler = 0; tim_prescaler <= timMaxPrescaler; tim_prescaler++)
-  {
-    tim_min_reload = (timClockFrequency / (tim_prescaler + 1)) / MAX_TICK_FREQUENCY;
-    
-    // Search for reload values.
-    for (uint32_t tim_reload = tim_min_reload;  tim_reload < timMaxReload; tim_reload++)
-    {
-      // Calculate required downsampling number.
-      downsampling_number = (uint32_t)((timClockFrequency / ((tim_prescaler + 1) * \
-                                        tim_reload * requiredSamplingFreq)) + 0.5f);
-      
-      if (downsampling_number == 0)
-      {
-        downsampling_number = 1;
-      }
-      
-      // Back calculate the sampling frequency.
-      sampling_frequency = timClockFrequency / ((tim_prescaler + 1) * tim_reload \
-                                                * downsampling_number);
-      
-      // Calculate relative sampling frequency error.
-      relative_sampling_frequency_error = fabs(sampling_frequency - requiredSamplingFreq) \
-                                          / requiredSamplingFreq;
-      
-      // Test if it satisfies the error condition.
-      if (relative_sampling_frequency_error <= maxRelSamplingFreqErr)
-      {
-        *pTimReload = tim_reload;
-        *pTimPrescaler = tim_prescaler;
-        *pDownsamplingNumber = downsampling_number;
-        *pTickPeriod = ((float)(tim_reload * (tim_prescaler + 1))) / timClockFrequency;
-        
-        return;
-      }
-    }
-  }
+/**
+  * @author     Onur Efe
+  */ 
+
+#include "voltammetry_core.h"
+#include "math.h"
+#include "board.h"
+#include "middlewares.h"
+#include "decimation_filter.h"
+#include "arm_math.h"
+    
+/* Private constants ---------------------------------------------------------*/
+#define MAX_TICK_FREQUENCY                      50000U
+
+#define DATA_SAMPLED_EVENT                      0x01
+
+#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
+
+#define SIGNAL_RANGE_SAFETY_FACTOR              1.05
+
+/* Downsampling number is a multiple of the fir decimation, cic ratio is the rest of it.
+  Cic outputs are queued by the tick ISR, and filtered in blocks by the executer. */
+#define MAX_DOWNSAMPLING_NUMBER                 (DECIMATION_FILTER_FIR_DECIMATION * \
+                                                 DECIMATION_FILTER_CIC_MAX_RATIO)
+
+/* Queue holds the cic outputs of the longest execute latency at the highest datapoint
+  rate of the techniques, four outputs in a datapoint. If it's full anyway, outputs are
+  dropped, and the gap is filled by the next ones; so the blocks stay aligned to the
+  ticks, only the datapoints around the gap are distorted. */
+#define MAX_DATAPOINT_FREQUENCY                 1000U
+#define MAX_EXECUTE_LATENCY_MS                  50U
+#define CIC_QUEUE_LENGTH                        ((DECIMATION_FILTER_FIR_DECIMATION * \
+                                                  MAX_DATAPOINT_FREQUENCY * \
+                                                  MAX_EXECUTE_LATENCY_MS / 1000U) + \
+                                                 DECIMATION_FILTER_FIR_DECIMATION)
+
+// Window outputs are queued with their edge, for the same latency.
+#define WINDOW_QUEUE_LENGTH                     ((MAX_DATAPOINT_FREQUENCY * \
+                                                  MAX_EXECUTE_LATENCY_MS / 1000U) + 2U)
+
+#define PHASE_FULL_CYCLE                        4294967296.0    // 2^32
+
+// Conversion read in a tick belongs to the DAC code generated two ticks before. It's
+// latched at the start of the next tick, and converted after that.
+#define SAMPLE_PIPELINE_DELAY                   2
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+  float                         value;
+  uint8_t                       edgeIndex;
+} WindowOutput_t;
+
+/* Public variables ----------------------------------------------------------*/
+uint16_t ADCConversionResult[2];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint16_t defaultGeneratorFunctionImplementation(int32_t tickValue);
+static uint16_t generateWaveform(void);
+static void processCICQueue(void);
+static void processWindowQueue(void);
+static void processDatapoint(float datapoint, uint8_t edgeIndex);
+static void getStaircaseRange(float startPotential, float endPotential, float amplitude,
+                              VoltammetryCore_PulseDirection_t pulses, float *pMinPotential,
+                              float *pMaxPotential);
+static void adjustParameters(uint32_t timClockFrequency, uint32_t timMaxReload,
+                             uint16_t timMaxPrescaler, float requiredSamplingFreq,
+                             float maxRelSamplingFreqErr, uint32_t *pTimReload,
+                             uint16_t *pTimPrescaler, uint32_t *pDownsamplingNumber,
+                             float *pTickPeriod);
+
+/* Private variables ---------------------------------------------------------*/
+// During operation.
+static uint16_t                 NumberOfDatapoints;
+static uint16_t                 DatapointCounter;
+
+static int32_t                  TickCounterReset;
+static int32_t                  TickCounter;
+static int32_t                  NextSamplingTick;
+static uint32_t                 DownsamplingNumber;
+                 
+// Cic decimator. Registers wrap around, the output is exact since it fits in them.
+static uint32_t                 CICRatio;
+static uint32_t                 CICCountdown;
+static float                    CICScale;
+static uint64_t                 CICIntegrators[DECIMATION_FILTER_CIC_ORDER];
+static uint64_t                 CICCombDelays[DECIMATION_FILTER_CIC_ORDER];
+static int64_t                  CICOutput;
+
+static QueueGeneric_Buffer_t    CICQueue;
+static int64_t                  CICQueueContainer[CIC_QUEUE_LENGTH];
+static uint32_t                 DroppedCICOutputs;      // Not filled yet.
+static volatile Bool_t          IsOverrun;
+
+// Fir decimator. Cic outputs before the first aligned block are skipped.
+static arm_fir_decimate_instance_f32    FIRInstance;
+static float32_t                FIRState[DECIMATION_FILTER_FIR_TAP_COUNT + \
+                                         DECIMATION_FILTER_FIR_DECIMATION - 1];
+static uint32_t                 SkippedCICOutputs;
+static int32_t                  BlockTick;              // Of the next fir output.
+
+// Windowed sampling.
+static VoltammetryCore_SamplingPattern_t        Pattern;
+static float                    WindowScales[VOLTAMMETRY_CORE_MAX_SAMPLING_EDGES];
+static uint8_t                  EdgeIndex;
+static int32_t                  PeriodStartTick;
+static uint32_t                 WindowTicks;            // Of the next edge. Zero selects the decimators.
+static float                    WindowScale;
+static int32_t                  WindowSum;
+static WindowOutput_t           WindowOutput;
+static QueueGeneric_Buffer_t    WindowQueue;
+static WindowOutput_t           WindowQueueContainer[WINDOW_QUEUE_LENGTH];
+
+static int16_t                  ConversionValue;
+
+// Built-in waveform.
+static VoltammetryCore_WaveformType_t   WaveformType;
+static uint32_t                 Phase;
+static uint32_t                 PhaseIncrement;
+static uint32_t                 StepPhase;
+static int32_t                  WaveformOffset;
+static int32_t                  WaveformAmplitude;
+
+// Function pointers.
+static VoltammetryCore_NewDatapointDelegate_t           NewDatapointDelegate;
+static VoltammetryCore_MeasurementCompletedDelegate_t   MeasurementCompletedDelegate;
+static VoltammetryCore_GeneratorFunctionInterface_t     GeneratorFunctionInterface;
+
+// State.
+static VoltammetryCore_State_t  State = VOLTAMMETRY_CORE_STATE_UNINIT;
+
+// Events.
+static volatile uint8_t         Events;
+
+
+/* Public function implementations -------------------------------------------*/
+/***
+  * @Brief      Interrupt service routine for timer period elapsed event. Should 
+  *             be exported.
+  */
+void VoltammetryCore_TimerTickISR(void)
+{
+  static uint16_t dac_code;
+  uint64_t cic_value;
+  uint64_t cic_delayed;
+  
+  // Discard incompatible operations. Datapoints are passed through the queues, so the
+  // ticks aren't held while the delegates run.
+  if (State != VOLTAMMETRY_CORE_STATE_OPERATING)
+  {
+    return;
+  }
+  
+  Board_DACSignalSetnCS();
+  
+  // Get last conversion result.
+  ConversionValue = Board_ADCGetValue();
+  
+  // Trigger next conversion.
+  Board_ADCTriggerConvert();
+  
+  Board_DACSignalResetnCS();
+  
+  if (WindowTicks == 0)
+  {
+    // Integrators of the cic decimator run at the tick rate.
+    CICIntegrators[0] += (uint64_t)(int64_t)ConversionValue;
+    
+    for (uint8_t i = 1; i < DECIMATION_FILTER_CIC_ORDER; i++)
+    {
+      CICIntegrators[i] += CICIntegrators[i - 1];
+    }
+  }
+  else if ((uint32_t)(NextSamplingTick - TickCounter) < WindowTicks)
+  {
+    // Conversion is in the window, which ends at the sampling point.
+    WindowSum += ConversionValue;
+  }
+
+  // Generate DAC code.
+  if (WaveformType == VOLTAMMETRY_CORE_WAVEFORM_CUSTOM)
+  {
+    dac_code = GeneratorFunctionInterface(TickCounter);
+  }
+  else
+  {
+    dac_code = generateWaveform();
+  }
+  
+  // Set Signal DAC value. Sequence may seem weird. But this is used for framing data.
+  Board_HUBSPISend(dac_code);
+  
+  if (WindowTicks == 0)
+  {
+    // Combs of the cic decimator run at its output rate.
+    if (--CICCountdown == 0)
+    {
+      CICCountdown = CICRatio;
+      cic_value = CICIntegrators[DECIMATION_FILTER_CIC_ORDER - 1];
+      
+      for (uint8_t i = 0; i < DECIMATION_FILTER_CIC_ORDER; i++)
+      {
+        cic_delayed = CICCombDelays[i];
+        CICCombDelays[i] = cic_value;
+        cic_value -= cic_delayed;
+      }
+      
+      CICOutput = (int64_t)cic_value;
+      
+      // Output is queued after the gap of the dropped ones, which is filled by it as
+      // far as the queue allows. Queue can't be filled up to its capacity.
+      DroppedCICOutputs++;
+      
+      for (uint32_t space = QueueGeneric_GetAvailableSpace(&CICQueue);
+           (space > 1) && (DroppedCICOutputs != 0); space--, DroppedCICOutputs--)
+      {
+        QueueGeneric_Enqueue(&CICQueue, (uint8_t *)&CICOutput);
+      }
+      
+      if (DroppedCICOutputs != 0)
+      {
+        IsOverrun = TRUE;
+      }
+      
+      Events |= DATA_SAMPLED_EVENT;                    // Set data sampled event.
+    }
+  }
+  else if (TickCounter >= NextSamplingTick)
+  {
+    // Window output is queued with its edge, so the pairs of the edges survive an
+    // overrun. Queue can't be filled up to its capacity.
+    WindowOutput.value = WindowSum * WindowScale;
+    WindowOutput.edgeIndex = EdgeIndex;
+    WindowSum = 0;
+    
+    if (QueueGeneric_GetAvailableSpace(&WindowQueue) > 1)
+    {
+      QueueGeneric_Enqueue(&WindowQueue, (uint8_t *)&WindowOutput);
+    }
+    else
+    {
+      IsOverrun = TRUE;
+    }
+    
+    // Advance to the next edge of the pattern.
+    if (++EdgeIndex >= Pattern.edgeCount)
+    {
+      EdgeIndex = 0;
+      PeriodStartTick += Pattern.periodTicks;
+    }
+    
+    NextSamplingTick = PeriodStartTick + Pattern.edgeTicks[EdgeIndex] + \
+      (SAMPLE_PIPELINE_DELAY - 1);
+    WindowTicks = Pattern.windowTicks[EdgeIndex];
+    WindowScale = WindowScales[EdgeIndex];
+    
+    Events |= DATA_SAMPLED_EVENT;                      // Set data sampled event.
+  }
+  
+  TickCounter++;
+}
+
+/***
+  * @Brief      Initializes the module. Should be called before any other function.
+  *             It's assumed that interrupt priority is always higher than the 
+  *             execute function's priority.
+  * @Param      pSetupParams-> Setup parameters for the module.
+  * @Param      pTickPeriod-> Pointer to return calculated tick period.
+  */
+void VoltammetryCore_Setup(VoltammetryCore_SetupParams_t *pSetupParams, 
+                           float *pTickPeriod)
+{
+  uint32_t tim_reload;
+  uint16_t tim_prescaler;
+  float tick_period;
+  VoltammetryCore_Waveform_t *p_waveform;
+  
+  /* Check state. */
+  if (State == VOLTAMMETRY_CORE_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException("Voltammetry core module setup function called when the module is \
+                                     operating.\n");
+  }
+  
+  /* Adjust parameters. */
+  adjustParameters(VOLTAMMETRY_CORE_TIMER_FREQUENCY, VOLTAMMETRY_CORE_TIMER_MAX_RELOAD, 
+                   VOLTAMMETRY_CORE_TIMER_MAX_PRESCALER, pSetupParams->samplingFrequency, 
+                   pSetupParams->maxRelSamplingFreqErr, &tim_reload, &tim_prescaler, 
+                   &DownsamplingNumber, &tick_period);
+
+  /* Set local parameters. */
+  NumberOfDatapoints = pSetupParams->datapointCount;
+  
+  /* Configure timer. */
+  TIM_PrescalerConfig(VOLTAMMETRY_CORE_TIMER, tim_prescaler, TIM_PSCReloadMode_Immediate);
+  TIM_SetAutoreload(VOLTAMMETRY_CORE_TIMER, tim_reload);
+  
+  /* Tick counter initialized from negative value. This is due to apply equilibrium
+    period naturally. */
+  TickCounterReset = -(int32_t)((pSetupParams->equilibriumPeriod / tick_period) + 0.5f);
+  
+  // Cic gain is the ratio to the power of its order.
+  CICRatio = DownsamplingNumber / DECIMATION_FILTER_FIR_DECIMATION;
+  CICScale = (float)(1.0 / pow((double)CICRatio, DECIMATION_FILTER_CIC_ORDER));
+  
+  // Uniform window is a pattern with an edge at each downsampling period. Window is
+  // rounded to the ticks, at least a tick is averaged.
+  if ((pSetupParams->samplingWindow < 0.0f) || (pSetupParams->samplingWindow > 1.0f))
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core sampling window should be between zero and one.\n");
+  }
+  
+  Pattern.edgeCount = 0;
+  
+  if (pSetupParams->samplingWindow > 0.0f)
+  {
+    Pattern.periodTicks = DownsamplingNumber;
+    Pattern.edgeCount = 1;
+    Pattern.edgeTicks[0] = DownsamplingNumber;
+    Pattern.windowTicks[0] = (uint32_t)((pSetupParams->samplingWindow * DownsamplingNumber) + 0.5f);
+    
+    if (Pattern.windowTicks[0] == 0)
+    {
+      Pattern.windowTicks[0] = 1;
+    }
+    
+    WindowScales[0] = 1.0f / Pattern.windowTicks[0];
+  }
+  
+  // Set delegates and interfaces.
+  NewDatapointDelegate = pSetupParams->newDatapointDelegate;
+  MeasurementCompletedDelegate = pSetupParams->measurementCompletedDelegate;
+  GeneratorFunctionInterface = pSetupParams->generatorFunctionInterface;
+  
+  // There should be a generator function!
+  if (!GeneratorFunctionInterface)
+  {
+    GeneratorFunctionInterface = defaultGeneratorFunctionImplementation;
+  }
+  
+  // Set built-in waveform. Phase increment is rounded to the nearest, frequency
+  // error is below tick frequency / 2^33.
+  p_waveform = &pSetupParams->waveform;
+  WaveformType = p_waveform->type;
+  
+  if (WaveformType != VOLTAMMETRY_CORE_WAVEFORM_CUSTOM)
+  {
+    if ((p_waveform->frequency * tick_period) >= 0.5f)
+    {
+      ExceptionHandler_ThrowException(\
+        "Voltammetry core waveform frequency is above the Nyquist limit.\n");
+    }
+    
+    PhaseIncrement = (uint32_t)((p_waveform->frequency * tick_period * PHASE_FULL_CYCLE) + 0.5);
+    WaveformOffset = p_waveform->offsetDACCode;
+    WaveformAmplitude = p_waveform->amplitudeDACCode;
+    
+    if (WaveformType == VOLTAMMETRY_CORE_WAVEFORM_STAIRCASE)
+    {
+      if (p_waveform->stepsPerPeriod == 0)
+      {
+        ExceptionHandler_ThrowException(\
+          "Voltammetry core staircase waveform should have at least one step.\n");
+      }
+      
+      StepPhase = (uint32_t)((PHASE_FULL_CYCLE / p_waveform->stepsPerPeriod) + 0.5);
+    }
+  }
+  
+  *pTickPeriod = tick_period;
+  
+  // Set state to ready.
+  State = VOLTAMMETRY_CORE_STATE_READY;
+}
+
+/***
+  * @Brief      Sets windowed sampling pattern. Should be called after the setup, since
+  *             the ticks are known then.
+  * @Param      pPattern-> Sampling pattern in ticks.
+  */
+void VoltammetryCore_SetSamplingPattern(VoltammetryCore_SamplingPattern_t *pPattern)
+{
+  uint32_t previous_edge;
+  
+  if (State != VOLTAMMETRY_CORE_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core sampling pattern set when the module isn't ready.\n");
+  }
+  
+  if ((pPattern->edgeCount == 0) || (pPattern->edgeCount > VOLTAMMETRY_CORE_MAX_SAMPLING_EDGES) || \
+      (pPattern->periodTicks == 0))
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core sampling pattern should have edges in a period.\n");
+  }
+  
+  // Window of an edge starts after the previous edge. First one is wrapped to the
+  // last edge of the previous period.
+  previous_edge = pPattern->edgeTicks[pPattern->edgeCount - 1] - pPattern->periodTicks;
+  
+  for (uint8_t i = 0; i < pPattern->edgeCount; i++)
+  {
+    if ((pPattern->edgeTicks[i] > pPattern->periodTicks) || (pPattern->windowTicks[i] == 0) || \
+        ((int32_t)(pPattern->edgeTicks[i] - previous_edge) < (int32_t)pPattern->windowTicks[i]))
+    {
+      ExceptionHandler_ThrowException(\
+        "Voltammetry core sampling pattern edges or windows are invalid.\n");
+    }
+    
+    previous_edge = pPattern->edgeTicks[i];
+    WindowScales[i] = 1.0f / pPattern->windowTicks[i];
+  }
+  
+  Pattern = *pPattern;
+}
+
+void VoltammetryCore_Start(void)
+{
+  uint32_t equilibrium_outputs;
+  
+  // If not ready; throw exception.
+  if (State != VOLTAMMETRY_CORE_STATE_READY)
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core Start function called when the module isn't ready.\n");
+  }
+  
+  // Reset modified variables.
+  for (uint8_t i = 0; i < DECIMATION_FILTER_CIC_ORDER; i++)
+  {
+    CICIntegrators[i] = 0;
+    CICCombDelays[i] = 0;
+  }
+  
+  QueueGeneric_InitBuffer(&CICQueue, (uint8_t *)CICQueueContainer,
+                          sizeof(CICQueueContainer[0]), CIC_QUEUE_LENGTH);
+  QueueGeneric_InitBuffer(&WindowQueue, (uint8_t *)WindowQueueContainer,
+                          sizeof(WindowQueueContainer[0]), WINDOW_QUEUE_LENGTH);
+  DroppedCICOutputs = 0;
+  IsOverrun = FALSE;
+  
+  if (arm_fir_decimate_init_f32(&FIRInstance, DECIMATION_FILTER_FIR_TAP_COUNT,
+                                DECIMATION_FILTER_FIR_DECIMATION,
+                                (float32_t *)DecimationFilter_FIRCoefficients, FIRState,
+                                DECIMATION_FILTER_FIR_DECIMATION) != ARM_MATH_SUCCESS)
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core fir decimator couldn't be initialized.\n");
+  }
+  
+  // Cic outputs are at the multiples of the ratio, from the first tick. Fir output is
+  // aligned to the first output of its block, so the outputs before a multiple of the
+  // downsampling number are skipped. Then the fir outputs are at the datapoint ticks.
+  equilibrium_outputs = (uint32_t)(-TickCounterReset) / CICRatio;
+  
+  CICCountdown = ((uint32_t)(-TickCounterReset) % CICRatio) + 1;
+  SkippedCICOutputs = equilibrium_outputs % DECIMATION_FILTER_FIR_DECIMATION;
+  BlockTick = -(int32_t)((equilibrium_outputs - SkippedCICOutputs) * CICRatio);
+  
+  WindowSum = 0;
+  WindowTicks = 0;
+    
+  TickCounter = TickCounterReset;
+  NextSamplingTick = DownsamplingNumber;
+  
+  // Windowed sampling point is delayed by the pipeline, so the window covers the
+  // conversions of the last codes before the edge.
+  if (Pattern.edgeCount != 0)
+  {
+    EdgeIndex = 0;
+    PeriodStartTick = 0;
+    NextSamplingTick = Pattern.edgeTicks[0] + (SAMPLE_PIPELINE_DELAY - 1);
+    WindowTicks = Pattern.windowTicks[0];
+    WindowScale = WindowScales[0];
+  }
+  DatapointCounter = 0U;
+  Phase = 0U;
+      
+  // Set initial potential.
+  Board_DACSignalResetnCS();
+  
+  if (WaveformType == VOLTAMMETRY_CORE_WAVEFORM_CUSTOM)
+  {
+    Board_HUBSPISend(GeneratorFunctionInterface(0));
+  }
+  else
+  {
+    Board_HUBSPISend(WaveformOffset);
+  }
+
+  // Trigger first conversion.
+  Board_ADCTriggerConvert();
+    
+  // Enable timer.
+  TIM_Cmd(VOLTAMMETRY_CORE_TIMER, ENABLE);
+  
+  // Reset events.
+  Events = 0;
+  
+  State = VOLTAMMETRY_CORE_STATE_OPERATING;
+}
+
+/***
+  * @Brief      Module task executer and event processor.
+  */
+void VoltammetryCore_Execute(void)
+{
+  // If the module isn't initialized. 
+  if (State != VOLTAMMETRY_CORE_STATE_OPERATING)
+  {
+    return;
+  }
+  
+  // If a data is sampled. Event is cleared before the queues are processed, so an
+  // event set meanwhile is processed in the next call.
+  if (Events & DATA_SAMPLED_EVENT)
+  {
+    Events &= ~DATA_SAMPLED_EVENT;
+    
+    if (Pattern.edgeCount != 0)
+    {
+      processWindowQueue();
+    }
+    else
+    {
+      processCICQueue();
+    }
+  }
+}
+
+/***
+  * @Brief      Stops the module.
+  */
+void VoltammetryCore_Stop(void)
+{
+  // If not operating; throw exception.
+  if (State != VOLTAMMETRY_CORE_STATE_OPERATING)
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core Stop function called when the module isn't operating.\n");
+  }
+  
+  TIM_Cmd(VOLTAMMETRY_CORE_TIMER, DISABLE);
+      
+  // Set Signal DAC value. 
+  Board_DACSignalResetnCS();
+  Board_HUBSPISend(VGND_DAC_CODE);
+      
+  // Wait until the HUB SPI finishes it's process.
+  while (Board_HUBSPIIsBusy());
+  Board_DACSignalSetnCS();
+      
+  // State to pending ready.
+  State = VOLTAMMETRY_CORE_STATE_READY;
+}
+
+/***
+  * @Brief      Returns state of the voltammetry core module.
+  */
+VoltammetryCore_State_t VoltammetryCore_GetState(void)
+{
+  return State;
+}
+
+/***
+  * @Brief      Returns number of ticks between the datapoints. Valid after setup.
+  */
+uint32_t VoltammetryCore_GetDownsamplingNumber(void)
+{
+  return DownsamplingNumber;
+}
+
+/***
+  * @Brief      Returns group delay of the downsampling filter in ticks. Cic delays
+  *             by order * (ratio - 1) / 2 ticks, fir by (taps - 1) / 2 cic outputs,
+  *             and the pipeline delays both. Window is delayed by its half, since
+  *             its sampling point compensates the pipeline.
+  */
+float VoltammetryCore_GetFilterDelay(void)
+{
+  if (Pattern.edgeCount != 0)
+  {
+    return (0.5f * (Pattern.windowTicks[0] + 1));
+  }
+  
+  return (SAMPLE_PIPELINE_DELAY + \
+          0.5f * ((DECIMATION_FILTER_CIC_ORDER * (CICRatio - 1.0f)) + \
+                  ((DECIMATION_FILTER_FIR_TAP_COUNT - 1) * (float)CICRatio)));
+}
+
+/***
+  * @Brief      Returns whether the cic outputs were dropped since the start, since the
+  *             executer fell behind the tick ISR.
+  */
+Bool_t VoltammetryCore_IsOverrun(void)
+{
+  return IsOverrun;
+}
+
+/***
+  * @Brief      Places the bias at the middle of the potential range, and determines
+  *             the finest signal scaling which covers the range around it. Span is
+  *             doubled, since the rounded bias may not be at the exact middle.
+  *
+  * @Param      minPotential->Minimum potential applied by the technique.
+  * @Param      maxPotential->Maximum potential applied by the technique.
+  * @Param      pConfig->Pointer to return the configuration.
+  *
+  * @Return     TRUE if the DACs cover the range, FALSE otherwise.
+  */
+Bool_t VoltammetryCore_DetermineSignalScaling(float minPotential, float maxPotential,
+                                              VoltammetryCore_AnalogConfig_t *pConfig)
+{
+  int32_t bias_offset;
+  double bias_dac_1lsb_voltage;
+  double span_potential;
+  double dac1lsb_potential;
+
+  const Board_BinarySignalScaling_t BinaryScalingTable[] = \
+  {BOARD_BINARY_SIGNAL_SCALING_1_4, BOARD_BINARY_SIGNAL_SCALING_2_4,
+   BOARD_BINARY_SIGNAL_SCALING_3_4, BOARD_BINARY_SIGNAL_SCALING_4_4};
+
+  const Board_DecimalSignalScaling_t DecimalScalingTable[] = \
+  {BOARD_DECIMAL_SIGNAL_SCALING_1_100, BOARD_DECIMAL_SIGNAL_SCALING_1_10,
+   BOARD_DECIMAL_SIGNAL_SCALING_1_1};
+
+  bias_dac_1lsb_voltage = Board_GetBiasDAC1LSBAppliedPotential();
+  bias_offset = (int32_t)floor((0.5 * (minPotential + maxPotential) / \
+                                bias_dac_1lsb_voltage) + 0.5);
+
+  if ((bias_offset < -VGND_DAC_CODE) || (bias_offset > (MAX_UINT16 - VGND_DAC_CODE)))
+  {
+    return FALSE;
+  }
+
+  pConfig->biasDACCode = (uint16_t)(VGND_DAC_CODE + bias_offset);
+  pConfig->biasPotential = bias_offset * bias_dac_1lsb_voltage;
+
+  span_potential = 2.0 * fmax(maxPotential - pConfig->biasPotential,
+                              pConfig->biasPotential - minPotential);
+
+  for (uint8_t i = 0; i < sizeof(DecimalScalingTable) / sizeof(DecimalScalingTable[0]); i++)
+  {
+    for (uint8_t j = 0; j < sizeof(BinaryScalingTable) / sizeof(BinaryScalingTable[0]); j++)
+    {
+      dac1lsb_potential = Board_GetSignalDAC1LSBAppliedPotential(BinaryScalingTable[j],
+                                                                 DecimalScalingTable[i]);
+
+      if ((((double)MAX_UINT16) / SIGNAL_RANGE_SAFETY_FACTOR) >= \
+        fabs(span_potential / dac1lsb_potential))
+      {
+        pConfig->decimalScaling = DecimalScalingTable[i];
+        pConfig->binaryScaling = BinaryScalingTable[j];
+        pConfig->signalDAC1LSBPotential = dac1lsb_potential;
+
+        return TRUE;
+      }
+    }
+  }
+
+  return FALSE;
+}
+
+/***
+  * @Brief      Converts potential to the signal DAC code in Q16.16 format, relative
+  *             to the bias potential.
+  *
+  * @Param      pConfig->Analog configuration of the technique.
+  * @Param      potential->Potential in units of volts.
+  */
+uint32_t VoltammetryCore_GetCode(VoltammetryCore_AnalogConfig_t *pConfig, float potential)
+{
+  double code;
+
+  code = (VGND_DAC_CODE + ((potential - pConfig->biasPotential) / \
+                           pConfig->signalDAC1LSBPotential)) * VOLTAMMETRY_CORE_CODE_ONE;
+
+  if (code < 0.0)
+  {
+    code = 0.0;
+  }
+  else if (code > (MAX_UINT16 * VOLTAMMETRY_CORE_CODE_ONE))
+  {
+    code = MAX_UINT16 * VOLTAMMETRY_CORE_CODE_ONE;
+  }
+
+  return ((uint32_t)(code + 0.5));
+}
+
+/***
+  * @Brief      Returns potential applied by the signal DAC code.
+  *
+  * @Param      pConfig->Analog configuration of the technique.
+  * @Param      dacCode->Signal DAC code.
+  */
+float VoltammetryCore_GetPotential(VoltammetryCore_AnalogConfig_t *pConfig, uint16_t dacCode)
+{
+  return ((float)(pConfig->biasPotential + \
+    ((int32_t)dacCode - VGND_DAC_CODE) * pConfig->signalDAC1LSBPotential));
+}
+
+/***
+  * @Brief      Turns on the analog circuitry in the voltammetry configuration.
+  *
+  * @Param      pConfig->Analog configuration of the technique.
+  * @Param      signalDACCode->Initial signal DAC code.
+  */
+void VoltammetryCore_TurnOnAnalog(VoltammetryCore_AnalogConfig_t *pConfig,
+                                  uint16_t signalDACCode)
+{
+  // Turn on analog circuitry.
+  Board_TurnOnAnalog();
+
+  // Set scaling which covers the scan.
+  Board_SetBinarySignalScaling(pConfig->binaryScaling);
+  Board_SetDecimalSignalScaling(pConfig->decimalScaling);
+
+  // Set configuration to voltammetry.
+  Board_ConfigureCore(BOARD_CORE_CONFIGURATION_VOLTAMMETRY);
+
+  // Ensure that all HUB peripherals are deselected. And load pins are deactivated.
+  Board_TIASetnCS();
+  Board_TIASetnLATCH();
+
+  Board_DACBiasSetnCS();
+  Board_DACBiasSetnLDAC();
+
+  Board_DACSignalSetnCS();
+  Board_DACSignalSetnLDAC();
+
+  // Select feedback path.
+  Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_TIA);
+  Board_HUBSPIEnable();
+
+  Board_TIAResetnCS();
+  Board_TIASelectFBPath(pConfig->fbPath);
+  Board_TIASetnCS();
+
+  Board_TIAResetnLATCH();
+  Board_TIASetnLATCH();
+
+  // Set Bias DAC code.
+  Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_BIAS);
+  Board_HUBSPIEnable();
+
+  Board_DACBiasResetnCS();
+  Board_HUBSPISend(pConfig->biasDACCode);
+  while (Board_HUBSPIIsBusy());
+  Board_DACBiasSetnCS();
+  Board_DACBiasResetnLDAC();
+  Board_DACBiasSetnLDAC();
+
+  // Set Signal DAC code.
+  Board_HUBSPIConfigure(BOARD_HUB_CHANNEL_ID_DAC_SIGNAL);
+  Board_HUBSPIEnable();
+  Board_DACSignalResetnCS();
+  Board_HUBSPISend(signalDACCode);
+  while (Board_HUBSPIIsBusy());
+  Board_DACSignalResetnLDAC();
+  Board_DACSignalSetnLDAC();
+
+  // Wait bias dac to stabilize.
+  Utils_DelayMs(Board_GetDACBiasStabilizationPeriod());
+
+  // Enable ADC SPI.
+  Board_ADCSPIEnable();
+}
+
+/***
+  * @Brief      Turns off the analog circuitry, and disables the SPIs.
+  */
+void VoltammetryCore_TurnOffAnalog(void)
+{
+  // Set configuration to off.
+  Board_ConfigureCore(BOARD_CORE_CONFIGURATION_OFF);
+
+  // Turn off analog circuitry.
+  Board_TurnOffAnalog();
+
+  Board_HUBSPIDisable();
+  Board_ADCSPIDisable();
+}
+
+/***
+  * @Brief      Checks whether the DACs cover the staircase with the pulses.
+  *
+  * @Param      startPotential->Start potential of the staircase.
+  * @Param      endPotential->End potential of the staircase.
+  * @Param      amplitude->Pulse height.
+  * @Param      pulses->Direction of the pulses.
+  *
+  * @Return     TRUE if the staircase is covered, FALSE otherwise.
+  */
+Bool_t VoltammetryCore_IsStaircaseValid(float startPotential, float endPotential,
+                                        float amplitude, VoltammetryCore_PulseDirection_t pulses)
+{
+  float min_potential;
+  float max_potential;
+  VoltammetryCore_AnalogConfig_t config;
+
+  getStaircaseRange(startPotential, endPotential, amplitude, pulses, &min_potential,
+                    &max_potential);
+
+  return VoltammetryCore_DetermineSignalScaling(min_potential, max_potential, &config);
+}
+
+/***
+  * @Brief      Plans the staircase, and the analog configuration which covers it.
+  *             Bias DAC holds the middle of the scan, signal DAC generates the steps
+  *             and the pulses around it. Two datapoints are taken in a step.
+  *
+  * @Param      pStaircase->Pointer to return the staircase.
+  * @Param      startPotential->Start potential of the staircase.
+  * @Param      endPotential->End potential of the staircase.
+  * @Param      stepPotential->Staircase step, positive.
+  * @Param      amplitude->Pulse height.
+  * @Param      pulses->Direction of the pulses.
+  */
+void VoltammetryCore_PlanStaircase(VoltammetryCore_Staircase_t *pStaircase,
+                                   float startPotential, float endPotential,
+                                   float stepPotential, float amplitude,
+                                   VoltammetryCore_PulseDirection_t pulses)
+{
+  double step_count;
+  double direction;
+  float min_potential;
+  float max_potential;
+
+  if (!(stepPotential > 0.0f))
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core staircase step should be positive.\n");
+  }
+
+  step_count = floor((fabs(endPotential - startPotential) / stepPotential) + 0.5) + 1.0;
+
+  if ((2.0 * step_count) > MAX_UINT16)
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core staircase step count is out of range.\n");
+  }
+
+  getStaircaseRange(startPotential, endPotential, amplitude, pulses, &min_potential,
+                    &max_potential);
+
+  if (!VoltammetryCore_DetermineSignalScaling(min_potential, max_potential,
+                                              &pStaircase->analogConfig))
+  {
+    ExceptionHandler_ThrowException(\
+      "Voltammetry core staircase is out of the signal DAC range.\n");
+  }
+
+  direction = (endPotential >= startPotential) ? 1.0 : -1.0;
+
+  pStaircase->stepCount = (uint32_t)step_count;
+  pStaircase->stepIndex = 0;
+  pStaircase->startCode = VoltammetryCore_GetCode(&pStaircase->analogConfig, startPotential);
+  pStaircase->stepIncrement = (pStaircase->stepCount < 2) ? 0 : \
+    (int32_t)floor((((double)VoltammetryCore_GetCode(&pStaircase->analogConfig, endPotential) - \
+                     (double)pStaircase->startCode) / (pStaircase->stepCount - 1)) + 0.5);
+  pStaircase->pulseIncrement = (int32_t)floor((direction * amplitude / \
+                                               pStaircase->analogConfig.signalDAC1LSBPotential * \
+                                               VOLTAMMETRY_CORE_CODE_ONE) + 0.5);
+}
+
+/***
+  * @Brief      Pairs the currents of a step. Current of the first edge is held, the
+  *             pair is returned on the second edge, and the step is advanced.
+  *
+  * @Param      pStaircase->Staircase of the technique.
+  * @Param      current->Current of the edge.
+  * @Param      edgeIndex->Edge of the sampling pattern.
+  * @Param      pPotential->Pointer to return the staircase potential of the step.
+  * @Param      pFirstCurrent->Pointer to return the current of the first edge.
+  *
+  * @Return     TRUE if the pair is completed, FALSE otherwise.
+  */
+Bool_t VoltammetryCore_PairStaircaseCurrents(VoltammetryCore_Staircase_t *pStaircase,
+                                             float current, uint8_t edgeIndex,
+                                             float *pPotential, float *pFirstCurrent)
+{
+  if (edgeIndex == 0)
+  {
+    pStaircase->firstCurrent = current;
+    return FALSE;
+  }
+
+  *pPotential = VoltammetryCore_GetPotential(&pStaircase->analogConfig,
+    VoltammetryCore_RoundCode(VoltammetryCore_GetStepCode(pStaircase, pStaircase->stepIndex++)));
+  *pFirstCurrent = pStaircase->firstCurrent;
+
+  return TRUE;
+}
+
+/* Private function implementations-------------------------------------------*/
+static uint16_t defaultGeneratorFunctionImplementation(int32_t tickValue)
+{
+  return VGND_DAC_CODE;
+}
+
+/***
+  * @Brief      Filters the completed blocks of the cic outputs by the fir decimator.
+  *             Datapoints of the equilibrium period are dropped.
+  */
+static void processCICQueue(void)
+{
+  float32_t block[DECIMATION_FILTER_FIR_DECIMATION];
+  float32_t datapoint;
+  int64_t cic_output;
+  
+  while ((State == VOLTAMMETRY_CORE_STATE_OPERATING) && \
+         ((CIC_QUEUE_LENGTH - QueueGeneric_GetAvailableSpace(&CICQueue)) >= \
+          (SkippedCICOutputs + DECIMATION_FILTER_FIR_DECIMATION)))
+  {
+    for (; SkippedCICOutputs != 0; SkippedCICOutputs--)
+    {
+      QueueGeneric_Dequeue(&CICQueue, (uint8_t *)&cic_output);
+    }
+    
+    for (uint8_t i = 0; i < DECIMATION_FILTER_FIR_DECIMATION; i++)
+    {
+      QueueGeneric_Dequeue(&CICQueue, (uint8_t *)&cic_output);
+      block[i] = (float32_t)cic_output * CICScale;
+    }
+    
+    arm_fir_decimate_f32(&FIRInstance, block, &datapoint, DECIMATION_FILTER_FIR_DECIMATION);
+    
+    if (BlockTick >= (int32_t)DownsamplingNumber)
+    {
+      processDatapoint(datapoint, 0);
+    }
+    
+    BlockTick += DownsamplingNumber;
+  }
+}
+
+/***
+  * @Brief      Passes the queued window outputs to the delegate.
+  */
+static void processWindowQueue(void)
+{
+  WindowOutput_t output;
+  
+  while ((State == VOLTAMMETRY_CORE_STATE_OPERATING) && \
+         (QueueGeneric_IsEmpty(&WindowQueue) == FALSE))
+  {
+    QueueGeneric_Dequeue(&WindowQueue, (uint8_t *)&output);
+    processDatapoint(output.value, output.edgeIndex);
+  }
+}
+
+/***
+  * @Brief      Passes the datapoint to the delegate, and completes the measurement
+  *             after the last one.
+  */
+static void processDatapoint(float datapoint, uint8_t edgeIndex)
+{
+  NewDatapointDelegate(datapoint, edgeIndex);
+  
+  if (++DatapointCounter >= NumberOfDatapoints)
+  {
+    TIM_Cmd(VOLTAMMETRY_CORE_TIMER, DISABLE);
+    
+    // State is set first, so a pending tick doesn't touch the HUB SPI.
+    State = VOLTAMMETRY_CORE_STATE_READY;
+  
+    // Set Signal DAC value.
+    Board_DACSignalResetnCS();
+    Board_HUBSPISend(VGND_DAC_CODE);
+    
+    // Wait until the HUB SPI finished it's process.
+    while (Board_HUBSPIIsBusy());
+    Board_DACSignalSetnCS();
+    
+    // If measurement completed delegate is set; call it.
+    if (MeasurementCompletedDelegate)
+    {
+      MeasurementCompletedDelegate();
+    }
+  }
+}
+
+/***
+  * @Brief      Returns the potential range of the staircase. Bipolar pulses go both
+  *             ways of it, forward pulses extend the range at the end side only.
+  */
+static void getStaircaseRange(float startPotential, float endPotential, float amplitude,
+                              VoltammetryCore_PulseDirection_t pulses, float *pMinPotential,
+                              float *pMaxPotential)
+{
+  *pMinPotential = (float)fmin(startPotential, endPotential);
+  *pMaxPotential = (float)fmax(startPotential, endPotential);
+
+  if ((pulses == VOLTAMMETRY_CORE_PULSES_BIPOLAR) || (endPotential < startPotential))
+  {
+    *pMinPotential -= amplitude;
+  }
+
+  if ((pulses == VOLTAMMETRY_CORE_PULSES_BIPOLAR) || (endPotential >= startPotential))
+  {
+    *pMaxPotential += amplitude;
+  }
+}
+
+/***
+  * @Brief      Generates DAC code of the built-in waveform, and advances the phase.
+  *             Phase is held at zero during the equilibrium period.
+  */
+static uint16_t generateWaveform(void)
+{
+  int32_t value;
+  
+  switch (WaveformType)
+  {
+  case VOLTAMMETRY_CORE_WAVEFORM_SINE:
+    value = WaveformTable_GetSine(Phase);
+    break;
+    
+  case VOLTAMMETRY_CORE_WAVEFORM_TRIANGLE:
+    value = WaveformTable_GetTriangle(Phase);
+    break;
+    
+  case VOLTAMMETRY_CORE_WAVEFORM_STAIRCASE:
+    value = WaveformTable_GetStaircase(Phase, StepPhase);
+    break;
+    
+  default:
+    value = 0;
+    break;
+  }
+  
+  if (TickCounter >= 0)
+  {
+    Phase += PhaseIncrement;
+  }
+  
+  value = WaveformOffset + ((value * WaveformAmplitude) / WAVEFORM_TABLE_AMPLITUDE);
+  
+  // Saturate to the DAC range.
+  if (value < 0)
+  {
+    value = 0;
+  }
+  else if (value > MAX_UINT16)
+  {
+    value = MAX_UINT16;
+  }
+  
+  return ((uint16_t)value);
+}
+                                    
+/***
+  * @Brief      Adjusts timer parameters according to required sampling frequency 
+  *             and tolerances.
+  * @Param      timClockFrequency-> Clock frequency of the timer.                     
+  * @Param      timMaxReload-> Maximum reload value of the timer.
+  * @Param      timMaxPrescaler-> Maximum prescaler value of the timer.
+  * @Param      requiredSamplingFreq-> Required sampling frequency value.
+  * @Param      maxRelSamplingFreqErr-> There may be some error when adjusting timer.
+  *             There is a limit for this value. This parameter dictates the maximum
+  *             relative sampling frequency error.
+  * @Param      pTimReload-> Pointer for the calculated reload value.
+  * @Param      pTimPrescaler-> Pointer for the calculated prescaler value.
+  * @Param      pDownsamplingNumber-> Downsampling number indicates the downsampling
+  *             ratio. Conversion value isn't recorded every timer ISR. It has been
+  *             passed from a low pass filter, then downsampled and stored. Downsampling
+  *             number is a multiple of the fir decimation, and is limited by the cic
+  *             register growth. So the tick frequency is lowered for the low sampling
+  *             frequencies.
+  * @Param      pTickPeriod->Pointer for calculated tick period.
+  */
+static void adjustParameters(uint32_t timClockFrequency, uint32_t timMaxReload, 
+                             uint16_t timMaxPrescaler, float requiredSamplingFreq, 
+                             float maxRelSamplingFreqErr, uint32_t *pTimReload,
+                             uint16_t *pTimPrescaler, uint32_t *pDownsamplingNumber, 
+                             float *pTickPeriod)
+{
+  uint32_t downsampling_number;
+  uint32_t tim_min_reload;
+  uint32_t tim_min_ratio_reload;
+  float sampling_frequency;    
+  float relative_sampling_frequency_error;
+  
+  // Chose tick frequency as high as possible. 
+  // Maximum sampling frequency error should be lower than maximum relative frequency error.
+  for (uint16_t tim_prescaler = 0; tim_prescaler <= timMaxPrescaler; tim_prescaler++)
+  {
+    tim_min_reload = (timClockFrequency / (tim_prescaler + 1)) / MAX_TICK_FREQUENCY;
+    tim_min_ratio_reload = (uint32_t)(timClockFrequency / ((tim_prescaler + 1) * \
+                                      requiredSamplingFreq * MAX_DOWNSAMPLING_NUMBER));
+    
+    if (tim_min_reload < tim_min_ratio_reload)
+    {
+      tim_min_reload = tim_min_ratio_reload;
+    }
+    
+    // Search for reload values.
+    for (uint32_t tim_reload = tim_min_reload;  tim_reload < timMaxReload; tim_reload++)
+    {
+      // Calculate required downsampling number.
+      downsampling_number = DECIMATION_FILTER_FIR_DECIMATION * \
+        (uint32_t)((timClockFrequency / ((tim_prescaler + 1) * tim_reload * requiredSamplingFreq * \
+                                         DECIMATION_FILTER_FIR_DECIMATION)) + 0.5f);
+      
+      if (downsampling_number == 0)
+      {
+        downsampling_number = DECIMATION_FILTER_FIR_DECIMATION;
+      }
+      else if (downsampling_number > MAX_DOWNSAMPLING_NUMBER)
+      {
+        continue;
+      }
+      
+      // Back calculate the sampling frequency.
+      sampling_frequency = timClockFrequency / ((float)(tim_prescaler + 1) * tim_reload \
+                                                * downsampling_number);
+      
+      // Calculate relative sampling frequency error.
+      relative_sampling_frequency_error = fabs(sampling_frequency - requiredSamplingFreq) \
+                                          / requiredSamplingFreq;
+      
+      // Test if it satisfies the error condition.
+      if (relative_sampling_frequency_error <= maxRelSamplingFreqErr)
+      {
+        *pTimReload = tim_reload;
+        *pTimPrescaler = tim_prescaler;
+        *pDownsamplingNumber = downsampling_number;
+        *pTickPeriod = ((float)(tim_reload * (tim_prescaler + 1))) / timClockFrequency;
+        
+        return;
+      }
+    }
+  }
 }
\ No newline at end of file
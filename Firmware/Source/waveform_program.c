@@ -0,0 +1,417 @@
+/**
+  * @author     Onur Efe
+  */
+
+#include "waveform_program.h"
+#include "math.h"
+#include "board.h"
+#include "middlewares.h"
+
+/* Private constants ---------------------------------------------------------*/
+// Virtual ground DAC code.
+#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
+
+// Levels are in Q16.16 format, relative to the virtual ground.
+#define CODE_FRACTION_BITS                      16
+#define CODE_ONE                                ((double)(1UL << CODE_FRACTION_BITS))
+#define CODE_HALF                               (1L << (CODE_FRACTION_BITS - 1))
+
+#define MAX_LEVEL                               ((double)(VGND_DAC_CODE - 1) * CODE_ONE)
+#define MAX_JUMP                                ((double)MAX_UINT16 * CODE_ONE)
+#define MAX_INCREMENT                           ((double)0x7FFFFFFF)
+
+// Hold potential is in the signal range, relative potentials are within its span.
+#define MAX_POTENTIAL_CHANGE                    (BOARD_MAX_SIGNAL_POTENTIAL - \
+                                                 BOARD_MIN_SIGNAL_POTENTIAL)
+
+// Pulse train takes three segments, end is appended.
+#define MAX_SEGMENTS                            (3 * WAVEFORM_PROGRAM_MAX_INSTRUCTIONS + 1)
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef enum
+{
+  SEGMENT_TYPE_SET                      = 0x00, // Sets the level, then ramps.
+  SEGMENT_TYPE_JUMP                     = 0x01, // Jumps the level, then ramps.
+  SEGMENT_TYPE_LOOP                     = 0x02, // Takes no ticks.
+  SEGMENT_TYPE_END                      = 0x03
+} SegmentType_t;
+
+typedef struct
+{
+  SegmentType_t                         type;
+  int64_t                               value;          // Level or jump.
+  int64_t                               ramp;           // Exact change in the segment.
+  int32_t                               increment;      // Per tick, rounded.
+  uint32_t                              ticks;          // Count for the loop.
+  uint8_t                               target;         // Loop only.
+} Segment_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static void enterNextSegment(void);
+static uint8_t addSegment(SegmentType_t type, double value, double ramp, uint32_t ticks,
+                          uint8_t target);
+static uint32_t getTicks(float duration);
+static double clamp(double value, double limit);
+
+/* Private variables ---------------------------------------------------------*/
+// Compiled program.
+static Segment_t                        Segments[MAX_SEGMENTS];
+static uint8_t                          SegmentCount;
+static float                            TickPeriod;
+
+// Segment state.
+static uint8_t                          SegmentIndex;
+static uint16_t                         LoopCounters[MAX_SEGMENTS];
+static int64_t                          Level;
+static int64_t                          EndLevel;       // Of the segment.
+static int32_t                          Increment;
+static uint32_t                         TicksLeft;
+static int32_t                          StateTick;
+
+/* Exported functions --------------------------------------------------------*/
+/***
+  * @Brief      Checks the structure of the program; opcodes, durations, counts and
+  *             loop targets.
+  *
+  * @Param      pProgram->Pointer to the instructions.
+  * @Param      instructionCount->Number of the instructions.
+  *
+  * @Return     TRUE if the program can be loaded, FALSE otherwise.
+  */
+Bool_t WaveformProgram_IsValid(const WaveformProgram_Instruction_t *pProgram,
+                               uint8_t instructionCount)
+{
+  const WaveformProgram_Instruction_t *p_instruction;
+  Bool_t is_timed;
+
+  if ((instructionCount == 0) || (instructionCount > WAVEFORM_PROGRAM_MAX_INSTRUCTIONS))
+  {
+    return FALSE;
+  }
+
+  for (uint8_t i = 0; i < instructionCount; i++)
+  {
+    p_instruction = &pProgram[i];
+
+    switch (p_instruction->opcode)
+    {
+    case WAVEFORM_PROGRAM_OPCODE_END:
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_HOLD:
+      // Negated, so NaN is rejected too.
+      if (!(p_instruction->duration > 0.0f) || \
+          !(p_instruction->potential >= BOARD_MIN_SIGNAL_POTENTIAL) || \
+          !(p_instruction->potential <= BOARD_MAX_SIGNAL_POTENTIAL))
+      {
+        return FALSE;
+      }
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_STEP:
+    case WAVEFORM_PROGRAM_OPCODE_RAMP:
+      if (!(p_instruction->duration > 0.0f) || \
+          !(fabsf(p_instruction->potential) <= MAX_POTENTIAL_CHANGE))
+      {
+        return FALSE;
+      }
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_PULSE_TRAIN:
+      if (!(p_instruction->duration > 0.0f) || !(p_instruction->baseDuration > 0.0f) || \
+          (p_instruction->count == 0) || !(fabsf(p_instruction->potential) <= MAX_POTENTIAL_CHANGE))
+      {
+        return FALSE;
+      }
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_LOOP:
+      if ((p_instruction->target >= i) || (p_instruction->count == 0))
+      {
+        return FALSE;
+      }
+
+      // Body should take ticks and shouldn't end, inner loops should be in the body.
+      is_timed = FALSE;
+
+      for (uint8_t j = p_instruction->target; j < i; j++)
+      {
+        switch (pProgram[j].opcode)
+        {
+        case WAVEFORM_PROGRAM_OPCODE_END:
+          return FALSE;
+
+        case WAVEFORM_PROGRAM_OPCODE_LOOP:
+          if (pProgram[j].target < p_instruction->target)
+          {
+            return FALSE;
+          }
+          break;
+
+        default:
+          is_timed = TRUE;
+          break;
+        }
+      }
+
+      if (!is_timed)
+      {
+        return FALSE;
+      }
+      break;
+
+    default:
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/***
+  * @Brief      Compiles the program into the segments in ticks and DAC codes, and
+  *             rewinds it. Durations are rounded to the ticks, at least a tick.
+  *
+  * @Param      pProgram->Pointer to the instructions.
+  * @Param      instructionCount->Number of the instructions.
+  * @Param      tickPeriod->Tick period of the generator in seconds.
+  * @Param      dac1LSBPotential->Potential of 1 LSB of the DAC code.
+  */
+void WaveformProgram_Load(const WaveformProgram_Instruction_t *pProgram,
+                          uint8_t instructionCount, float tickPeriod,
+                          double dac1LSBPotential)
+{
+  const WaveformProgram_Instruction_t *p_instruction;
+  uint8_t first_segments[WAVEFORM_PROGRAM_MAX_INSTRUCTIONS];
+  uint8_t train_segment;
+  uint32_t ticks;
+  double value;
+
+  if (!WaveformProgram_IsValid(pProgram, instructionCount))
+  {
+    ExceptionHandler_ThrowException(\
+      "Waveform program is invalid.\n");
+  }
+
+  TickPeriod = tickPeriod;
+  SegmentCount = 0;
+
+  for (uint8_t i = 0; i < instructionCount; i++)
+  {
+    p_instruction = &pProgram[i];
+    value = p_instruction->potential / dac1LSBPotential * CODE_ONE;
+    first_segments[i] = SegmentCount;
+
+    switch (p_instruction->opcode)
+    {
+    case WAVEFORM_PROGRAM_OPCODE_END:
+      addSegment(SEGMENT_TYPE_END, 0.0, 0.0, 0, 0);
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_HOLD:
+      addSegment(SEGMENT_TYPE_SET, clamp(value, MAX_LEVEL), 0.0,
+                 getTicks(p_instruction->duration), 0);
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_STEP:
+      addSegment(SEGMENT_TYPE_JUMP, clamp(value, MAX_JUMP), 0.0,
+                 getTicks(p_instruction->duration), 0);
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_RAMP:
+      ticks = getTicks(p_instruction->duration);
+      addSegment(SEGMENT_TYPE_JUMP, 0.0, clamp(value, MAX_JUMP), ticks, 0);
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_PULSE_TRAIN:
+      value = clamp(value, MAX_JUMP);
+      train_segment = addSegment(SEGMENT_TYPE_JUMP, value, 0.0,
+                                 getTicks(p_instruction->duration), 0);
+      addSegment(SEGMENT_TYPE_JUMP, -value, 0.0, getTicks(p_instruction->baseDuration), 0);
+      addSegment(SEGMENT_TYPE_LOOP, 0.0, 0.0, p_instruction->count, train_segment);
+      break;
+
+    case WAVEFORM_PROGRAM_OPCODE_LOOP:
+      addSegment(SEGMENT_TYPE_LOOP, 0.0, 0.0, p_instruction->count,
+                 first_segments[p_instruction->target]);
+      break;
+    }
+  }
+
+  // Level is held after the last instruction.
+  addSegment(SEGMENT_TYPE_END, 0.0, 0.0, 0, 0);
+
+  WaveformProgram_Rewind();
+}
+
+/***
+  * @Brief      Rewinds the loaded program to its start.
+  */
+void WaveformProgram_Rewind(void)
+{
+  for (uint8_t i = 0; i < SegmentCount; i++)
+  {
+    LoopCounters[i] = 0;
+  }
+
+  SegmentIndex = 0;
+  Level = 0;
+  StateTick = 0;
+
+  enterNextSegment();
+}
+
+/***
+  * @Brief      Generator function of the program. Should be called with the successive
+  *             ticks; level is held for the negative ones. Only the segment state is
+  *             advanced in a tick, so it's suitable for the tick ISR.
+  *
+  * @Param      tickCounter->Ticks since the start of the program.
+  *
+  * @Return     DAC code of the tick.
+  */
+uint16_t WaveformProgram_GetDACCode(int32_t tickCounter)
+{
+  int64_t code;
+
+  // Advance once per new tick. Same tick may be asked again, e.g. for the initial code.
+  if (tickCounter > StateTick)
+  {
+    StateTick = tickCounter;
+    Level += Increment;
+
+    if (--TicksLeft == 0)
+    {
+      // Rounded increment misses the end of a ramp; snap to it, so the error doesn't
+      // accumulate through the loops.
+      Level = EndLevel;
+      enterNextSegment();
+    }
+  }
+
+  // Round to the DAC code and saturate to the DAC range.
+  code = VGND_DAC_CODE + ((Level + CODE_HALF) >> CODE_FRACTION_BITS);
+
+  if (code < 0)
+  {
+    code = 0;
+  }
+  else if (code > MAX_UINT16)
+  {
+    code = MAX_UINT16;
+  }
+
+  return ((uint16_t)code);
+}
+
+/* Private functions ---------------------------------------------------------*/
+/***
+  * @Brief      Enters the next timed segment. Loops are resolved here, so it runs at
+  *             the segment boundaries only. Validation guarantees a timed segment in
+  *             every loop body, so it terminates.
+  */
+static void enterNextSegment(void)
+{
+  Segment_t *p_segment;
+
+  for (;;)
+  {
+    p_segment = &Segments[SegmentIndex];
+
+    switch (p_segment->type)
+    {
+    case SEGMENT_TYPE_LOOP:
+      if (++LoopCounters[SegmentIndex] < p_segment->ticks)
+      {
+        SegmentIndex = p_segment->target;
+      }
+      else
+      {
+        LoopCounters[SegmentIndex] = 0;
+        SegmentIndex++;
+      }
+      continue;
+
+    case SEGMENT_TYPE_END:
+      // Stay here; level is held forever.
+      Increment = 0;
+      EndLevel = Level;
+      TicksLeft = MAX_UINT32;
+      return;
+
+    case SEGMENT_TYPE_SET:
+      Level = p_segment->value;
+      break;
+
+    case SEGMENT_TYPE_JUMP:
+      Level += p_segment->value;
+      break;
+    }
+
+    Increment = p_segment->increment;
+    EndLevel = Level + p_segment->ramp;
+    TicksLeft = p_segment->ticks;
+    SegmentIndex++;
+
+    return;
+  }
+}
+
+/***
+  * @Brief      Appends a segment to the program. Ramp is spread over the ticks by the
+  *             rounded increment.
+  *
+  * @Return     Index of the segment.
+  */
+static uint8_t addSegment(SegmentType_t type, double value, double ramp, uint32_t ticks,
+                          uint8_t target)
+{
+  Segment_t *p_segment = &Segments[SegmentCount];
+
+  p_segment->type = type;
+  p_segment->value = (int64_t)value;
+  p_segment->ramp = (int64_t)ramp;
+  p_segment->increment = (ramp == 0.0) ? 0 : \
+    (int32_t)clamp(floor((ramp / ticks) + 0.5), MAX_INCREMENT);
+  p_segment->ticks = ticks;
+  p_segment->target = target;
+
+  return (SegmentCount++);
+}
+
+/***
+  * @Brief      Rounds the duration to the ticks, at least a tick.
+  */
+static uint32_t getTicks(float duration)
+{
+  double ticks = floor((duration / TickPeriod) + 0.5);
+
+  if (ticks < 1.0)
+  {
+    return 1;
+  }
+
+  if (ticks > MAX_UINT32)
+  {
+    return MAX_UINT32;
+  }
+
+  return ((uint32_t)ticks);
+}
+
+/***
+  * @Brief      Limits the value to the +-limit.
+  */
+static double clamp(double value, double limit)
+{
+  if (value > limit)
+  {
+    return limit;
+  }
+  else if (value < -limit)
+  {
+    return -limit;
+  }
+
+  return value;
+}
@@ -0,0 +1,171 @@
+"""
+  @author     Onur Efe
+
+  Generates Source/decimation_filter.c. Coefficients are of the FIR stage which
+  compensates the droop of the CIC stage, and rejects the band above the half of
+  the sampling frequency. Parameters should match the definitions in
+  Include/decimation_filter.h.
+
+  Frequency response of the chain is checked for CIC ratios in the range,
+  generation fails if it's out of the limits. It's the model of the chain; the
+  firmware sources are checked by voltammetry_core_host_test.py.
+
+  Usage: python decimation_filter_generator.py
+"""
+
+import math
+import os
+import sys
+
+CIC_ORDER = 3
+CIC_MAX_RATIO = 16384
+FIR_DECIMATION = 4
+FIR_TAP_COUNT = 32
+
+# Band edges are relative to the CIC output rate. Passband is the quarter, stopband
+# starts at the three quarters of the datapoint rate. Band between them is aliased
+# to the band above the passband.
+PASSBAND_EDGE = 0.25 / FIR_DECIMATION
+STOPBAND_EDGE = 0.75 / FIR_DECIMATION
+STOPBAND_WEIGHT = 100.0
+GRID_SIZE = 4000
+
+MAX_PASSBAND_RIPPLE = 0.2     # dB
+MIN_STOPBAND_ATTENUATION = 45.0     # dB
+CHECKED_RATIOS = [1, 2, 4, 16, 256, CIC_MAX_RATIO]
+
+VALUES_PER_LINE = 4
+
+OUTPUT_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "Source", "decimation_filter.c")
+
+
+def sinc(x):
+    if x == 0.0:
+        return 1.0
+    return math.sin(math.pi * x) / (math.pi * x)
+
+
+def cic_response(f, ratio):
+    # Frequency is relative to the CIC output rate.
+    denominator = ratio * math.sin(math.pi * f / ratio)
+    if abs(denominator) < 1e-12:
+        return 1.0
+    return abs(math.sin(math.pi * f) / denominator) ** CIC_ORDER
+
+
+def fir_response(coefficients, f):
+    real = sum(c * math.cos(2.0 * math.pi * f * n) for n, c in enumerate(coefficients))
+    imag = sum(c * math.sin(2.0 * math.pi * f * n) for n, c in enumerate(coefficients))
+    return math.hypot(real, imag)
+
+
+def solve(matrix, vector):
+    # Gauss-Jordan elimination with partial pivoting.
+    size = len(vector)
+    rows = [matrix[i][:] + [vector[i]] for i in range(size)]
+
+    for i in range(size):
+        pivot = max(range(i, size), key=lambda r: abs(rows[r][i]))
+        rows[i], rows[pivot] = rows[pivot], rows[i]
+
+        for r in range(size):
+            if r != i:
+                factor = rows[r][i] / rows[i][i]
+                for c in range(i, size + 1):
+                    rows[r][c] -= factor * rows[i][c]
+
+    return [rows[i][size] / rows[i][i] for i in range(size)]
+
+
+def design():
+    # Weighted least squares design of a symmetric filter. Passband is the inverse of
+    # the CIC droop of a large ratio, droop converges to sinc^N as ratio grows.
+    half = FIR_TAP_COUNT // 2
+    center = (FIR_TAP_COUNT - 1) / 2.0
+    matrix = [[0.0] * half for _ in range(half)]
+    vector = [0.0] * half
+    bands = [(0.0, PASSBAND_EDGE, 1.0, True), (STOPBAND_EDGE, 0.5, STOPBAND_WEIGHT, False)]
+
+    for low, high, weight, is_passband in bands:
+        for i in range(GRID_SIZE + 1):
+            f = low + (high - low) * i / GRID_SIZE
+            desired = (1.0 / (sinc(f) ** CIC_ORDER)) if is_passband else 0.0
+            basis = [2.0 * math.cos(2.0 * math.pi * f * (center - k)) for k in range(half)]
+
+            for p in range(half):
+                vector[p] += weight * basis[p] * desired
+                for q in range(half):
+                    matrix[p][q] += weight * basis[p] * basis[q]
+
+    half_coefficients = solve(matrix, vector)
+    coefficients = half_coefficients + half_coefficients[::-1]
+
+    # Unity gain at DC.
+    total = sum(coefficients)
+    return [c / total for c in coefficients]
+
+
+def check(coefficients):
+    for ratio in CHECKED_RATIOS:
+        passband = [20.0 * math.log10(fir_response(coefficients, f) * cic_response(f, ratio))
+                    for f in [PASSBAND_EDGE * i / 100 for i in range(101)]]
+
+        # Everything above the stopband edge at the tick rate, folded to the FIR rate.
+        stopband = 0.0
+        points = 20000
+        for i in range(points + 1):
+            f = STOPBAND_EDGE + (ratio * 0.5 - STOPBAND_EDGE) * i / points
+            folded = f % 1.0
+            if folded > 0.5:
+                folded = 1.0 - folded
+            stopband = max(stopband, fir_response(coefficients, folded) * cic_response(f, ratio))
+
+        ripple = max(abs(value) for value in passband)
+        attenuation = -20.0 * math.log10(stopband)
+
+        print("Ratio %5d: passband ripple %.4f dB, stopband attenuation %.1f dB" % \
+              (ratio, ripple, attenuation))
+
+        if (ripple > MAX_PASSBAND_RIPPLE) or (attenuation < MIN_STOPBAND_ATTENUATION):
+            sys.exit("Frequency response is out of the limits.")
+
+
+def generate():
+    coefficients = design()
+    check(coefficients)
+
+    lines = []
+    lines.append("/**")
+    lines.append("  * @author     Onur Efe")
+    lines.append("  */")
+    lines.append("")
+    lines.append("/* This file is generated by Tools/decimation_filter_generator.py. Don't edit. */")
+    lines.append("")
+    lines.append("#include \"decimation_filter.h\"")
+    lines.append("")
+    lines.append("#if (DECIMATION_FILTER_CIC_ORDER != %d) || (DECIMATION_FILTER_FIR_DECIMATION != %d) || \\" % \
+                 (CIC_ORDER, FIR_DECIMATION))
+    lines.append("    (DECIMATION_FILTER_FIR_TAP_COUNT != %d)" % FIR_TAP_COUNT)
+    lines.append("#error \"Decimation filter is generated for other parameters. Regenerate it.\"")
+    lines.append("#endif")
+    lines.append("")
+    lines.append("/* Exported variables --------------------------------------------------------*/")
+    lines.append("const float DecimationFilter_FIRCoefficients[DECIMATION_FILTER_FIR_TAP_COUNT] = ")
+    lines.append("{")
+
+    for i in range(0, len(coefficients), VALUES_PER_LINE):
+        chunk = coefficients[i:i + VALUES_PER_LINE]
+        line = "  " + ", ".join("%+.9ef" % value for value in chunk)
+        if (i + VALUES_PER_LINE) < len(coefficients):
+            line += ","
+        lines.append(line)
+
+    lines.append("};")
+
+    with open(OUTPUT_PATH, "w", newline="\r\n") as output:
+        output.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    generate()
@@ -0,0 +1,109 @@
+"""
+  @author     Onur Efe
+
+  Compares the demodulation references of the EIS core on the host. Table variant
+  is the 64 bit phase accumulator indexing the Q15 sine table, float variant is the
+  float phasor rotated once in a tick and rebased at the sub sample boundaries
+  (EIS_CORE_USE_FLOAT_PHASOR). Same quantized ADC signal is demodulated by both, and
+  the amplitude and phase errors of the results are reported against the double
+  precision reference. Only the accuracy is compared, execution time of the
+  variants should be measured on the target.
+
+  Usage: python eis_reference_benchmark.py [ticks]
+"""
+
+import math
+import struct
+import sys
+
+TICK_FREQUENCY = 84000000.0 / 211
+SUBSAMPLING_NUMBER = 65536
+SINE_BITS = 12
+AMPLITUDE = 32767
+PHASE_FULL_CYCLE = 1 << 64
+PHASE_MASK = PHASE_FULL_CYCLE - 1
+
+# Signal amplitude in ADC codes and its phase to the excitation.
+SIGNAL_AMPLITUDE = 20000.0
+SIGNAL_PHASE = 0.7
+
+# Cycles of the tone in the measurement, the measurement is coherent.
+TEST_CYCLES = [7, 997, 40013]
+
+
+def to_float32(value):
+    return struct.unpack("f", struct.pack("f", value))[0]
+
+
+def build_table():
+    length = 1 << SINE_BITS
+    return [int(math.floor(AMPLITUDE * math.sin(2.0 * math.pi * i / length) + 0.5))
+            for i in range(length)]
+
+
+def demodulate(samples, increment, variant, table):
+    sum_x = 0
+    sum_y = 0
+    phase = 0
+    rot_x = to_float32(math.cos(2.0 * math.pi * increment / PHASE_FULL_CYCLE))
+    rot_y = to_float32(math.sin(2.0 * math.pi * increment / PHASE_FULL_CYCLE))
+    phasor_x = 1.0
+    phasor_y = 0.0
+    shift = 64 - SINE_BITS
+    quarter = 1 << (SINE_BITS - 2)
+    mask = (1 << SINE_BITS) - 1
+
+    for n, sample in enumerate(samples):
+        if variant == "table":
+            index = phase >> shift
+            sine = table[index]
+            cosine = table[(index + quarter) & mask]
+        elif variant == "float":
+            if (n % SUBSAMPLING_NUMBER) == 0:
+                angle = to_float32(to_float32(2.0 * math.pi / 4294967296.0) *
+                                   to_float32(phase >> 32))
+                phasor_x = to_float32(math.cos(angle))
+                phasor_y = to_float32(math.sin(angle))
+            sine = int(to_float32(phasor_y * AMPLITUDE))
+            cosine = int(to_float32(phasor_x * AMPLITUDE))
+            x = to_float32(to_float32(phasor_x * rot_x) - to_float32(phasor_y * rot_y))
+            y = to_float32(to_float32(phasor_x * rot_y) + to_float32(phasor_y * rot_x))
+            phasor_x, phasor_y = x, y
+        else:
+            angle = 2.0 * math.pi * phase / PHASE_FULL_CYCLE
+            sine = AMPLITUDE * math.sin(angle)
+            cosine = AMPLITUDE * math.cos(angle)
+
+        sum_x += sample * cosine
+        sum_y += sample * sine
+        phase = (phase + increment) & PHASE_MASK
+
+    scale = 2.0 / (len(samples) * AMPLITUDE)
+    return (math.hypot(sum_x, sum_y) * scale, math.atan2(sum_x, sum_y))
+
+
+def run(ticks):
+    table = build_table()
+
+    print("Ticks: %d, tick frequency: %.1f Hz" % (ticks, TICK_FREQUENCY))
+    print("%12s %8s %14s %14s" % ("frequency", "variant", "amp error ppm", "phase error urad"))
+
+    for cycles in TEST_CYCLES:
+        increment = int((float(cycles) / ticks) * PHASE_FULL_CYCLE + 0.5)
+        samples = [int(math.floor(SIGNAL_AMPLITUDE *
+                                  math.sin(2.0 * math.pi * increment * n / PHASE_FULL_CYCLE +
+                                           SIGNAL_PHASE) + 0.5))
+                   for n in range(ticks)]
+
+        reference_amplitude, reference_phase = demodulate(samples, increment, "double", table)
+
+        for variant in ("table", "float"):
+            amplitude, phase = demodulate(samples, increment, variant, table)
+            print("%12.2f %8s %14.2f %14.2f" % (
+                cycles * TICK_FREQUENCY / ticks, variant,
+                1e6 * (amplitude - reference_amplitude) / reference_amplitude,
+                1e6 * (phase - reference_phase)))
+
+
+if __name__ == "__main__":
+    run(int(sys.argv[1]) if len(sys.argv) > 1 else 4 * SUBSAMPLING_NUMBER)
@@ -0,0 +1,91 @@
+"""
+  @author     Onur Efe
+
+  Leakage of the EIS core integration windows on the host. Window weight is applied
+  per sub sample, so the window is a staircase of the sub sample count steps. Its
+  leakage is compared with the rectangular window and the continuous window.
+
+  Leakage is of an interferer at an offset from the tone, in bins of the measurement
+  length. Highest sidelobe is searched from the main lobe edge to 200 bins. Near the
+  multiples of the sub sample count, images of the main lobe remain, which are only
+  attenuated by the sinc of the sub sample.
+
+  Usage: python eis_window_leakage_benchmark.py
+"""
+
+import cmath
+import math
+
+FLAT_TOP = [0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368]
+
+# Main lobe half widths in bins.
+WINDOWS = [("rectangular", 1.0), ("hann", 2.0), ("flat_top", 5.0)]
+SUB_SAMPLE_COUNTS = [8, 16, 32, 64, 128, 256]
+CONTINUOUS_POINTS = 512
+SEARCH_END = 200.0
+SEARCH_STEP = 0.1
+OFFSETS = [10.5, 100.5]
+
+
+def weight(position, window):
+    angle = 2.0 * math.pi * position
+
+    if window == "hann":
+        return 0.5 - 0.5 * math.cos(angle)
+    if window == "flat_top":
+        return sum(((-1) ** k) * a * math.cos(k * angle) for k, a in enumerate(FLAT_TOP))
+    return 1.0
+
+
+def leakage(offset, window, steps):
+    """Relative response to an interferer of the offset, for a staircase of steps."""
+    weights = [weight((m + 0.5) / steps, window) for m in range(steps)]
+    response = sum(w * cmath.exp(2j * math.pi * offset * (m + 0.5) / steps)
+                   for m, w in enumerate(weights))
+    argument = math.pi * offset / steps
+
+    # Response of a step is the sinc of its length.
+    step_response = 1.0 if argument == 0.0 else math.sin(argument) / argument
+
+    return abs(response * step_response) / sum(weights)
+
+
+def to_db(value):
+    return 20.0 * math.log10(max(value, 1e-12))
+
+
+def highest_sidelobe(window, steps, main_lobe):
+    offset = main_lobe + 0.5
+    highest = 0.0
+
+    while offset < SEARCH_END:
+        highest = max(highest, leakage(offset, window, steps))
+        offset += SEARCH_STEP
+
+    return highest
+
+
+def run():
+    counts = SUB_SAMPLE_COUNTS + [CONTINUOUS_POINTS]
+
+    print("Highest sidelobe, dB")
+    print("%12s" % "sub samples" + "".join("%14s" % name for name, _ in WINDOWS))
+    for steps in counts:
+        label = "continuous" if steps == CONTINUOUS_POINTS else str(steps)
+        print("%12s" % label + "".join(
+            "%14.1f" % to_db(highest_sidelobe(name, steps, lobe)) for name, lobe in WINDOWS))
+
+    for offset in OFFSETS:
+        print("")
+        print("Leakage at %.1f bins, improvement over rectangular, dB" % offset)
+        rectangular = leakage(offset, "rectangular", 1)
+        print("%12s" % "sub samples" + "".join("%14s" % name for name, _ in WINDOWS[1:]))
+        for steps in counts:
+            label = "continuous" if steps == CONTINUOUS_POINTS else str(steps)
+            print("%12s" % label + "".join(
+                "%14.1f" % (to_db(rectangular) - to_db(leakage(offset, name, steps)))
+                for name, _ in WINDOWS[1:]))
+
+
+if __name__ == "__main__":
+    run()
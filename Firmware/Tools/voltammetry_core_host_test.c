@@ -0,0 +1,324 @@
+/**
+  * @author     Onur Efe
+  */
+
+/* Host test of the downsampling chain of the voltammetry core. Real sources are
+  compiled: tick ISR with the cic decimator, executer with the CMSIS fir decimator,
+  coefficients of the decimation_filter.c and the generic queue. Peripheral region
+  is mapped to the memory, so the inline register accesses of the board work; ADC
+  data register is written before each tick, signal DAC code is read after it.
+
+  Frequency response is checked against the limits of the filter generator, and the
+  phase of the datapoints against the filter delay reported by the core, so the block
+  alignment of the fir decimator is checked too.
+
+  Usage: python voltammetry_core_host_test.py */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/mman.h>
+#include "voltammetry_core.h"
+#include "exception_handler.h"
+
+/* Private constants ---------------------------------------------------------*/
+#define PERIPHERAL_REGION_BASE                  ((void *)PERIPH_BASE)
+#define PERIPHERAL_REGION_SIZE                  0x00080000U
+
+#define VGND_DAC_CODE                           ((MAX_UINT16 + 1) / 2)
+#define INPUT_AMPLITUDE                         16000.0
+
+#define DATAPOINT_COUNT                         128U
+#define SETTLING_DATAPOINTS                     12U     // Fir spans 8 datapoints.
+
+// Limits of the Tools/decimation_filter_generator.py.
+#define MAX_PASSBAND_RIPPLE                     0.2     // dB
+#define MIN_STOPBAND_ATTENUATION                45.0    // dB
+
+// Datapoint phase should match the reported delay, a tick is an alignment error.
+#define MAX_DELAY_ERROR                         0.25    // Ticks.
+
+#define TWO_PI                                  6.283185307179586
+
+/* Private typedefs ----------------------------------------------------------*/
+typedef struct
+{
+  float                         samplingFrequency;
+  float                         equilibriumPeriod;
+  uint32_t                      executePeriod;          // Ticks between the executer calls.
+  uint32_t                      stallDatapoint;         // Executer stalls before it. Zero for none.
+  float                         stallPeriod;            // Seconds.
+} TestCase_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const TestCase_t TestCases[] =
+{
+  {1000.0f,     0.0f,           1U,     0U,     0.0f},
+  {1000.0f,     0.0123f,        37U,    0U,     0.0f},
+  {1000.0f,     0.5f,           1U,     20U,    0.045f},  // Within the queue.
+  {1000.0f,     0.5f,           1U,     20U,    0.06f},   // Overruns, gap is filled.
+  {100.0f,      0.0371f,        101U,   0U,     0.0f},
+  {10.0f,       1.0f,           997U,   0U,     0.0f},
+  {1.0f,        0.3f,           1U,     0U,     0.0f},
+};
+
+static const double PassbandFrequencies[] = {0.05, 0.15, 0.25};
+static const double StopbandFrequencies[] = {0.75, 0.8, 1.3, 2.2, 3.6};
+
+static double InputFrequency;                           // Cycles per tick.
+static float Datapoints[DATAPOINT_COUNT];
+static uint32_t DatapointCount;
+static uint32_t Failures;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint16_t generator(int32_t tickCounter);
+static void newDatapointEventHandler(float datapoint, uint8_t edgeIndex);
+static void runMeasurement(const TestCase_t *pCase, double relFrequency, uint32_t *pDownsamplingNumber);
+static void fitSine(double relFrequency, uint32_t firstDatapoint, double *pAmplitude,
+                    double *pPhase);
+static void check(Bool_t isPassed, const char *pFormat, double value, double limit);
+
+// Exported by the core to the interrupt handler.
+extern void VoltammetryCore_TimerTickISR(void);
+
+/* Stubs of the board functions, which aren't used by the downsampling. ------*/
+void Board_TurnOnAnalog(void) {}
+void Board_TurnOffAnalog(void) {}
+void Board_ConfigureCore(Board_CoreConfiguration_t configuration) {}
+void Board_SetBinarySignalScaling(Board_BinarySignalScaling_t binaryScaling) {}
+void Board_SetDecimalSignalScaling(Board_DecimalSignalScaling_t decimalScaling) {}
+void Board_HUBSPIConfigure(Board_HUBChannelID_t channelID) {}
+void Board_TIASelectFBPath(Board_TIAFBPath_t FBPath) {}
+double Board_GetBiasDAC1LSBAppliedPotential(void) { return 1.0; }
+double Board_GetSignalDAC1LSBAppliedPotential(Board_BinarySignalScaling_t binarySignalScaling,
+                                              Board_DecimalSignalScaling_t decimalSignalScaling) { return 1.0; }
+uint32_t Board_GetDACBiasStabilizationPeriod(void) { return 0; }
+uint8_t Board_HUBSPIIsBusy(void) { return 0; }
+void TIM_PrescalerConfig(TIM_TypeDef* TIMx, uint16_t Prescaler, uint16_t TIM_PSCReloadMode) {}
+void TIM_SetAutoreload(TIM_TypeDef* TIMx, uint32_t Autoreload) {}
+void TIM_Cmd(TIM_TypeDef* TIMx, FunctionalState NewState) {}
+void SPI_Cmd(SPI_TypeDef* SPIx, FunctionalState NewState) {}
+volatile uint32_t SysTime;
+
+void ExceptionHandler_ThrowException(const uint8_t *pExceptionMessage)
+{
+  printf("EXCEPTION: %s", pExceptionMessage);
+  exit(1);
+}
+
+/* Public function implementations -------------------------------------------*/
+int main(void)
+{
+  const TestCase_t *p_case;
+  uint32_t downsampling_number;
+  uint32_t first_datapoint;
+  double amplitude;
+  double phase;
+  double period;
+  double delay_error;
+  double gain;
+
+  if (mmap(PERIPHERAL_REGION_BASE, PERIPHERAL_REGION_SIZE, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != PERIPHERAL_REGION_BASE)
+  {
+    printf("Peripheral region couldn't be mapped.\n");
+    return 1;
+  }
+
+  for (uint32_t i = 0; i < sizeof(TestCases) / sizeof(TestCases[0]); i++)
+  {
+    p_case = &TestCases[i];
+
+    // Datapoints after the stall are checked, once the fir is refilled.
+    first_datapoint = p_case->stallDatapoint + SETTLING_DATAPOINTS + \
+      (uint32_t)(p_case->stallPeriod * p_case->samplingFrequency);
+
+    for (uint32_t j = 0; j < sizeof(PassbandFrequencies) / sizeof(PassbandFrequencies[0]); j++)
+    {
+      runMeasurement(p_case, PassbandFrequencies[j], &downsampling_number);
+      fitSine(PassbandFrequencies[j], first_datapoint, &amplitude, &phase);
+      gain = 20.0 * log10(amplitude / INPUT_AMPLITUDE);
+
+      // Phase is ambiguous by the input period, error is wrapped into it.
+      period = downsampling_number / PassbandFrequencies[j];
+      delay_error = phase * period / TWO_PI - VoltammetryCore_GetFilterDelay();
+      delay_error -= period * floor((delay_error / period) + 0.5);
+
+      printf("%7.1f Hz N=%-5u eq=%.4f f=%.2f: gain %+.4f dB, delay error %+.4f ticks\n",
+             p_case->samplingFrequency, downsampling_number, p_case->equilibriumPeriod,
+             PassbandFrequencies[j], gain, delay_error);
+
+      check((fabs(gain) <= MAX_PASSBAND_RIPPLE), "passband gain %+.4f dB, limit %.1f\n",
+            gain, MAX_PASSBAND_RIPPLE);
+      check((fabs(delay_error) <= MAX_DELAY_ERROR), "delay error %+.4f ticks, limit %.2f\n",
+            delay_error, MAX_DELAY_ERROR);
+    }
+
+    for (uint32_t j = 0; j < sizeof(StopbandFrequencies) / sizeof(StopbandFrequencies[0]); j++)
+    {
+      runMeasurement(p_case, StopbandFrequencies[j], &downsampling_number);
+      fitSine(StopbandFrequencies[j], first_datapoint, &amplitude, &phase);
+      gain = 20.0 * log10(amplitude / INPUT_AMPLITUDE);
+
+      printf("%7.1f Hz N=%-5u eq=%.4f f=%.2f: gain %+.1f dB\n",
+             p_case->samplingFrequency, downsampling_number, p_case->equilibriumPeriod,
+             StopbandFrequencies[j], gain);
+
+      check((gain <= -MIN_STOPBAND_ATTENUATION), "stopband gain %+.1f dB, limit %.1f\n",
+            gain, -MIN_STOPBAND_ATTENUATION);
+    }
+
+    // Overrun is reported only if the stall is longer than the queue.
+    check((VoltammetryCore_IsOverrun() == (p_case->stallPeriod > 0.05f)),
+          "overrun flag %.0f, expected %.0f\n", VoltammetryCore_IsOverrun(),
+          (p_case->stallPeriod > 0.05f));
+  }
+
+  printf("%s: %u failures.\n", (Failures == 0) ? "PASSED" : "FAILED", Failures);
+
+  return (Failures == 0) ? 0 : 1;
+}
+
+/* Private function implementations ------------------------------------------*/
+/***
+  * @Brief      Generates the input sine, conversions follow the DAC codes.
+  */
+static uint16_t generator(int32_t tickCounter)
+{
+  return (uint16_t)(VGND_DAC_CODE + \
+                    lround(INPUT_AMPLITUDE * sin(TWO_PI * InputFrequency * tickCounter)));
+}
+
+static void newDatapointEventHandler(float datapoint, uint8_t edgeIndex)
+{
+  if (DatapointCount < DATAPOINT_COUNT)
+  {
+    Datapoints[DatapointCount] = datapoint;
+  }
+
+  DatapointCount++;
+}
+
+/***
+  * @Brief      Runs a measurement with the input sine. Conversion read in a tick is of
+  *             the DAC code sent two ticks before.
+  *
+  * @Param      pCase->Test case.
+  * @Param      relFrequency->Input frequency relative to the datapoint rate.
+  * @Param      pDownsamplingNumber->Pointer to return the ticks between the datapoints.
+  */
+static void runMeasurement(const TestCase_t *pCase, double relFrequency,
+                           uint32_t *pDownsamplingNumber)
+{
+  VoltammetryCore_SetupParams_t params = {0};
+  float tick_period;
+  uint16_t sent_codes[2];
+  uint32_t tick = 0;
+  uint32_t stall_ticks = 0;
+
+  params.datapointCount = DATAPOINT_COUNT;
+  params.samplingFrequency = pCase->samplingFrequency;
+  params.samplingWindow = 0.0f;
+  params.equilibriumPeriod = pCase->equilibriumPeriod;
+  params.maxRelSamplingFreqErr = 0.001f;
+  params.newDatapointDelegate = newDatapointEventHandler;
+  params.generatorFunctionInterface = generator;
+  params.waveform.type = VOLTAMMETRY_CORE_WAVEFORM_CUSTOM;
+
+  VoltammetryCore_Setup(&params, &tick_period);
+  *pDownsamplingNumber = VoltammetryCore_GetDownsamplingNumber();
+  InputFrequency = relFrequency / *pDownsamplingNumber;
+
+  DatapointCount = 0;
+  VoltammetryCore_Start();
+  sent_codes[0] = sent_codes[1] = HUB_SPI->DR;
+
+  while (VoltammetryCore_GetState() == VOLTAMMETRY_CORE_STATE_OPERATING)
+  {
+    ADC_SPI->DR = (uint16_t)(sent_codes[0] - VGND_DAC_CODE);
+    VoltammetryCore_TimerTickISR();
+    sent_codes[0] = sent_codes[1];
+    sent_codes[1] = HUB_SPI->DR;
+    tick++;
+
+    if ((pCase->stallDatapoint != 0) && (DatapointCount == pCase->stallDatapoint) && \
+        (stall_ticks == 0))
+    {
+      stall_ticks = (uint32_t)(pCase->stallPeriod / tick_period);
+    }
+
+    if (stall_ticks > 1)
+    {
+      stall_ticks--;
+    }
+    else if ((tick % pCase->executePeriod) == 0)
+    {
+      VoltammetryCore_Execute();
+    }
+  }
+}
+
+/***
+  * @Brief      Fits a sine of the input frequency to the datapoints. Datapoint is at
+  *             the end of its downsampling period. Phase is the lag to the input.
+  */
+static void fitSine(double relFrequency, uint32_t firstDatapoint, double *pAmplitude,
+                    double *pPhase)
+{
+  double basis[3];
+  double normal[3][4] = {{0}};
+  double factor;
+  double omega;
+
+  omega = TWO_PI * relFrequency;
+
+  for (uint32_t k = firstDatapoint; k < DATAPOINT_COUNT; k++)
+  {
+    basis[0] = sin(omega * (k + 1));
+    basis[1] = cos(omega * (k + 1));
+    basis[2] = 1.0;
+
+    for (uint8_t r = 0; r < 3; r++)
+    {
+      for (uint8_t c = 0; c < 3; c++)
+      {
+        normal[r][c] += basis[r] * basis[c];
+      }
+
+      normal[r][3] += basis[r] * Datapoints[k];
+    }
+  }
+
+  // Gauss-Jordan elimination, the normal matrix is positive definite.
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    for (uint8_t r = 0; r < 3; r++)
+    {
+      if (r != i)
+      {
+        factor = normal[r][i] / normal[i][i];
+
+        for (uint8_t c = i; c < 4; c++)
+        {
+          normal[r][c] -= factor * normal[i][c];
+        }
+      }
+    }
+  }
+
+  // A*sin(w*(t - d)) = A*cos(w*d)*sin(w*t) - A*sin(w*d)*cos(w*t).
+  basis[0] = normal[0][3] / normal[0][0];
+  basis[1] = normal[1][3] / normal[1][1];
+  *pAmplitude = hypot(basis[0], basis[1]);
+  *pPhase = atan2(-basis[1], basis[0]);
+}
+
+static void check(Bool_t isPassed, const char *pFormat, double value, double limit)
+{
+  if (!isPassed)
+  {
+    printf("  FAIL: ");
+    printf(pFormat, value, limit);
+    Failures++;
+  }
+}
@@ -0,0 +1,49 @@
+"""
+  @author     Onur Efe
+
+  Builds and runs voltammetry_core_host_test.c, the host test of the downsampling
+  chain of the voltammetry core. Needs gcc on Linux, since the peripheral region is
+  mapped to the memory.
+
+  Usage: python voltammetry_core_host_test.py
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+FIRMWARE_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+DEFINES = ["STM32F40_41xxx", "USE_STDPERIPH_DRIVER", "HSE_VALUE=8000000", "ARM_MATH_CM4",
+           "__FPU_PRESENT=1"]
+
+INCLUDE_PATHS = ["Include", "Libraries/CMSIS/Include",
+                 "Libraries/STM32F4xx_StdPeriph_Driver/inc",
+                 "Libraries/STM32_BlueNRG/Interface",
+                 "Libraries/STM32_BlueNRG/SimpleBlueNRG_HCI/includes"]
+
+SOURCES = ["Tools/voltammetry_core_host_test.c",
+           "Source/voltammetry_core.c", "Source/decimation_filter.c",
+           "Source/queue_generic.c", "Source/utils.c", "Source/waveform_table.c",
+           "Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/arm_fir_decimate_f32.c",
+           "Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/arm_fir_decimate_init_f32.c"]
+
+# CMSIS circular buffer functions cast the pointers to 32 bits, they aren't used.
+FLAGS = ["-std=gnu99", "-O2", "-Wall", "-Wno-unused-function", "-Wno-pointer-sign",
+         "-Wno-unused-variable", "-Wno-pointer-to-int-cast", "-Wno-int-to-pointer-cast"]
+
+
+def main():
+    output = os.path.join(tempfile.mkdtemp(), "voltammetry_core_host_test")
+    command = (["gcc"] + FLAGS + ["-D" + d for d in DEFINES] +
+               ["-I" + i for i in INCLUDE_PATHS] + SOURCES + ["-lm", "-o", output])
+
+    if subprocess.call(command, cwd=FIRMWARE_PATH) != 0:
+        sys.exit("Build failed.")
+
+    sys.exit(subprocess.call([output]))
+
+
+if __name__ == "__main__":
+    main()
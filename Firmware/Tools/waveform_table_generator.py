@@ -0,0 +1,60 @@
+"""
+  @author     Onur Efe
+
+  Generates Source/waveform_table.c. Table size should match the
+  WAVEFORM_TABLE_SINE_BITS definition in Include/waveform_table.h.
+
+  Usage: python waveform_table_generator.py [sine_bits]
+"""
+
+import math
+import os
+import sys
+
+AMPLITUDE = 32767
+VALUES_PER_LINE = 8
+
+OUTPUT_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "Source", "waveform_table.c")
+
+
+def generate(sine_bits):
+    length = 1 << sine_bits
+
+    # One period and a guard entry, which equals to the first entry.
+    values = [int(math.floor(AMPLITUDE * math.sin(2.0 * math.pi * i / length) + 0.5))
+              for i in range(length)]
+    values.append(values[0])
+
+    lines = []
+    lines.append("/**")
+    lines.append("  * @author     Onur Efe")
+    lines.append("  */")
+    lines.append("")
+    lines.append("/* This file is generated by Tools/waveform_table_generator.py. Don't edit. */")
+    lines.append("")
+    lines.append("#include \"waveform_table.h\"")
+    lines.append("")
+    lines.append("#if (WAVEFORM_TABLE_SINE_BITS != %d)" % sine_bits)
+    lines.append("#error \"Waveform table is generated for another size. Regenerate it.\"")
+    lines.append("#endif")
+    lines.append("")
+    lines.append("/* Exported variables --------------------------------------------------------*/")
+    lines.append("const int16_t WaveformTable_Sine[WAVEFORM_TABLE_SINE_LENGTH + 1] = ")
+    lines.append("{")
+
+    for i in range(0, len(values), VALUES_PER_LINE):
+        chunk = values[i:i + VALUES_PER_LINE]
+        line = "  " + ", ".join("%6d" % value for value in chunk)
+        if (i + VALUES_PER_LINE) < len(values):
+            line += ","
+        lines.append(line)
+
+    lines.append("};")
+
+    with open(OUTPUT_PATH, "w", newline="\r\n") as output:
+        output.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    generate(int(sys.argv[1]) if len(sys.argv) > 1 else 12)